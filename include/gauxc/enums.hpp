@@ -51,6 +51,17 @@ enum class ExecutionSpace {
   Device ///< Execute task on the device (e.g. GPU)
 };
 
+/**
+ *  @brief Specification of the accumulation of task contributions into
+ *  replicated host matrices (e.g. VXC, K)
+ */
+enum class HostAccumulation {
+  Default,       ///< Select based on the available memory budget
+  Atomic,        ///< Per-element atomic updates
+  ThreadPrivate, ///< Thread private copies merged by tree reduction
+  TileLocks      ///< Striped locks over fixed size tiles
+};
+
 /// Supported Algorithms / Integrands
 enum class SupportedAlg {
   XC,
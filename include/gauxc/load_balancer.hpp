@@ -141,6 +141,14 @@ public:
    *                           This gurantees contiguous memory access but leads
    *                           to significantly more work. Not advised for general 
    *                           usage
+   *    - "DISTRIBUTED": Read as "DISTRIBUTED-PETITE"
+   *    - "DISTRIBUTED-PETITE": Same as "REPLICATED-PETITE" except that each
+   *                            rank only generates the batches assigned to it.
+   *                            Batches are costed from the batch extents prior
+   *                            to their generation, which yields the same
+   *                            (deterministic) assignment
+   *    - "DISTRIBUTED-FILLIN": Same as "DISTRIBUTED-PETITE" with the screening
+   *                            of "REPLICATED-FILLIN"
    * 
    *    Currently accepted values for Device execution space:
    *      - "DEFAULT": Read as "REPLICATED"
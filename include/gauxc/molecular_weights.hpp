@@ -20,6 +20,9 @@ namespace detail {
 struct MolecularWeightsSettings { 
     XCWeightAlg weight_alg = XCWeightAlg::SSF; ///< Weight partitioning scheme
     bool becke_size_adjustment = false; ///< Whether to use Becke size adjustments
+    bool compact_grid = false; ///< Whether to drop negligible-weight points after partitioning
+    double compact_weight_tol = 1e-15; ///< Weight below which points are dropped
+    bool vectorized_weights = true; ///< Whether to use the point vectorized (SoA) host kernels
 };
 
 
@@ -55,7 +58,9 @@ public:
   // Move a MolecularWeights instance
   MolecularWeights( MolecularWeights&& ) noexcept;
 
-  /// Apply weight partitioning scheme to pre-generated local quadrature tasks
+  /// Apply weight partitioning scheme to pre-generated local quadrature tasks.
+  /// If requested, points with negligible weights (and tasks which become
+  /// empty) are subsequently removed from the load balancer
   void modify_weights(load_balancer_reference lb) const;
 
   /// Return local timing tracker
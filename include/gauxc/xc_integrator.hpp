@@ -8,6 +8,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include <gauxc/types.hpp>
 #include <gauxc/load_balancer.hpp>
@@ -34,6 +35,8 @@ public:
   using exc_vxc_type_rks  = std::tuple< value_type, matrix_type >;
   using exc_vxc_type_uks  = std::tuple< value_type, matrix_type, matrix_type >;  
   using exc_vxc_type_gks  = std::tuple< value_type, matrix_type, matrix_type, matrix_type, matrix_type >;
+  using exc_vxc_batch_type_rks = std::vector< exc_vxc_type_rks >;
+  using fxc_contraction_type   = std::vector< matrix_type >;
   using exc_grad_type = std::vector< value_type >;
   using exx_type      = matrix_type;
 
@@ -66,6 +69,12 @@ public:
   exc_vxc_type_gks  eval_exc_vxc ( const MatrixType&, const MatrixType&, const MatrixType&, const MatrixType&,
                                    const IntegratorSettingsXC& = IntegratorSettingsXC{});
 
+  exc_vxc_batch_type_rks eval_exc_vxc_batch( const std::vector<MatrixType>&,
+                                             const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+
+  fxc_contraction_type eval_fxc_contraction( const MatrixType&, const std::vector<MatrixType>&,
+                                             const IntegratorSettingsXC& = IntegratorSettingsXC{} );
+
   exc_grad_type eval_exc_grad( const MatrixType& );
 
   exx_type      eval_exx     ( const MatrixType&, 
@@ -73,6 +82,11 @@ public:
 
 
   const util::Timer& get_timings() const;
+
+  /// Integrated electron count of the last EXC(+VXC) evaluation. For
+  /// eval_exc_vxc_batch this is the count of the last density of the batch.
+  value_type last_n_el() const;
+  const XCIntegratorStats& last_stats() const;
   const LoadBalancer& load_balancer() const;
   LoadBalancer& load_balancer();
 };
@@ -74,6 +74,23 @@ typename XCIntegrator<MatrixType>::exc_vxc_type_gks
         return pimpl_->eval_exc_vxc(Ps, Pz, Py, Px, ks_settings);
   };
 
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::exc_vxc_batch_type_rks
+  XCIntegrator<MatrixType>::eval_exc_vxc_batch( const std::vector<MatrixType>& Ps, 
+                                                const IntegratorSettingsXC& ks_settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_exc_vxc_batch(Ps, ks_settings);
+};
+
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::fxc_contraction_type
+  XCIntegrator<MatrixType>::eval_fxc_contraction( const MatrixType& P, 
+                                                  const std::vector<MatrixType>& tPs,
+                                                  const IntegratorSettingsXC& ks_settings ) {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->eval_fxc_contraction(P, tPs, ks_settings);
+};
+
 template <typename MatrixType>
 typename XCIntegrator<MatrixType>::exc_grad_type
   XCIntegrator<MatrixType>::eval_exc_grad( const MatrixType& P ) {
@@ -95,6 +112,19 @@ const util::Timer& XCIntegrator<MatrixType>::get_timings() const {
   return pimpl_->get_timings();
 }
 
+template <typename MatrixType>
+typename XCIntegrator<MatrixType>::value_type 
+  XCIntegrator<MatrixType>::last_n_el() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->last_n_el();
+}
+
+template <typename MatrixType>
+const XCIntegratorStats& XCIntegrator<MatrixType>::last_stats() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->last_stats();
+}
+
 template <typename MatrixType>
 const LoadBalancer& XCIntegrator<MatrixType>::load_balancer() const {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
@@ -37,6 +37,20 @@ const util::Timer& ReplicatedXCIntegrator<MatrixType>::get_timings_() const {
   return pimpl_->get_timings();
 }
 
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::value_type 
+  ReplicatedXCIntegrator<MatrixType>::last_n_el_() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->last_n_el();
+}
+
+template <typename MatrixType>
+const XCIntegratorStats& 
+  ReplicatedXCIntegrator<MatrixType>::last_stats_() const {
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  return pimpl_->last_stats();
+}
+
 template <typename MatrixType>
 const LoadBalancer& ReplicatedXCIntegrator<MatrixType>::get_load_balancer_() const {
   if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
@@ -157,6 +171,70 @@ typename ReplicatedXCIntegrator<MatrixType>::exc_vxc_type_gks
 
 }
 
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::exc_vxc_batch_type_rks
+  ReplicatedXCIntegrator<MatrixType>::eval_exc_vxc_batch_( const std::vector<MatrixType>& Ps,
+                                                           const IntegratorSettingsXC& ks_settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const int64_t ndm = Ps.size();
+  if( not ndm ) return exc_vxc_batch_type_rks{};
+
+  const int64_t m = Ps[0].rows();
+  const int64_t n = Ps[0].cols();
+  for( const auto& P : Ps )
+  if( P.rows() != m or P.cols() != n )
+    GAUXC_GENERIC_EXCEPTION("All Densities Must Have The Same Dimension");
+
+  std::vector<matrix_type>       VXCs( ndm, matrix_type( m, n ) );
+  std::vector<value_type>        EXCs( ndm );
+  std::vector<const value_type*> P_ptrs( ndm );
+  std::vector<value_type*>       VXC_ptrs( ndm );
+  for( int64_t k = 0; k < ndm; ++k ) {
+    P_ptrs[k]   = Ps[k].data();
+    VXC_ptrs[k] = VXCs[k].data();
+  }
+
+  pimpl_->eval_exc_vxc_batch( m, n, ndm, P_ptrs.data(), m, VXC_ptrs.data(), m,
+                              EXCs.data(), ks_settings );
+
+  exc_vxc_batch_type_rks EXC_VXC; EXC_VXC.reserve( ndm );
+  for( int64_t k = 0; k < ndm; ++k )
+    EXC_VXC.emplace_back( EXCs[k], std::move(VXCs[k]) );
+  return EXC_VXC;
+
+}
+
+template <typename MatrixType>
+typename ReplicatedXCIntegrator<MatrixType>::fxc_contraction_type
+  ReplicatedXCIntegrator<MatrixType>::eval_fxc_contraction_( const MatrixType& P,
+                                                             const std::vector<MatrixType>& tPs,
+                                                             const IntegratorSettingsXC& ks_settings ) {
+
+  if( not pimpl_ ) GAUXC_PIMPL_NOT_INITIALIZED();
+  const int64_t ntrial = tPs.size();
+  if( not ntrial ) return fxc_contraction_type{};
+
+  for( const auto& tP : tPs )
+  if( tP.rows() != P.rows() or tP.cols() != P.cols() )
+    GAUXC_GENERIC_EXCEPTION("Trial Densities Must Have The Same Dimension as P");
+
+  fxc_contraction_type FXCs( ntrial, matrix_type( P.rows(), P.cols() ) );
+  std::vector<const value_type*> tP_ptrs( ntrial );
+  std::vector<value_type*>       FXC_ptrs( ntrial );
+  for( int64_t k = 0; k < ntrial; ++k ) {
+    tP_ptrs[k]  = tPs[k].data();
+    FXC_ptrs[k] = FXCs[k].data();
+  }
+
+  pimpl_->eval_fxc_contraction( P.rows(), P.cols(), P.data(), P.rows(), ntrial,
+                                tP_ptrs.data(), P.rows(), FXC_ptrs.data(), 
+                                P.rows(), ks_settings );
+
+  return FXCs;
+
+}
+
 template <typename MatrixType>
 typename ReplicatedXCIntegrator<MatrixType>::exc_grad_type 
   ReplicatedXCIntegrator<MatrixType>::eval_exc_grad_( const MatrixType& P ) {
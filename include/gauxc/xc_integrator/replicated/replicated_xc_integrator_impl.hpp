@@ -35,6 +35,9 @@ protected:
 
   util::Timer timer_;
 
+  value_type n_el_ = 0.; ///< Electron count of the last EXC(+VXC) evaluation
+  XCIntegratorStats stats_; ///< Work counters of the last evaluation
+
 
   virtual void integrate_den_( int64_t m, int64_t n, const value_type* P,
                                int64_t ldp, value_type* N_EL ) = 0;
@@ -74,6 +77,18 @@ protected:
                               value_type* VXCx, int64_t ldvxcx,
                               value_type* EXC, const IntegratorSettingsXC& ks_settings ) = 0;
 
+  /// Batched RKS EXC/VXC, defaults to one EXC/VXC evaluation per density
+  virtual void eval_exc_vxc_batch_( int64_t m, int64_t n, int64_t ndm,
+                                    const value_type* const* P, int64_t ldp,
+                                    value_type* const* VXC, int64_t ldvxc,
+                                    value_type* EXC, const IntegratorSettingsXC& ks_settings );
+
+  /// RKS XC kernel contraction, not available by default
+  virtual void eval_fxc_contraction_( int64_t m, int64_t n, const value_type* P, int64_t ldp,
+                                      int64_t ntrial, const value_type* const* tP, int64_t ldtp,
+                                      value_type* const* FXC, int64_t ldfxc,
+                                      const IntegratorSettingsXC& ks_settings );
+
   virtual void eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
                                int64_t ldp, value_type* EXC_GRAD ) = 0;
   virtual void eval_exx_( int64_t m, int64_t n, const value_type* P,
@@ -129,6 +144,16 @@ public:
                      value_type* VXCx, int64_t ldvxcx,
                      value_type* EXC, const IntegratorSettingsXC& ks_settings );
 
+  void eval_exc_vxc_batch( int64_t m, int64_t n, int64_t ndm,
+                           const value_type* const* P, int64_t ldp,
+                           value_type* const* VXC, int64_t ldvxc,
+                           value_type* EXC, const IntegratorSettingsXC& ks_settings );
+
+  void eval_fxc_contraction( int64_t m, int64_t n, const value_type* P, int64_t ldp,
+                             int64_t ntrial, const value_type* const* tP, int64_t ldtp,
+                             value_type* const* FXC, int64_t ldfxc,
+                             const IntegratorSettingsXC& ks_settings );
+
 
   void eval_exc_grad( int64_t m, int64_t n, const value_type* P,
                       int64_t ldp, value_type* EXC_GRAD );
@@ -138,6 +163,8 @@ public:
                  const IntegratorSettingsEXX& settings );
 
   inline const util::Timer& get_timings() const { return timer_; }
+  inline value_type last_n_el() const { return n_el_; }
+  inline const XCIntegratorStats& last_stats() const { return stats_; }
 
   inline std::unique_ptr< LocalWorkDriver > release_local_work_driver() {
     return std::move( local_work_driver_ );
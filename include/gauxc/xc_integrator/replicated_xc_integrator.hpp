@@ -31,6 +31,8 @@ public:
   using exc_vxc_type_rks   = typename XCIntegratorImpl<MatrixType>::exc_vxc_type_rks;
   using exc_vxc_type_uks   = typename XCIntegratorImpl<MatrixType>::exc_vxc_type_uks;
   using exc_vxc_type_gks   = typename XCIntegratorImpl<MatrixType>::exc_vxc_type_gks;
+  using exc_vxc_batch_type_rks = typename XCIntegratorImpl<MatrixType>::exc_vxc_batch_type_rks;
+  using fxc_contraction_type   = typename XCIntegratorImpl<MatrixType>::fxc_contraction_type;
   using exc_grad_type  = typename XCIntegratorImpl<MatrixType>::exc_grad_type;
   using exx_type       = typename XCIntegratorImpl<MatrixType>::exx_type;
 
@@ -46,9 +48,13 @@ private:
   exc_vxc_type_rks  eval_exc_vxc_ ( const MatrixType&, const IntegratorSettingsXC& ) override;
   exc_vxc_type_uks  eval_exc_vxc_ ( const MatrixType&, const MatrixType&, const IntegratorSettingsXC&) override;
   exc_vxc_type_gks  eval_exc_vxc_ ( const MatrixType&, const MatrixType&, const MatrixType&, const MatrixType&, const IntegratorSettingsXC& ) override;
+  exc_vxc_batch_type_rks eval_exc_vxc_batch_( const std::vector<MatrixType>&, const IntegratorSettingsXC& ) override;
+  fxc_contraction_type eval_fxc_contraction_( const MatrixType&, const std::vector<MatrixType>&, const IntegratorSettingsXC& ) override;
   exc_grad_type eval_exc_grad_( const MatrixType& ) override;
   exx_type      eval_exx_     ( const MatrixType&, const IntegratorSettingsEXX& ) override;
   const util::Timer& get_timings_() const override;
+  value_type last_n_el_() const override;
+  const XCIntegratorStats& last_stats_() const override;
   const LoadBalancer& get_load_balancer_() const override;
   LoadBalancer& get_load_balancer_() override;
 
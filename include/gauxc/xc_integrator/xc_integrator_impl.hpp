@@ -23,6 +23,8 @@ public:
   using exc_vxc_type_rks   = typename XCIntegrator<MatrixType>::exc_vxc_type_rks;
   using exc_vxc_type_uks   = typename XCIntegrator<MatrixType>::exc_vxc_type_uks;
   using exc_vxc_type_gks   = typename XCIntegrator<MatrixType>::exc_vxc_type_gks;
+  using exc_vxc_batch_type_rks = typename XCIntegrator<MatrixType>::exc_vxc_batch_type_rks;
+  using fxc_contraction_type   = typename XCIntegrator<MatrixType>::fxc_contraction_type;
   using exc_grad_type  = typename XCIntegrator<MatrixType>::exc_grad_type;
   using exx_type       = typename XCIntegrator<MatrixType>::exx_type;
 
@@ -38,10 +40,16 @@ protected:
   virtual exc_vxc_type_uks  eval_exc_vxc_ ( const MatrixType& Ps, const MatrixType& Pz, const IntegratorSettingsXC& ks_settings ) = 0;
   virtual exc_vxc_type_gks  eval_exc_vxc_ ( const MatrixType& Ps, const MatrixType& Pz, const MatrixType& Py, const MatrixType& Px, 
                                             const IntegratorSettingsXC& ks_settings ) = 0;
+  virtual exc_vxc_batch_type_rks eval_exc_vxc_batch_( const std::vector<MatrixType>& Ps,
+                                                      const IntegratorSettingsXC& ks_settings ) = 0;
+  virtual fxc_contraction_type eval_fxc_contraction_( const MatrixType& P, const std::vector<MatrixType>& tPs,
+                                                      const IntegratorSettingsXC& ks_settings ) = 0;
   virtual exc_grad_type eval_exc_grad_( const MatrixType& P ) = 0;
   virtual exx_type      eval_exx_     ( const MatrixType&     P, 
                                         const IntegratorSettingsEXX& settings ) = 0;
   virtual const util::Timer& get_timings_() const = 0;
+  virtual value_type last_n_el_() const = 0;
+  virtual const XCIntegratorStats& last_stats_() const = 0;
   virtual const LoadBalancer& get_load_balancer_() const = 0;
   virtual LoadBalancer& get_load_balancer_() = 0;
   
@@ -107,6 +115,32 @@ public:
     return eval_exc_vxc_(Ps, Pz, Py, Px, ks_settings);
   }
 
+  /** Integrate EXC / VXC (Mean field terms) for a batch of RKS densities
+   *
+   *  All densities are integrated in a single pass over the grid, i.e.
+   *  the collocation matrix of each task is evaluated only once.
+   *
+   *  @param[in] Ps The alpha density matrices
+   *  @returns EXC / VXC for each density in a combined structure
+   */
+  exc_vxc_batch_type_rks eval_exc_vxc_batch( const std::vector<MatrixType>& Ps, const IntegratorSettingsXC& ks_settings ) {
+    return eval_exc_vxc_batch_(Ps, ks_settings);
+  }
+
+  /** Contract the XC kernel (FXC) of an RKS density with trial densities
+   *
+   *  Evaluates F_k = d VXC[P + e * tP_k] / de at e = 0 for a block of
+   *  (symmetric) trial densities in a single pass over the grid.
+   *
+   *  @param[in] P   The alpha density matrix
+   *  @param[in] tPs The trial density matrices
+   *  @returns The contracted kernel for each trial density
+   */
+  fxc_contraction_type eval_fxc_contraction( const MatrixType& P, const std::vector<MatrixType>& tPs, 
+                                             const IntegratorSettingsXC& ks_settings ) {
+    return eval_fxc_contraction_(P, tPs, ks_settings);
+  }
+
   /** Integrate EXC gradient for RKS
    * 
    *   TODO: add API for UKS/GKS
@@ -135,6 +169,22 @@ public:
     return get_timings_();
   }
 
+  /** Get the electron count of the last EXC / EXC+VXC evaluation
+   *
+   *  @returns Numerically integrated density (approx N_EL)
+   */
+  value_type last_n_el() const {
+    return last_n_el_();
+  }
+
+  /** Get the work counters of the last evaluation
+   *
+   *  @returns Counters of the calling rank
+   */
+  const XCIntegratorStats& last_stats() const {
+    return last_stats_();
+  }
+
 
   const LoadBalancer& load_balancer() const {
     return get_load_balancer_();
@@ -6,6 +6,8 @@
  * See LICENSE.txt for details
  */
 #pragma once
+#include <cstddef>
+#include <gauxc/enums.hpp>
 
 namespace GauXC {
 
@@ -14,11 +16,93 @@ struct IntegratorSettingsSNLinK : public IntegratorSettingsEXX {
   bool screen_ek = true;
   double energy_tol = 1e-10;
   double k_tol      = 1e-10;
+
+  // Accumulation of K on the host (see IntegratorSettingsKS)
+  HostAccumulation accumulation       = HostAccumulation::Atomic;
+  size_t           accumulation_bytes = size_t(1) << 28;
 };
 
 struct IntegratorSettingsXC { virtual ~IntegratorSettingsXC() noexcept = default; };
 struct IntegratorSettingsKS : public IntegratorSettingsXC {
   double gks_dtol = 1e-12;
+
+  // Collocation caching (host). Basis values/derivatives of each task are
+  // retained across calls up to collocation_cache_bytes, tasks are admitted
+  // by descending cost and the remainder is recomputed on every call.
+  bool   cache_collocation       = false;
+  size_t collocation_cache_bytes = 0;
+  bool   collocation_cache_fp32  = false; ///< Store cached values in FP32
+
+  // Sub-tile shell screening (host). Shells are screened against tiles of
+  // XCTask::shell_tile_size points, negligible blocks of the collocation
+  // matrix are zeroed rather than evaluated.
+  bool   screen_collocation_tiles = false;
+
+  // Mixed precision (host). The P*B and Z**T*B GEMMs are performed in FP32,
+  // the density, EXC and VXC accumulation remain in FP64. The integrated
+  // electron count (XCIntegrator::last_n_el) may be used to judge the
+  // accuracy of the result.
+  bool   mixed_precision = false;
+
+  // Density screening (host, RKS/UKS). Points whose total density is below
+  // density_tol are dropped before the functional and Z matrix evaluation.
+  bool   screen_density = false;
+  double density_tol    = 1e-14;
+
+  // Accumulation of VXC (and FXC) on the host. Default selects thread
+  // private copies if they fit in accumulation_bytes and tile locks
+  // otherwise. The budget is the total of a call, it is split evenly over
+  // the matrices accumulated by the call (e.g. the spin components of VXC).
+  HostAccumulation accumulation       = HostAccumulation::Atomic;
+  size_t           accumulation_bytes = size_t(1) << 28;
+
+  // XC kernel contraction (host, RKS). The kernel is applied to each trial
+  // density by a central difference of the functional derivatives at every
+  // grid point. The step is fxc_fd_step relative to the largest element of
+  // the trial density, it is reduced at points where the density would be
+  // perturbed by more than fxc_fd_step relative to the density of the
+  // point. Points whose density is below fxc_density_tol do not contribute.
+  double fxc_fd_step     = 1e-4;
+  double fxc_density_tol = 1e-10;
+
+  // Incremental EXC/VXC (host, RKS). The XC potentials on the grid are
+  // retained across calls together with P, EXC and VXC, and VXC is updated
+  // by the change of the potentials of each evaluated task. Tasks whose
+  // block of dP = P - P_prev (summed over the calls in which the task has
+  // been skipped) is below incremental_tol * max|dP| are skipped, i.e. the
+  // tolerance tightens as the SCF converges. The first call (and any call
+  // after the task list has changed) performs a full build.
+  bool   incremental_vxc = false;
+  double incremental_tol = 1e-3;
+
+  // Block sparse X matrix (host). The largest |P| of every shell pair block
+  // is evaluated once per call, X = P * B is only formed from the shell pair
+  // blocks of each task above xmat_block_tol. 0 disables the screening.
+  double xmat_block_tol = 0.;
+
+  // Point tiled EXC/VXC pipeline (host, RKS/UKS). After X = P * B, the U/V
+  // variables, functional, weight scaling and Z matrix of each task are
+  // evaluated on tiles of points whose collocation and X/Z data fit into
+  // xc_tile_bytes (e.g. 1 << 18 for the L2 cache), with kernels specialized
+  // for the functional family and spin. 0 (default) evaluates each pass
+  // over the full task. Not used with density screening.
+  size_t xc_tile_bytes = 0;
+
+  // Cross-task functional batching (host, RKS/UKS, point tiled pipeline in
+  // FP64). Consecutive tasks with fewer than xc_func_batch_npts points are
+  // grouped up to xc_func_batch_npts points in total, and the functional is
+  // evaluated once for the density variables of the group (e.g. 256). 0
+  // (default) evaluates the functional per task.
+  size_t xc_func_batch_npts = 0;
+};
+
+/// Work counters of the last XCIntegrator evaluation on the calling rank
+struct XCIntegratorStats {
+  size_t ntasks_skipped = 0; ///< Tasks skipped by an incremental EXC/VXC build
+  size_t npts_screened  = 0; ///< Points dropped by density screening
+  size_t ntasks_grouped = 0; ///< Tasks evaluated in functional batches
+  size_t ntasks_colloc_stored = 0; ///< Tasks whose collocation was cached
+  size_t ntasks_colloc_reused = 0; ///< Tasks whose collocation was reused
 };
 
 }
@@ -9,6 +9,7 @@
 
 #include <array>
 #include <vector>
+#include <cmath>
 #include <cstdint>
 #include <algorithm>
 #include <numeric>
@@ -57,12 +58,88 @@ struct XCTask {
   screening_data bfn_screening;
   screening_data cou_screening;
 
+  /**
+   *  Optional sub-tile shell significance mask.
+   *
+   *  Points are partitioned into tiles of shell_tile_size consecutive
+   *  points. For each tile, bit i of the shell_tile_mask_stride() words
+   *  starting at shell_tile_mask[itile * stride] is set iff the cutoff
+   *  sphere of bfn_screening.shell_list[i] contains at least one point of
+   *  the tile. Collocation kernels which are handed the mask skip the
+   *  remaining (tile,shell) blocks and write exact zeros.
+   *
+   *  An empty mask denotes dense evaluation. The mask depends on the point
+   *  set and is dropped by any operation which modifies it. It is neither
+   *  serialized nor counted in volume(), the integrators regenerate it.
+   */
+  static constexpr int32_t shell_tile_size = 32;
+  std::vector<uint64_t>    shell_tile_mask;
+
+  inline size_t shell_tile_count() const {
+    return (points.size() + shell_tile_size - 1) / shell_tile_size;
+  }
+  inline size_t shell_tile_mask_stride() const {
+    return (bfn_screening.shell_list.size() + 63) / 64;
+  }
+  inline bool has_shell_tile_mask() const {
+    return shell_tile_mask.size() and
+      shell_tile_mask.size() == shell_tile_count() * shell_tile_mask_stride();
+  }
+
+  template <typename BasisType>
+  void generate_shell_tile_mask( const BasisType& basis ) {
+    const size_t ntiles  = shell_tile_count();
+    const size_t stride  = shell_tile_mask_stride();
+    const size_t nshells = bfn_screening.shell_list.size();
+    shell_tile_mask.assign( ntiles * stride, 0 );
+
+    for( size_t it = 0; it < ntiles; ++it ) {
+      const size_t ipt_st = it * shell_tile_size;
+      const size_t ipt_en = std::min( points.size(), ipt_st + shell_tile_size );
+      auto* mask = shell_tile_mask.data() + it * stride;
+      for( size_t i = 0; i < nshells; ++i ) {
+        const auto& sh  = basis.at( bfn_screening.shell_list[i] );
+        const auto* O   = sh.O_data();
+        const double r2 = sh.cutoff_radius() * sh.cutoff_radius();
+        for( size_t ipt = ipt_st; ipt < ipt_en; ++ipt ) {
+          const double dx = points[ipt][0] - O[0];
+          const double dy = points[ipt][1] - O[1];
+          const double dz = points[ipt][2] - O[2];
+          if( dx*dx + dy*dy + dz*dz <= r2 ) {
+            mask[i / 64] |= uint64_t(1) << (i % 64);
+            break;
+          }
+        }
+      }
+    }
+  }
+
   void merge_with( const XCTask& other ) {
     if( !equiv_with(other) )
       GAUXC_GENERIC_EXCEPTION("Cannot Perform Requested Merge: Incompatible Tasks");
     points.insert( points.end(), other.points.begin(), other.points.end() );
     weights.insert( weights.end(), other.weights.begin(), other.weights.end() );
     npts = points.size();
+    shell_tile_mask.clear();
+  }
+
+  /// Remove points whose |weight| is below weight_tol, returns the number
+  /// of removed points
+  size_t compact( double weight_tol ) {
+    size_t n = 0;
+    for( size_t i = 0; i < points.size(); ++i )
+    if( std::abs(weights[i]) >= weight_tol ) {
+      points[n]  = points[i];
+      weights[n] = weights[i];
+      ++n;
+    }
+
+    const size_t nremoved = points.size() - n;
+    points.resize( n );
+    weights.resize( n );
+    npts = n;
+    if( nremoved ) shell_tile_mask.clear();
+    return nremoved;
   }
 
   template <typename TaskIt>
@@ -88,6 +165,7 @@ struct XCTask {
     }
 
     npts = points.size();
+    shell_tile_mask.clear();
   }
 
 
@@ -0,0 +1,67 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "batch_template.hpp"
+#include <tuple>
+
+namespace GauXC  {
+namespace detail {
+
+BatchTemplate::BatchTemplate( Grid& grid ) {
+
+  auto& batcher = grid.batcher();
+  batcher.quadrature().recenter( point_type{ 0., 0., 0. } );
+
+  const size_t nbatches = batcher.nbatches();
+  batches_.resize( nbatches );
+
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t ibatch = 0; ibatch < nbatches; ++ibatch ) {
+    auto [lo, up, points, weights] = batcher.at(ibatch);
+    auto& batch   = batches_[ibatch];
+    batch.lo      = lo;
+    batch.up      = up;
+    batch.points  = std::move( points );
+    batch.weights = std::move( weights );
+  }
+
+}
+
+std::pair<BatchTemplate::point_type,BatchTemplate::point_type> 
+  BatchTemplate::extent( size_t ibatch, const point_type& center ) const {
+
+  const auto& ref = batches_.at(ibatch);
+
+  point_type lo, up;
+  for( size_t k = 0; k < 3; ++k ) {
+    lo[k] = ref.lo[k] + center[k];
+    up[k] = ref.up[k] + center[k];
+  }
+
+  return std::pair( lo, up );
+
+}
+
+BatchTemplate::batch_type BatchTemplate::at( size_t ibatch,
+  const point_type& center ) const {
+
+  const auto& ref = batches_.at(ibatch);
+
+  batch_type batch;
+  batch.weights = ref.weights;
+  batch.points.resize( ref.points.size() );
+  std::tie( batch.lo, batch.up ) = extent( ibatch, center );
+  for( size_t i = 0; i < ref.points.size(); ++i )
+  for( size_t k = 0; k < 3; ++k )
+    batch.points[i][k] = ref.points[i][k] + center[k];
+
+  return batch;
+
+}
+
+}
+}
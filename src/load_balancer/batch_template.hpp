@@ -0,0 +1,69 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/grid.hpp>
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace GauXC  {
+namespace detail {
+
+/**
+ *  Immutable batches of an atomic Grid, centered at the origin
+ *
+ *  Batches of a particular atom are obtained by translation, i.e. unlike
+ *  recentering the (shared) batcher of the Grid, batches of different atoms
+ *  may be generated concurrently. Translated points agree with the ones of
+ *  the recentered batcher up to rounding.
+ *
+ *  N.B. the construction recenters the batcher of the Grid to the origin.
+ *  The batcher is shared by all copies of the Grid (and its MolGrid), users
+ *  of the batcher must hence recenter it prior to use (as all in-tree users
+ *  do) and not generate templates concurrently with other batcher usage.
+ */
+class BatchTemplate {
+
+public:
+
+  using point_type = std::array<double,3>;
+
+  struct batch_type {
+    point_type               lo;      ///< Lower corner of the batch extent
+    point_type               up;      ///< Upper corner of the batch extent
+    std::vector<point_type>  points;
+    std::vector<double>      weights;
+  };
+
+  /// Generate the batches of a Grid (recenters its shared batcher to the
+  /// origin, see above)
+  BatchTemplate( Grid& grid );
+
+  inline size_t nbatches() const { return batches_.size(); }
+
+  /// Number of points of a batch
+  inline size_t npts( size_t ibatch ) const { 
+    return batches_[ibatch].points.size(); 
+  }
+
+  /// Extent (lo, up) of a batch translated to an atomic center
+  std::pair<point_type,point_type> extent( size_t ibatch, 
+    const point_type& center ) const;
+
+  /// Batch translated to an atomic center
+  batch_type at( size_t ibatch, const point_type& center ) const;
+
+private:
+
+  std::vector<batch_type> batches_;
+
+};
+
+}
+}
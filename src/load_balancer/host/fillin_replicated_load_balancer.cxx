@@ -6,7 +6,6 @@
  * See LICENSE.txt for details
  */
 #include "fillin_replicated_load_balancer.hpp"
-#include <gauxc/util/geometry.hpp>
 
 namespace GauXC  {
 namespace detail {
@@ -31,21 +30,19 @@ std::pair<std::vector<int32_t>,size_t> FillInHostReplicatedLoadBalancer::micro_b
 ) const {
 
 
-  int32_t first_shell = -1;
-  int32_t last_shell  = -1;
-  for(auto iSh = 0ul; iSh < bs.size(); ++iSh) {
+  // The shell index is built for the basis of the load balancer, other
+  // bases must agree in the shell centers / cutoff radii
+  if( &bs != &this->basis() and not this->shell_index().indexes(bs) )
+    GAUXC_GENERIC_EXCEPTION("Basis Does Not Match Shell Index");
 
-    const auto& center = bs[iSh].O();
-    const auto  crad   = bs[iSh].cutoff_radius();
-    const bool intersect = 
-      geometry::cube_sphere_intersect( box_lo, box_up, center, crad );
-    
-    if( intersect ) {
-      if( first_shell < 0 ) first_shell = iSh;
-      last_shell = iSh;
-    }
+  // Shells whose cutoff sphere intersects the batch (ascending order)
+  std::vector<int32_t> intersect_list;
+  this->shell_index().query( box_lo, box_up, intersect_list );
 
-  }
+  const int32_t first_shell = 
+    intersect_list.size() ? intersect_list.front() : -1;
+  const int32_t last_shell  = 
+    intersect_list.size() ? intersect_list.back()  : -1;
 
   if( first_shell < 0 ) {
     return std::pair( std::vector<int32_t>{}, 0ul );
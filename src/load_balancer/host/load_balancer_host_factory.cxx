@@ -23,18 +23,25 @@ std::shared_ptr<LoadBalancer> LoadBalancerHostFactory::get_shared_instance(
 
   if( kernel_name == "DEFAULT" or kernel_name == "REPLICATED" ) 
     kernel_name = "REPLICATED-PETITE";
+  if( kernel_name == "DISTRIBUTED" )
+    kernel_name = "DISTRIBUTED-PETITE";
 
-  std::unique_ptr<detail::LoadBalancerImpl> ptr = nullptr;
-  if( kernel_name == "REPLICATED-PETITE" )
+  std::unique_ptr<detail::HostReplicatedLoadBalancer> ptr = nullptr;
+  if( kernel_name == "REPLICATED-PETITE" or 
+      kernel_name == "DISTRIBUTED-PETITE" )
     ptr = std::make_unique<detail::PetiteHostReplicatedLoadBalancer>(
       rt, mol, mg, basis
     );
 
-  if( kernel_name == "REPLICATED-FILLIN" )
+  if( kernel_name == "REPLICATED-FILLIN" or 
+      kernel_name == "DISTRIBUTED-FILLIN" )
     ptr = std::make_unique<detail::FillInHostReplicatedLoadBalancer>(
       rt, mol, mg, basis
     );
 
+  if( ptr and kernel_name.rfind("DISTRIBUTED",0) == 0 )
+    ptr->set_distributed_generation( true );
+
   if( ! ptr ) GAUXC_GENERIC_EXCEPTION("Load Balancer Kernel Not Recognized: " + kernel_name);
 
   return std::make_shared<LoadBalancer>(std::move(ptr));
@@ -6,6 +6,9 @@
  * See LICENSE.txt for details
  */
 #include "replicated_host_load_balancer.hpp"
+#include "batch_template.hpp"
+#include <gauxc/util/mpi.hpp>
+#include <unordered_map>
 
 namespace GauXC {
 namespace detail {
@@ -15,6 +18,61 @@ HostReplicatedLoadBalancer::HostReplicatedLoadBalancer( HostReplicatedLoadBalanc
 
 HostReplicatedLoadBalancer::~HostReplicatedLoadBalancer() noexcept = default;
 
+std::vector<size_t> HostReplicatedLoadBalancer::batch_costs(
+  const std::vector< std::pair<int32_t, size_t> >& batches,
+  const std::unordered_map< AtomicNumber, BatchTemplate >& batch_templates,
+  int32_t rank, int32_t nranks, 
+  std::vector< batch_screening >& screening ) const {
+
+  const int32_t n_deriv  = 1; // Effects cost heuristic
+  const auto    natoms   = this->mol_->natoms();
+  const size_t  nbatches = batches.size();
+
+  // Cost of the task of each batch (XCTask::cost), the shells are screened
+  // over the (translated) batch extents as in the task generation. Batches
+  // which yield no task have zero cost
+  std::vector<size_t> cost( nbatches, 0 );
+  screening.clear();
+  screening.resize( nbatches );
+
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t i = rank; i < nbatches; i += size_t(nranks) ) {
+    const auto [iAtom, ibatch] = batches[i];
+    const auto& atom = (*this->mol_)[iAtom];
+    const auto& batch_template = batch_templates.at( atom.Z );
+
+    const size_t npts = batch_template.npts( ibatch );
+    if( not npts ) continue;
+
+    const auto [lo, up] = 
+      batch_template.extent( ibatch, { atom.x, atom.y, atom.z } );
+    screening[i] = micro_batch_screen( (*this->basis_), lo, up );
+
+    const size_t nbe = screening[i].second;
+    if( screening[i].first.size() )
+      cost[i] = (nbe * ( 1 + nbe + n_deriv ) + natoms * natoms) * npts;
+  }
+
+  return cost;
+
+}
+
+std::vector<int32_t> HostReplicatedLoadBalancer::batch_owners( 
+  const std::vector<size_t>& cost, std::vector<size_t>& workload ) {
+
+  const size_t nbatches = cost.size();
+  std::vector<int32_t> owners( nbatches, -1 );
+  for( size_t ibatch = 0; ibatch < nbatches; ++ibatch ) 
+  if( cost[ibatch] ) {
+    auto min_rank_it = std::min_element( workload.begin(), workload.end() );
+    owners[ibatch] = std::distance( workload.begin(), min_rank_it );
+    *min_rank_it += cost[ibatch];
+  }
+
+  return owners;
+
+}
+
 std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
 
   const int32_t n_deriv = 1; // Effects cost heuristic
@@ -26,102 +84,122 @@ std::vector< XCTask > HostReplicatedLoadBalancer::create_local_tasks_() const  {
   std::vector<size_t> global_workload( world_size, 0 );   
 
   const auto natoms = this->mol_->natoms();
-  int32_t iCurrent  = 0;
-  int32_t atBatchSz = 1;
 
+  // Immutable (translatable) batches of the atomic grids, such that the
+  // batches of different atoms may be generated concurrently. N.B. this
+  // recenters the batchers of the (shared) MolGrid to the origin, i.e. the
+  // MolGrid must not be used concurrently (as with the per-atom recentering
+  // of the device load balancers)
+  std::unordered_map< AtomicNumber, BatchTemplate > batch_templates;
+  for( const auto& atom : *this->mol_ )
+  if( not batch_templates.count( atom.Z ) )
+    batch_templates.emplace( atom.Z, BatchTemplate( mg_->get_grid(atom.Z) ) );
+
+  // Atoms are processed in chunks of at least max_nbatches batches, which
+  // bounds the number of tasks generated prior to rank assignment
   const size_t max_nbatches = mg_->max_nbatches();
-  std::vector< std::pair<size_t, XCTask> > temp_tasks;
-  temp_tasks.reserve( max_nbatches );
-
-  // For batching of multiple atom screening
-  size_t batch_idx_offset = 0;
+  std::vector< std::pair<int32_t, size_t> > chunk_batches; // (atom, batch)
+  std::vector< XCTask > temp_tasks;
+  chunk_batches.reserve( 2 * max_nbatches );
+
+  std::vector< batch_screening > chunk_screening;
+  std::vector< int32_t > chunk_owners;
+
+  int32_t iCurrent = 0;
+  while( iCurrent < (int32_t)natoms ) {
+
+    chunk_batches.clear();
+    for( ; iCurrent < (int32_t)natoms and chunk_batches.size() < max_nbatches;
+         ++iCurrent ) {
+      const auto& atom = (*this->mol_)[iCurrent];
+      const size_t nbatches = batch_templates.at( atom.Z ).nbatches();
+      for( size_t ibatch = 0; ibatch < nbatches; ++ibatch )
+        chunk_batches.emplace_back( iCurrent, ibatch );
+    }
+    const size_t nchunk = chunk_batches.size();
+
+    // Distributed generation: the batches are costed round robin over the
+    // ranks and assigned up front, such that each rank only generates (and
+    // screens) its own batches
+    if( distributed_generation_ ) {
+      auto chunk_cost = batch_costs( chunk_batches, batch_templates, 
+        world_rank, world_size, chunk_screening );
+#ifdef GAUXC_HAS_MPI
+      if( world_size > 1 )
+        MPI_Allreduce( MPI_IN_PLACE, chunk_cost.data(), nchunk, 
+          mpi_data_type<size_t>(), MPI_SUM, runtime_.comm() );
+#endif
+      chunk_owners = batch_owners( chunk_cost, global_workload );
+    }
 
-  // Loop over Atoms
-  for( const auto& atom : *this->mol_ ) {
+    // Batch generation / screening over all (atom, batch) pairs of the chunk,
+    // tasks are stored in batch order (empty tasks have npts = 0)
+    temp_tasks.clear();
+    temp_tasks.resize( nchunk );
 
-    const std::array<double,3> center = { atom.x, atom.y, atom.z };
+    #pragma omp parallel for schedule(dynamic)
+    for( size_t i = 0; i < nchunk; ++i ) {
 
-    auto& batcher = mg_->get_grid(atom.Z).batcher();
-    batcher.quadrature().recenter( center );
-    const size_t nbatches = batcher.nbatches();
+      if( distributed_generation_ and chunk_owners[i] != world_rank ) continue;
 
-    #pragma omp parallel for
-    for( size_t ibatch = 0; ibatch < nbatches; ++ibatch ) {
-    
-      size_t batch_idx = ibatch + batch_idx_offset;
+      const auto [iAtom, ibatch] = chunk_batches[i];
+      const auto& atom = (*this->mol_)[iAtom];
+      const std::array<double,3> center = { atom.x, atom.y, atom.z };
 
       // Generate the batch (non-negligible cost)
-      auto [lo, up, points, weights] = batcher.at(ibatch);
+      auto [lo, up, points, weights] = 
+        batch_templates.at( atom.Z ).at( ibatch, center );
 
       if( points.size() == 0 ) continue;
 
-      // Microbatch Screening
-      auto [shell_list, nbe] = micro_batch_screen( (*this->basis_), lo, up );
+      // Microbatch Screening (reuse the screening of batches costed locally)
+      auto [shell_list, nbe] = 
+        ( distributed_generation_ and i % world_size == size_t(world_rank) ) ?
+        std::move( chunk_screening[i] ) :
+        micro_batch_screen( (*this->basis_), lo, up );
 
       // Course grain screening
       if( not shell_list.size() ) continue; 
 
       // Copy task data
-      XCTask task;
-      task.iParent    = iCurrent;
+      XCTask& task = temp_tasks[i];
+      task.iParent    = iAtom;
       // This enables lazy assignment of points vector (see CUDA impl)
       task.npts       = points.size(); 
       task.points     = std::move( points );
       task.weights    = std::move( weights );
       task.bfn_screening.shell_list = std::move(shell_list);
       task.bfn_screening.nbe        = nbe;
-      task.dist_nearest = molmeta_->dist_nearest()[iCurrent];
-
-      #pragma omp critical
-      temp_tasks.push_back( 
-        std::pair(batch_idx,std::move( task )) 
-      );
+      task.dist_nearest = molmeta_->dist_nearest()[iAtom];
 
     } // omp parallel for over batches
 
 
+    // Assign batches to MPI ranks (in batch order for deterministic assignment)
+    for( auto& task : temp_tasks ) {
 
+      if( not task.npts ) continue;
 
-
-    // Assign Tasks to MPI ranks
-    if( (iCurrent+1) % atBatchSz == 0 or iCurrent == ((int32_t)natoms-1) ) {
-
-      // Sort based on task index for deterministic assignment
-      std::sort( temp_tasks.begin(), temp_tasks.end(), 
-        []( const auto& a, const auto& b ) {
-          return a.first < b.first;
-        } );
-
-      // Assign batches to MPI ranks
-      for( size_t ibatch = 0; ibatch < temp_tasks.size(); ++ibatch ) {
-
-        XCTask task = std::move(temp_tasks.at(ibatch).second);
-        //auto& points = task.points;
-        //auto  nbe    = task.nbe;
-
-        // Get rank with minimum work
-        auto min_rank_it = 
-          std::min_element( global_workload.begin(), global_workload.end() );
-        int64_t min_rank = std::distance( global_workload.begin(), min_rank_it );
-
-        // Compute cost heuristic and increment total work
-        global_workload[ min_rank ] += task.cost( n_deriv, natoms );
-
-        if( world_rank == min_rank ) 
-          local_work.push_back( std::move(task) );
-
+      // Distributed generation: batches have been assigned up front
+      if( distributed_generation_ ) {
+        local_work.push_back( std::move(task) );
+        continue;
       }
 
-      temp_tasks.clear();
+      // Get rank with minimum work
+      auto min_rank_it = 
+        std::min_element( global_workload.begin(), global_workload.end() );
+      int64_t min_rank = std::distance( global_workload.begin(), min_rank_it );
 
-    }
+      // Compute cost heuristic and increment total work
+      global_workload[ min_rank ] += task.cost( n_deriv, natoms );
 
+      if( world_rank == min_rank ) 
+        local_work.push_back( std::move(task) );
 
-    // Update counters and offsets
-    iCurrent++;
-    batch_idx_offset += nbatches;
+    }
 
-  } // Loop over Atoms
+  } // Loop over atom chunks
 
 //return local_work;
 
@@ -8,6 +8,8 @@
 #pragma once
 
 #include "load_balancer_impl.hpp"
+#include "batch_template.hpp"
+#include <unordered_map>
 
 namespace GauXC  {
 namespace detail {
@@ -19,6 +21,49 @@ protected:
   using basis_type = BasisSet<double>;
   std::vector< XCTask > create_local_tasks_() const override;
 
+  /// Whether ranks only generate the batches assigned to them, see
+  /// batch_costs / batch_owners
+  bool distributed_generation_ = false;
+
+  /// Shell list and number of basis functions of a screened batch
+  using batch_screening = std::pair< std::vector<int32_t>, size_t >;
+
+  /**
+   *  Cost of the tasks of a set of batches, which does not require the
+   *  generation of the batches: the cost of each batch follows from its
+   *  number of points and the shells screened over its extent (both known
+   *  from the batch template), i.e. it equals the cost of the generated task.
+   *
+   *  The batches are costed round robin over the ranks (batch i on rank
+   *  i % nranks), all other entries are zero, such that the costs of all
+   *  batches follow from a sum reduction over the ranks. The screening of
+   *  the costed batches is kept for the generation of the owned tasks.
+   *
+   *  @param[in]  batches         (atom, batch) pairs
+   *  @param[in]  batch_templates Batch templates of the atomic grids
+   *  @param[in]  rank            Rank costing the batches
+   *  @param[in]  nranks          Number of ranks
+   *  @param[out] screening       Screening of the batches costed on rank
+   *  @returns    Cost of each batch costed on rank (0 for batches yielding
+   *              no task and batches costed on other ranks)
+   */
+  std::vector<size_t> batch_costs( 
+    const std::vector< std::pair<int32_t, size_t> >& batches,
+    const std::unordered_map< AtomicNumber, BatchTemplate >& batch_templates,
+    int32_t rank, int32_t nranks, 
+    std::vector< batch_screening >& screening ) const;
+
+  /**
+   *  Deterministic (greedy) assignment of batches to ranks in batch order,
+   *  as for the generated tasks
+   *
+   *  @param[in]     cost     Cost of each batch (see batch_costs)
+   *  @param[in,out] workload Workload of each rank
+   *  @returns       Owning rank of each batch (-1 for batches yielding no task)
+   */
+  static std::vector<int32_t> batch_owners( const std::vector<size_t>& cost,
+    std::vector<size_t>& workload );
+
 public:
 
   HostReplicatedLoadBalancer() = delete;
@@ -31,6 +76,11 @@ public:
 
   virtual ~HostReplicatedLoadBalancer() noexcept;
 
+  /// Only generate / screen the batches owned by this rank
+  inline void set_distributed_generation( bool d ) {
+    distributed_generation_ = d;
+  }
+
   virtual std::pair< std::vector<int32_t>, size_t > micro_batch_screen(
     const BasisSet<double>&, const std::array<double,3>&,
     const std::array<double,3>& ) const = 0;
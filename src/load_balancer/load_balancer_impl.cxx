@@ -18,6 +18,7 @@ LoadBalancerImpl::LoadBalancerImpl( const RuntimeEnvironment& rt, const Molecule
   molmeta_( molmeta ) { 
 
   basis_map_   = std::make_shared<basis_map_type>(*basis_, mol);
+  shell_index_ = std::make_shared<ShellSpatialIndex>(*basis_);
 
 }
 
@@ -120,6 +121,10 @@ const LoadBalancerImpl::shell_pair_type& LoadBalancerImpl::shell_pairs() {
   return *shell_pairs_;
 }
 
+const ShellSpatialIndex& LoadBalancerImpl::shell_index() const {
+  return *shell_index_;
+}
+
 const RuntimeEnvironment& LoadBalancerImpl::runtime() const {
   return runtime_;
 }
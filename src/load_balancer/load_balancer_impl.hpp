@@ -8,6 +8,7 @@
 #pragma once
 
 #include <gauxc/load_balancer.hpp>
+#include "shell_spatial_index.hpp"
 
 namespace GauXC  {
 namespace detail {
@@ -29,6 +30,7 @@ protected:
   std::shared_ptr<MolMeta>    molmeta_;
   std::shared_ptr<basis_map_type> basis_map_;
   std::shared_ptr<shell_pair_type> shell_pairs_;
+  std::shared_ptr<ShellSpatialIndex> shell_index_;
 
   std::vector< XCTask >     local_tasks_;
 
@@ -74,6 +76,7 @@ public:
   const basis_map_type& basis_map() const;
   const shell_pair_type& shell_pairs() const;
   const shell_pair_type& shell_pairs();
+  const ShellSpatialIndex& shell_index() const;
 
   LoadBalancerState& state();
 
@@ -0,0 +1,136 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "shell_spatial_index.hpp"
+#include <gauxc/util/geometry.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace GauXC  {
+namespace detail {
+
+ShellSpatialIndex::ShellSpatialIndex( const BasisSet<double>& basis ) {
+
+  const size_t nsh = basis.nshells();
+  centers_.reserve( nsh );
+  radii_.reserve( nsh );
+  for( const auto& sh : basis ) {
+    centers_.emplace_back( sh.O() );
+    radii_.emplace_back( sh.cutoff_radius() );
+  }
+
+  order_.resize( nsh );
+  std::iota( order_.begin(), order_.end(), 0 );
+
+  if( nsh ) {
+    nodes_.reserve( 2 * (nsh / leaf_size + 1) );
+    build( 0, nsh );
+  }
+
+}
+
+bool ShellSpatialIndex::indexes( const BasisSet<double>& basis ) const {
+
+  if( (size_t)basis.nshells() != nshells() ) return false;
+  for( size_t iSh = 0; iSh < nshells(); ++iSh ) {
+    const auto& sh = basis[iSh];
+    if( sh.O() != centers_[iSh] or sh.cutoff_radius() != radii_[iSh] )
+      return false;
+  }
+  return true;
+
+}
+
+int32_t ShellSpatialIndex::build( int32_t begin, int32_t end ) {
+
+  // Bounding box of the cutoff spheres. The boxes are padded (relative to
+  // the coordinates) such that pruning is conservative w.r.t. the rounding
+  // of cube_sphere_intersect
+  node_type node;
+  node.lo.fill(  std::numeric_limits<double>::infinity() );
+  node.up.fill( -std::numeric_limits<double>::infinity() );
+  std::array<double,3> c_lo = node.lo, c_up = node.up;
+  for( int32_t i = begin; i < end; ++i ) {
+    const auto& c = centers_[order_[i]];
+    const auto  r = radii_[order_[i]];
+    for( int k = 0; k < 3; ++k ) {
+      const double pad = 1e-10 * (std::abs(c[k]) + r);
+      node.lo[k] = std::min( node.lo[k], c[k] - r - pad );
+      node.up[k] = std::max( node.up[k], c[k] + r + pad );
+      c_lo[k]    = std::min( c_lo[k], c[k] );
+      c_up[k]    = std::max( c_up[k], c[k] );
+    }
+  }
+  node.begin = begin;
+  node.end   = end;
+  node.left  = -1;
+  node.right = -1;
+
+  const int32_t inode = nodes_.size();
+  nodes_.emplace_back( node );
+  if( end - begin <= (int32_t)leaf_size ) return inode;
+
+  // Median split of the centers along the longest extent
+  int axis = 0;
+  for( int k = 1; k < 3; ++k )
+  if( c_up[k] - c_lo[k] > c_up[axis] - c_lo[axis] ) axis = k;
+
+  const int32_t mid = begin + (end - begin) / 2;
+  std::nth_element( order_.begin() + begin, order_.begin() + mid,
+    order_.begin() + end, [&]( int32_t a, int32_t b ) {
+      return centers_[a][axis] < centers_[b][axis];
+    } );
+
+  const auto left  = build( begin, mid );
+  const auto right = build( mid,   end );
+  nodes_[inode].left  = left;
+  nodes_[inode].right = right;
+
+  return inode;
+
+}
+
+void ShellSpatialIndex::query( const std::array<double,3>& lo,
+  const std::array<double,3>& up, std::vector<int32_t>& shell_list ) const {
+
+  shell_list.clear();
+  if( nodes_.empty() ) return;
+
+  // Depth of the (median split) tree is bounded by log2(nshells)
+  std::array<int32_t,64> stack;
+  int32_t nstack = 0;
+  stack[nstack++] = 0;
+  while( nstack ) {
+
+    const auto& node = nodes_[ stack[--nstack] ];
+
+    bool overlap = true;
+    for( int k = 0; k < 3; ++k )
+      overlap = overlap and node.lo[k] <= up[k] and node.up[k] >= lo[k];
+    if( not overlap ) continue;
+
+    if( node.left < 0 ) {
+      for( int32_t i = node.begin; i < node.end; ++i ) {
+        const auto iSh = order_[i];
+        if( geometry::cube_sphere_intersect( lo, up, centers_[iSh], radii_[iSh] ) )
+          shell_list.emplace_back( iSh );
+      }
+    } else {
+      stack[nstack++] = node.right;
+      stack[nstack++] = node.left;
+    }
+
+  }
+
+  std::sort( shell_list.begin(), shell_list.end() );
+
+}
+
+}
+}
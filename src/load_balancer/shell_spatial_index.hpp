@@ -0,0 +1,62 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/basisset.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace GauXC  {
+namespace detail {
+
+/**
+ *  Bounding volume hierarchy over the cutoff spheres of the shells of a basis
+ *
+ *  Replaces the O(nshells) scan of the shells intersecting a (batch) bounding
+ *  box by a tree traversal. Candidate shells are tested with
+ *  geometry::cube_sphere_intersect, i.e. queries yield exactly the shells of
+ *  the linear scan (in ascending order).
+ */
+class ShellSpatialIndex {
+
+public:
+
+  static constexpr size_t leaf_size = 8;
+
+  ShellSpatialIndex( const BasisSet<double>& basis );
+
+  /// Indices of the shells whose cutoff sphere intersects [lo,up] (ascending)
+  void query( const std::array<double,3>& lo, const std::array<double,3>& up,
+              std::vector<int32_t>& shell_list ) const;
+
+  inline size_t nshells() const { return centers_.size(); }
+
+  /// Whether the index was built for (the shell centers and cutoff radii of)
+  /// a basis
+  bool indexes( const BasisSet<double>& basis ) const;
+
+private:
+
+  struct node_type {
+    std::array<double,3> lo, up; ///< Bounding box of the cutoff spheres
+    int32_t begin, end;          ///< Range of shells (leaves) in order_
+    int32_t left, right;         ///< Children (-1 for leaves)
+  };
+
+  int32_t build( int32_t begin, int32_t end );
+
+  std::vector< std::array<double,3> > centers_;
+  std::vector< double >               radii_;
+  std::vector< int32_t >              order_;
+  std::vector< node_type >            nodes_;
+
+};
+
+}
+}
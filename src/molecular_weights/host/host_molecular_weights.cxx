@@ -31,7 +31,7 @@ void HostMolecularWeights::modify_weights( LoadBalancer& lb ) const {
   const auto& mol  = lb.molecule();
   const auto& meta = lb.molmeta();
   lwd->partition_weights( this->settings_.weight_alg, mol, meta, 
-    tasks.begin(), tasks.end() );
+    tasks.begin(), tasks.end(), this->settings_.vectorized_weights );
 
   lb.state().modified_weights_are_stored = true;
 }
@@ -24,6 +24,32 @@ void MolecularWeights::modify_weights(load_balancer_reference lb) const {
   if(not pimpl_) GAUXC_PIMPL_NOT_INITIALIZED();
   auto& timer = pimpl_->get_timer();
   timer.time_op("MolecularWeights",[&](){ pimpl_->modify_weights(lb);});
+  if(pimpl_->settings().compact_grid)
+    timer.time_op("MolecularWeights.Compact",[&](){ pimpl_->compact_tasks(lb);});
+}
+
+namespace detail {
+
+void MolecularWeightsImpl::compact_tasks(LoadBalancer& lb) const {
+
+  auto& tasks = lb.get_tasks();
+  const auto tol = settings_.compact_weight_tol;
+
+  #pragma omp parallel for schedule(dynamic)
+  for( size_t i = 0; i < tasks.size(); ++i ) tasks[i].compact(tol);
+
+  // Drop empty tasks. At least one task is retained s.t. the load balancer
+  // does not regenerate the (uncompacted) task list on next access
+  auto is_empty = [](const XCTask& t){ return t.points.size() == 0; };
+  if( std::all_of( tasks.begin(), tasks.end(), is_empty ) ) {
+    tasks.resize(1);
+  } else {
+    tasks.erase( std::remove_if( tasks.begin(), tasks.end(), is_empty ), 
+      tasks.end() );
+  }
+
+}
+
 }
 
 const util::Timer& MolecularWeights::get_timings() const {
@@ -32,6 +32,14 @@ public:
     settings_(settings) {}
 
   virtual void modify_weights(LoadBalancer&) const = 0;
+
+  /// Drop points with |w| < settings_.compact_weight_tol and empty tasks
+  void compact_tasks(LoadBalancer&) const;
+
+  inline const MolecularWeightsSettings& settings() const {
+    return settings_;
+  }
+
   inline const util::Timer& get_timings() const {
     return timer_;
   };
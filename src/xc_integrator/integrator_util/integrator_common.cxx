@@ -11,6 +11,8 @@
 #include <array>
 #include <vector>
 #include <cstdint>
+#include <cmath>
+#include <algorithm>
 
 namespace GauXC      {
 
@@ -140,5 +142,27 @@ std::tuple< std::vector< std::array<int32_t, 3> > , std::vector< int32_t > >
 }
 
 
+void shell_block_max_abs( const BasisSetMap& basis_map, int32_t nshells,
+  const double* A, int64_t lda, double* norms ) {
+
+  #pragma omp parallel for schedule(dynamic)
+  for( int32_t jsh = 0; jsh < nshells; ++jsh ) {
+    const auto [j_st, j_en] = basis_map.shell_to_ao_range(jsh);
+  for( int32_t ish = 0; ish < nshells; ++ish ) {
+    const auto [i_st, i_en] = basis_map.shell_to_ao_range(ish);
+
+    double tmp = 0.;
+    for( int32_t j = j_st; j < j_en; ++j )
+    for( int32_t i = i_st; i < i_en; ++i )
+      tmp = std::max( tmp, std::abs(A[i + j*lda]) );
+
+    auto& nrm = norms[ish + size_t(jsh)*nshells];
+    nrm = std::max( nrm, tmp );
+  }
+  }
+
+}
+
+
 
 }
@@ -16,5 +16,18 @@ std::tuple< std::vector< std::array<int32_t, 3> >, std::vector< int32_t > >
                              const std::vector< int32_t >& shell_mask,
 		             const int32_t LDA, const int32_t block_size ); 
 
+/**
+ *  Update the largest absolute value of each shell pair block of A, i.e.
+ *  norms(i,j) = max( norms(i,j), max|A(shell i, shell j)| )
+ *
+ *  @param[in]     basis_map  Basis map of the first nshells shells
+ *  @param[in]     nshells    Number of shells
+ *  @param[in]     A          Matrix ((nbf,nbf), col major)
+ *  @param[in]     lda        Leading dimension of A
+ *  @param[in/out] norms      Shell pair norms ((nshells,nshells), col major)
+ */
+void shell_block_max_abs( const BasisSetMap& basis_map, int32_t nshells,
+  const double* A, int64_t lda, double* norms );
+
 
 }
@@ -0,0 +1,66 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include <gauxc/reduction_driver.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace GauXC::detail {
+
+/// Copy the lower triangle of A (col major) into its upper triangle
+template <typename T>
+void symmetrize_lower( int64_t n, T* A, int64_t lda ) {
+  #pragma omp parallel for schedule(static)
+  for( int64_t j = 0; j < n; ++j )
+  for( int64_t i = 0; i < j; ++i ) A[i + j*lda] = A[j + i*lda];
+}
+
+/// Pack the lower triangle of A (col major) into AP ('L' packed storage)
+template <typename T>
+void pack_lower( int64_t n, const T* A, int64_t lda, T* AP ) {
+  #pragma omp parallel for schedule(static)
+  for( int64_t j = 0; j < n; ++j ) {
+    T* AP_j = AP + j*n - (j*(j-1))/2;
+    for( int64_t i = j; i < n; ++i ) AP_j[i-j] = A[i + j*lda];
+  }
+}
+
+/// Expand AP ('L' packed storage) into both triangles of A (col major)
+template <typename T>
+void unpack_lower_symmetric( int64_t n, const T* AP, T* A, int64_t lda ) {
+  #pragma omp parallel for schedule(static)
+  for( int64_t j = 0; j < n; ++j ) {
+    const T* AP_j = AP + j*n - (j*(j-1))/2;
+    for( int64_t i = j; i < n; ++i ) A[i + j*lda] = AP_j[i-j];
+  }
+  symmetrize_lower( n, A, lda );
+}
+
+/**
+ *  Sum a symmetric matrix over all ranks. Only the lower triangle of A is
+ *  referenced on entry, on exit A is fully populated. The reduction is
+ *  performed on packed storage, i.e. n*(n+1)/2 elements are communicated.
+ */
+template <typename T>
+void allreduce_symmetric_inplace( ReductionDriver& reduction_driver,
+  int comm_size, int64_t n, T* A, int64_t lda ) {
+
+  if( comm_size == 1 ) {
+    symmetrize_lower( n, A, lda );
+    return;
+  }
+
+  std::vector<T> AP( (n * (n+1)) / 2 );
+  pack_lower( n, A, lda, AP.data() );
+  reduction_driver.allreduce_inplace( AP.data(), AP.size(), ReductionOp::Sum );
+  unpack_lower_symmetric( n, AP.data(), A, lda );
+
+}
+
+}
@@ -0,0 +1,307 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/enums.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace GauXC {
+
+/**
+ *  Concurrent accumulation of dense sub-matrix contributions into a
+ *  (replicated) host matrix, i.e. the VXC / K update of each task.
+ *
+ *  Atomic:        One OpenMP atomic per element (legacy behaviour)
+ *  ThreadPrivate: Thread 0 updates the target directly, every other thread
+ *                 updates a private (M,N) copy. `finalize` merges the
+ *                 copies into the target by a parallel pairwise tree
+ *                 reduction.
+ *  TileLocks:     The target is partitioned into tile_size x tile_size
+ *                 tiles guarded by a striped set of OpenMP locks. Each
+ *                 contribution is split on tile boundaries and every piece
+ *                 is added under its tile lock.
+ *  Default:       ThreadPrivate if the private copies fit in max_bytes,
+ *                 TileLocks otherwise.
+ *
+ *  For symmetric targets (lower = true) only contributions to the lower
+ *  triangle are accumulated, blocks above the diagonal are never touched.
+ *
+ *  Construction and `finalize` must be called outside of any OpenMP parallel
+ *  region, `inc` may be called concurrently from within one.
+ */
+class HostSubmatAccumulator {
+
+public:
+
+  using submat_map_t = std::vector<std::array<int32_t,3>>;
+
+  static constexpr int32_t tile_size = 64;
+
+private:
+
+  HostAccumulation strategy_;
+  int32_t          m_, n_, lda_;
+  double*          A_;
+  bool             lower_;
+  int              nthreads_ = 1;
+
+  /// Thread private copies (ld = m), slot 0 is unused (aliases A)
+  std::vector<std::unique_ptr<double[]>> private_;
+
+  int32_t ntile_m_ = 0, ntile_n_ = 0;
+#ifdef _OPENMP
+  std::vector<omp_lock_t> locks_;
+#endif
+
+  inline int thread_id() const {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+  }
+
+  /// First row of column j of a block with row offset D (= I - J) w.r.t.
+  /// the diagonal of the target which is to be updated
+  inline int32_t row_start( int32_t j, int32_t D ) const {
+    return lower_ ? std::max( 0, j - D ) : 0;
+  }
+
+  template <typename F>
+  void add_block( int32_t M, int32_t N, int32_t D, double* A, int32_t LDA,
+    const F* B, int32_t LDB ) const {
+    for( int32_t j = 0; j < N; ++j )
+    for( int32_t i = row_start(j,D); i < M; ++i ) A[i + j*LDA] += B[i + j*LDB];
+  }
+
+  template <typename F>
+  void add_block_atomic( int32_t M, int32_t N, int32_t D, double* A, 
+    int32_t LDA, const F* B, int32_t LDB ) const {
+    for( int32_t j = 0; j < N; ++j )
+    for( int32_t i = row_start(j,D); i < M; ++i ) {
+      #ifdef _OPENMP
+      #pragma omp atomic
+      #endif
+      A[i + j*LDA] += B[i + j*LDB];
+    }
+  }
+
+  /// Add an (M,N) block at (I,J) of the target, split on tile boundaries
+  template <typename F>
+  void add_block_locked( int32_t I, int32_t J, int32_t M, int32_t N,
+    const F* B, int32_t LDB ) {
+#ifdef _OPENMP
+    const int32_t nlocks = locks_.size();
+    for( int32_t j0 = J; j0 < J + N; ) {
+      const int32_t jt = j0 / tile_size;
+      const int32_t j1 = std::min( (jt+1)*tile_size, J + N );
+    for( int32_t i0 = I; i0 < I + M; ) {
+      const int32_t it = i0 / tile_size;
+      const int32_t i1 = std::min( (it+1)*tile_size, I + M );
+      if( lower_ and it < jt ) { i0 = i1; continue; } // Upper tile
+
+      auto& lock = locks_[ (it + jt * ntile_m_) % nlocks ];
+      omp_set_lock( &lock );
+      add_block( i1 - i0, j1 - j0, i0 - j0, A_ + i0 + j0*lda_, lda_,
+        B + (i0 - I) + (j0 - J)*LDB, LDB );
+      omp_unset_lock( &lock );
+
+      i0 = i1;
+    }
+      j0 = j1;
+    }
+#else
+    add_block( M, N, I - J, A_ + I + J*lda_, lda_, B, LDB );
+#endif
+  }
+
+public:
+
+  /**
+   *  @param[in]  strategy   Requested accumulation strategy
+   *  @param[in]  m          Number of rows of the target
+   *  @param[in]  n          Number of columns of the target
+   *  @param[in/out] A       Target matrix, contributions are added to it
+   *  @param[in]  lda        Leading dimension of A
+   *  @param[in]  max_bytes  Budget for thread private storage (Default)
+   *  @param[in]  lower      Only accumulate the lower triangle of A
+   */
+  HostSubmatAccumulator( HostAccumulation strategy, int32_t m, int32_t n,
+    double* A, int32_t lda, size_t max_bytes, bool lower = false ) :
+    strategy_(strategy), m_(m), n_(n), lda_(lda), A_(A), lower_(lower) {
+
+#ifdef _OPENMP
+    nthreads_ = omp_get_max_threads();
+#endif
+
+    if( strategy_ == HostAccumulation::Default ) {
+      const size_t priv_bytes = size_t(nthreads_-1) * m_ * n_ * sizeof(double);
+      strategy_ = (priv_bytes <= max_bytes) ? HostAccumulation::ThreadPrivate :
+                                              HostAccumulation::TileLocks;
+    }
+
+    if( strategy_ == HostAccumulation::ThreadPrivate ) {
+      // Allocated on first use by the owning thread
+      private_.resize( nthreads_ );
+    }
+
+    if( strategy_ == HostAccumulation::TileLocks ) {
+      ntile_m_ = (m_ + tile_size - 1) / tile_size;
+      ntile_n_ = (n_ + tile_size - 1) / tile_size;
+#ifdef _OPENMP
+      const size_t nlocks = std::max( 1, std::min( ntile_m_ * ntile_n_,
+        16 * nthreads_ ) );
+      locks_.resize( nlocks );
+      for( auto& l : locks_ ) omp_init_lock( &l );
+#endif
+    }
+
+  }
+
+  ~HostSubmatAccumulator() noexcept {
+#ifdef _OPENMP
+    for( auto& l : locks_ ) omp_destroy_lock( &l );
+#endif
+  }
+
+  HostSubmatAccumulator( const HostSubmatAccumulator& ) = delete;
+  HostSubmatAccumulator( HostSubmatAccumulator&& )      = delete;
+
+  /// Resolved accumulation strategy (never Default)
+  inline HostAccumulation strategy() const { return strategy_; }
+
+  /// Whether only the lower triangle of the target is accumulated
+  inline bool lower() const { return lower_; }
+
+  inline double* target()     { return A_;   }
+  inline int32_t ld()   const { return lda_; }
+
+  /**
+   *  Destination of the calling thread for in place updates, i.e. the
+   *  target (thread 0) or the private copy of the thread. Only valid for
+   *  the ThreadPrivate strategy, returns (nullptr, 0) otherwise.
+   *
+   *  Updates through the returned pointer must respect `lower`.
+   */
+  std::pair<double*,int32_t> local_target() {
+    if( strategy_ != HostAccumulation::ThreadPrivate ) return { nullptr, 0 };
+    const int tid = thread_id();
+    if( not tid ) return { A_, lda_ };
+    auto& buf = private_[tid];
+    if( not buf ) {
+      buf.reset( new double[ size_t(m_) * n_ ] );
+      std::fill_n( buf.get(), size_t(m_) * n_, 0. );
+    }
+    return { buf.get(), m_ };
+  }
+
+  /**
+   *  Increment the target by a dense (MSub,NSub) block scattered by
+   *  contiguous row / column cuts (see detail::inc_by_submat)
+   */
+  template <typename F>
+  void inc( int32_t MSub, int32_t NSub, const F* ASmall, int32_t LDAS,
+    const submat_map_t& submat_map_row, const submat_map_t& submat_map_col ) {
+
+    (void)(MSub);
+    (void)(NSub);
+
+    // Resolve the destination of this thread
+    double* A   = A_;
+    int32_t LDA = lda_;
+    if( strategy_ == HostAccumulation::ThreadPrivate ) 
+      std::tie( A, LDA ) = local_target();
+
+    int32_t i(0);
+    for( auto& iCut : submat_map_row ) {
+      const int32_t deltaI = iCut[1];
+      int32_t j(0);
+    for( auto& jCut : submat_map_col ) {
+      const int32_t deltaJ = jCut[1];
+      const auto* ASmall_use = ASmall + i + j * LDAS;
+
+      // Skip blocks strictly above the diagonal
+      const int32_t D = iCut[0] - jCut[0];
+      if( lower_ and iCut[0] + deltaI <= jCut[0] ) { j += deltaJ; continue; }
+
+      switch( strategy_ ) {
+        case HostAccumulation::ThreadPrivate:
+          add_block( deltaI, deltaJ, D, A + iCut[0] + jCut[0]*LDA, LDA,
+            ASmall_use, LDAS );
+          break;
+        case HostAccumulation::TileLocks:
+          add_block_locked( iCut[0], jCut[0], deltaI, deltaJ, ASmall_use,
+            LDAS );
+          break;
+        default:
+          add_block_atomic( deltaI, deltaJ, D, A + iCut[0] + jCut[0]*LDA, LDA,
+            ASmall_use, LDAS );
+      }
+
+      j += deltaJ;
+    }
+      i += deltaI;
+    }
+
+  }
+
+  template <typename F>
+  void inc( int32_t MSub, int32_t NSub, const F* ASmall, int32_t LDAS,
+    const submat_map_t& submat_map ) {
+    inc( MSub, NSub, ASmall, LDAS, submat_map, submat_map );
+  }
+
+  /// Merge thread private contributions into the target
+  void finalize() {
+
+    if( strategy_ != HostAccumulation::ThreadPrivate ) return;
+
+    // Pairwise tree reduction: at each level, slot p absorbs slot p + stride
+    for( int stride = 1; stride < nthreads_; stride *= 2 ) {
+
+      std::vector<std::pair<int,int>> pairs;
+      for( int p = 0; p + stride < nthreads_; p += 2*stride )
+      if( private_[p+stride] ) pairs.emplace_back( p, p+stride );
+      const int32_t npairs = pairs.size();
+      if( not npairs ) continue;
+
+      // Slots which have never been touched simply adopt their partner
+      for( auto [dst, src] : pairs )
+      if( dst and not private_[dst] ) private_[dst] = std::move(private_[src]);
+
+      #pragma omp parallel for collapse(2) schedule(static)
+      for( int32_t ip = 0; ip < npairs; ++ip )
+      for( int32_t j  = 0; j  < n_;     ++j  ) {
+        const auto [dst, src] = pairs[ip];
+        if( not private_[src] ) continue; // Adopted
+        double*       A   = dst ? private_[dst].get() : A_;
+        const int32_t LDA = dst ? m_ : lda_;
+        const double* B   = private_[src].get();
+        for( int32_t i = row_start(j,0); i < m_; ++i ) 
+          A[i + j*LDA] += B[i + size_t(j)*m_];
+      }
+
+      for( auto& pr : pairs ) private_[pr.second].reset();
+
+    }
+
+  }
+
+};
+
+}
@@ -0,0 +1,222 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace GauXC {
+
+/**
+ *  Scratch arena of the host XC integration
+ *
+ *  Memory is handed out as 64 byte aligned, uninitialized slices of a list
+ *  of blocks. Blocks are never moved, i.e. slices remain valid until they
+ *  are released (in stack order via mark() / release()). New blocks are
+ *  touched once by the allocating thread, such that their pages reside on
+ *  the NUMA domain of the thread owning the arena (first touch). Once the
+ *  arena has been released completely, multiple blocks are coalesced into a
+ *  single block of the high water mark on the next allocation.
+ */
+class HostScratchArena {
+
+public:
+
+  static constexpr size_t alignment = 64;
+
+  /// Position of the arena, see mark() / release()
+  struct mark_type {
+    size_t block  = 0;
+    size_t offset = 0;
+
+    inline bool operator==( const mark_type& other ) const noexcept {
+      return block == other.block and offset == other.offset;
+    }
+  };
+
+  HostScratchArena() = default;
+  HostScratchArena( const HostScratchArena& ) = delete;
+  HostScratchArena& operator=( const HostScratchArena& ) = delete;
+  HostScratchArena( HostScratchArena&& ) noexcept = default;
+  HostScratchArena& operator=( HostScratchArena&& ) noexcept = default;
+
+  /// Make at least bytes available in a single block (no-op if in use)
+  void reserve( size_t bytes ) {
+    if( in_use() or (blocks_.size() == 1 and blocks_[0].size >= bytes) ) return;
+    blocks_.clear();
+    add_block( bytes );
+  }
+
+  /// Uninitialized, aligned slice of n objects of type T
+  template <typename T>
+  T* allocate( size_t n ) {
+    if( not in_use() and blocks_.size() > 1 ) {
+      blocks_.clear();
+      add_block( hwm_ );
+    }
+
+    const size_t bytes = slice_bytes( n * sizeof(T) );
+    while( block_ < blocks_.size() and offset_ + bytes > blocks_[block_].size ) {
+      base_  += blocks_[block_].size;
+      offset_ = 0;
+      ++block_;
+    }
+    if( block_ == blocks_.size() ) add_block( std::max( bytes, base_ ) );
+
+    auto* ptr = blocks_[block_].data.get() + offset_;
+    offset_ += bytes;
+    hwm_     = std::max( hwm_, base_ + offset_ );
+    return reinterpret_cast<T*>( ptr );
+  }
+
+  /// Bytes of the arena occupied by a slice of the given size
+  static constexpr size_t slice_bytes( size_t bytes ) {
+    return round_up( std::max<size_t>( bytes, 1 ) );
+  }
+
+  inline mark_type mark() const noexcept { return { block_, offset_ }; }
+
+  /// Release all slices allocated after m
+  void release( mark_type m ) noexcept {
+    block_  = m.block;
+    offset_ = m.offset;
+    base_   = 0;
+    for( size_t i = 0; i < block_; ++i ) base_ += blocks_[i].size;
+  }
+
+  inline void   clear()                   { release( mark_type{} ); }
+  inline bool   in_use()            const { return block_ or offset_; }
+  inline size_t high_water_mark()   const { return hwm_; }
+  inline size_t capacity()          const {
+    size_t sz = 0;
+    for( const auto& b : blocks_ ) sz += b.size;
+    return sz;
+  }
+
+private:
+
+  struct aligned_free {
+    void operator()( std::byte* ptr ) const { std::free( ptr ); }
+  };
+
+  struct block_type {
+    std::unique_ptr<std::byte[], aligned_free> data;
+    size_t size;
+  };
+
+  static constexpr size_t round_up( size_t bytes ) {
+    return (bytes + alignment - 1) / alignment * alignment;
+  }
+
+  void add_block( size_t bytes ) {
+    bytes = round_up( std::max<size_t>( bytes, 1 ) );
+    auto* ptr = static_cast<std::byte*>( std::aligned_alloc( alignment, bytes ) );
+    if( not ptr ) throw std::bad_alloc();
+    std::memset( ptr, 0, bytes ); // First touch
+    blocks_.push_back( block_type{ decltype(block_type::data)(ptr), bytes } );
+  }
+
+  std::vector<block_type> blocks_;
+  size_t block_  = 0; ///< Current block
+  size_t offset_ = 0; ///< Offset into the current block
+  size_t base_   = 0; ///< Size of the blocks preceding the current block
+  size_t hwm_    = 0; ///< High water mark (bytes)
+
+};
+
+/// Releases the slices of a HostScratchArena allocated during its lifetime
+class HostScratchScope {
+
+  HostScratchArena&           arena_;
+  HostScratchArena::mark_type mark_;
+
+public:
+
+  explicit HostScratchScope( HostScratchArena& arena ) :
+    arena_(arena), mark_(arena.mark()) { }
+  ~HostScratchScope() noexcept { arena_.release( mark_ ); }
+
+  HostScratchScope( const HostScratchScope& ) = delete;
+  HostScratchScope& operator=( const HostScratchScope& ) = delete;
+
+  template <typename T>
+  T* allocate( size_t n ) { return arena_.template allocate<T>( n ); }
+
+};
+
+/// Scratch arena of the calling thread (temporaries of host LWD kernels)
+inline HostScratchArena& thread_scratch_arena() {
+  static thread_local HostScratchArena arena;
+  return arena;
+}
+
+/**
+ *  Growable scratch buffer sliced from a HostScratchArena
+ *
+ *  Unlike std::vector, resize / reserve neither initialize nor (on growth)
+ *  preserve the contents. Growth slices a new region of at least twice the
+ *  previous capacity. The previous region is released if it is the top of
+ *  the arena (stack order) and retained by the arena otherwise, i.e. owners
+ *  of several buffers should reset() them together with the arena (see
+ *  XCHostData::release_scratch) rather than grow them independently.
+ */
+template <typename T>
+class HostScratchBuffer {
+
+  using mark_type = HostScratchArena::mark_type;
+
+  HostScratchArena* arena_    = nullptr;
+  T*                data_     = nullptr;
+  size_t            size_     = 0;
+  size_t            capacity_ = 0;
+  mark_type         begin_;   ///< Arena position prior to the slice
+  mark_type         end_;     ///< Arena position after the slice
+
+public:
+
+  HostScratchBuffer() = default;
+  explicit HostScratchBuffer( HostScratchArena* arena ) : arena_(arena) { }
+
+  inline void reserve( size_t n ) {
+    if( n <= capacity_ ) return;
+    if( data_ and arena_->mark() == end_ ) arena_->release( begin_ );
+    begin_    = arena_->mark();
+    data_     = arena_->template allocate<T>( n );
+    end_      = arena_->mark();
+    capacity_ = n;
+  }
+
+  /// Drop the slice (the arena is released separately by the owner)
+  inline void reset() noexcept {
+    data_     = nullptr;
+    size_     = 0;
+    capacity_ = 0;
+  }
+
+  inline void resize( size_t n ) {
+    if( n > capacity_ ) reserve( std::max( n, 2 * capacity_ ) );
+    size_ = n;
+  }
+
+  inline T*       data()       noexcept { return data_; }
+  inline const T* data() const noexcept { return data_; }
+  inline T*       begin()      noexcept { return data_; }
+  inline T*       end()        noexcept { return data_ + size_; }
+  inline size_t   size()     const noexcept { return size_; }
+  inline size_t   capacity() const noexcept { return capacity_; }
+
+  inline T&       operator[]( size_t i )       { return data_[i]; }
+  inline const T& operator[]( size_t i ) const { return data_[i]; }
+
+};
+
+}
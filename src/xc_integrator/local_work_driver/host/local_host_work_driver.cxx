@@ -6,6 +6,7 @@
  * See LICENSE.txt for details
  */
 #include "local_host_work_driver_pimpl.hpp"
+#include "host_accumulator.hpp"
 #include <stdexcept>
 
 namespace GauXC {
@@ -30,10 +31,11 @@ LocalHostWorkDriver::LocalHostWorkDriver( LocalHostWorkDriver&& other ) noexcept
 // Partition weights
 void LocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg, 
   const Molecule& mol, const MolMeta& meta, task_iterator task_begin, 
-  task_iterator task_end ) {
+  task_iterator task_end, bool vectorized ) {
 
   throw_if_invalid_pimpl(pimpl_);
-  pimpl_->partition_weights(weight_alg, mol, meta, task_begin, task_end);
+  pimpl_->partition_weights(weight_alg, mol, meta, task_begin, task_end,
+    vectorized);
 
 }
 
@@ -41,10 +43,11 @@ void LocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg,
 // Collocation
 void LocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, size_t nbe, 
   const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
-  double* basis_eval ) {
+  double* basis_eval, const uint64_t* shell_tile_mask ) {
 
   throw_if_invalid_pimpl(pimpl_);
-  pimpl_->eval_collocation(npts, nshells, nbe, pts, basis, shell_list, basis_eval);
+  pimpl_->eval_collocation(npts, nshells, nbe, pts, basis, shell_list, basis_eval,
+    shell_tile_mask);
 
 }
 
@@ -53,11 +56,11 @@ void LocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, size_t
 void LocalHostWorkDriver::eval_collocation_gradient( size_t npts, size_t nshells, 
   size_t nbe, const double* pts, const BasisSet<double>& basis, 
   const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
-  double* dbasis_y_eval, double* dbasis_z_eval) {
+  double* dbasis_y_eval, double* dbasis_z_eval, const uint64_t* shell_tile_mask) {
 
   throw_if_invalid_pimpl(pimpl_);
   pimpl_->eval_collocation_gradient(npts, nshells, nbe, pts, basis, shell_list, basis_eval,
-    dbasis_x_eval, dbasis_y_eval, dbasis_z_eval);
+    dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, shell_tile_mask);
 
 }
 
@@ -77,6 +80,20 @@ void LocalHostWorkDriver::eval_collocation_hessian( size_t npts, size_t nshells,
 
 }
 
+// Collocation Laplacian
+void LocalHostWorkDriver::eval_collocation_laplacian( size_t npts, size_t nshells, 
+    size_t nbe, const double* pts, const BasisSet<double>& basis, 
+    const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+    double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval,
+    const uint64_t* shell_tile_mask ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_collocation_laplacian(npts, nshells, nbe, pts, basis, shell_list, 
+    basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval,
+    shell_tile_mask);
+
+}
+
 // Collocation 3rd
 void LocalHostWorkDriver::eval_collocation_der3( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
@@ -110,6 +127,41 @@ void LocalHostWorkDriver::eval_xmat( size_t npts, size_t nbf, size_t nbe,
 
 }
 
+void LocalHostWorkDriver::eval_xmat_mixed( size_t npts, size_t nbf, size_t nbe, 
+  const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
+  const float* basis_eval, size_t ldb, double* X, size_t ldx, float* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_xmat_mixed(npts, nbf, nbe, submat_map, fac, P, ldp, basis_eval, 
+    ldb, X, ldx, scr);
+
+}
+
+void LocalHostWorkDriver::eval_xmat_batch( size_t npts, size_t nbf, size_t nbe, 
+  const submat_map_t& submat_map, size_t ndm, double fac, 
+  const double* const* P, size_t ldp, const double* basis_eval, size_t ldb, 
+  double* X, size_t ldx, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_xmat_batch(npts, nbf, nbe, submat_map, ndm, fac, P, ldp, 
+    basis_eval, ldb, X, ldx, scr);
+
+}
+
+void LocalHostWorkDriver::eval_xmat_block_sparse( size_t npts, size_t nbf, 
+  size_t nbe, const submat_map_t& submat_map, size_t nshells, 
+  const int32_t* shell_list, const BasisSetMap& basis_map, 
+  const double* shell_norms, size_t ldn, double tol, double fac, 
+  const double* P, size_t ldp, const double* basis_eval, size_t ldb, 
+  double* X, size_t ldx, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->eval_xmat_block_sparse(npts, nbf, nbe, submat_map, nshells, 
+    shell_list, basis_map, shell_norms, ldn, tol, fac, P, ldp, basis_eval, 
+    ldb, X, ldx, scr);
+
+}
+
 void LocalHostWorkDriver::eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
   size_t nbe_ket, const submat_map_t& submat_map_bra,
   const submat_map_t& submat_map_ket, const double* P, size_t ldp,
@@ -142,9 +194,19 @@ void LocalHostWorkDriver::inc_exx_k( size_t npts, size_t nbf, size_t nbe_bra,
   const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
   size_t ldk, double* scr ) {
 
+  HostSubmatAccumulator K_acc( HostAccumulation::Atomic, nbf, nbf, K, ldk, 0 );
+  inc_exx_k(npts, nbf, nbe_bra, nbe_ket, basis_eval, submat_map_bra,
+    submat_map_ket, G, ldg, K_acc, scr );
+}
+
+void LocalHostWorkDriver::inc_exx_k( size_t npts, size_t nbf, size_t nbe_bra, 
+  size_t nbe_ket, const double* basis_eval, const submat_map_t& submat_map_bra, 
+  const submat_map_t& submat_map_ket, const double* G, size_t ldg, 
+  HostSubmatAccumulator& K, double* scr ) {
+
   throw_if_invalid_pimpl(pimpl_);
   pimpl_->inc_exx_k(npts, nbf, nbe_bra, nbe_ket, basis_eval, submat_map_bra,
-    submat_map_ket, G, ldg, K, ldk, scr );
+    submat_map_ket, G, ldg, K, scr );
 }
 
 
@@ -394,8 +456,49 @@ void LocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe,
   const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
   size_t ldz, double* VXC, size_t ldvxc, double* scr ) {
 
+  HostSubmatAccumulator VXC_acc( HostAccumulation::Atomic, nbf, nbf, VXC, 
+    ldvxc, 0, true );
+  inc_vxc(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, VXC_acc, scr);
+
+}
+
+void LocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe, 
+  const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
+  size_t ldz, HostSubmatAccumulator& VXC, double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->inc_vxc(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, VXC, scr);
+
+}
+
+void LocalHostWorkDriver::inc_vxc_batch( size_t npts, size_t nbf, size_t nbe, 
+  const double* basis_eval, const submat_map_t& submat_map, size_t ndm,
+  const double* Z, size_t ldz, HostSubmatAccumulator* const* VXC, 
+  double* scr ) {
+
+  throw_if_invalid_pimpl(pimpl_);
+  pimpl_->inc_vxc_batch(npts, nbf, nbe, basis_eval, submat_map, ndm, Z, ldz,
+    VXC, scr);
+
+}
+
+void LocalHostWorkDriver::inc_vxc_mixed( size_t npts, size_t nbf, size_t nbe, 
+  const float* basis_eval, const submat_map_t& submat_map, const double* Z, 
+  size_t ldz, double* VXC, size_t ldvxc, float* scr ) {
+
+  HostSubmatAccumulator VXC_acc( HostAccumulation::Atomic, nbf, nbf, VXC, 
+    ldvxc, 0, true );
+  inc_vxc_mixed(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, VXC_acc, scr);
+
+}
+
+void LocalHostWorkDriver::inc_vxc_mixed( size_t npts, size_t nbf, size_t nbe, 
+  const float* basis_eval, const submat_map_t& submat_map, const double* Z, 
+  size_t ldz, HostSubmatAccumulator& VXC, float* scr ) {
+
   throw_if_invalid_pimpl(pimpl_);
-  pimpl_->inc_vxc(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, VXC, ldvxc, scr);
+  pimpl_->inc_vxc_mixed(npts, nbf, nbe, basis_eval, submat_map, Z, ldz, VXC, 
+    scr);
 
 }
 
@@ -23,6 +23,8 @@ struct LocalHostWorkDriverPIMPL;
 
 }
 
+class HostSubmatAccumulator;
+
 /// Base class for local work drivers in Host execution spaces 
 class LocalHostWorkDriver : public LocalWorkDriver {
 
@@ -67,9 +69,13 @@ public:
    *
    *  @param[in/out] task_begin Start iterator for task container to be modified
    *  @param[in/out] task_end   End iterator for task container to be modified
+   *
+   *  @param[in] vectorized Whether to use the point vectorized (SoA) kernels
+   *                        in favor of the scalar ones (if available)
    */
   void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
-    const MolMeta& meta, task_iterator task_begin, task_iterator task_end );
+    const MolMeta& meta, task_iterator task_begin, task_iterator task_end,
+    bool vectorized = true );
 
 
   /** Evaluation the collocation matrix
@@ -83,10 +89,15 @@ public:
    *
    *  @param[out] basis_eval Collocation matrix in col major (bfn,pts). 
    *                         Assumed to have leading dimension of nbe.
+   *
+   *  @param[in] shell_tile_mask Optional sub-tile shell significance mask
+   *                         (see XCTask::shell_tile_mask). If provided,
+   *                         negligible blocks are set to zero without being
+   *                         evaluated.
    */
   void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
-    double* basis_eval );
+    double* basis_eval, const uint64_t* shell_tile_mask = nullptr );
 
 
   /** Evaluation the collocation matrix + gradient
@@ -102,11 +113,13 @@ public:
    *  @param[out] dbasis_x_eval Derivative of `basis_eval` wrt x (same dimensions)
    *  @param[out] dbasis_y_eval Derivative of `basis_eval` wrt y (same dimensions)
    *  @param[out] dbasis_z_eval Derivative of `basis_eval` wrt z (same dimensions)
+   *
+   *  @param[in] shell_tile_mask Same as `eval_collocation`
    */
   void eval_collocation_gradient( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
-    double* dbasis_z_eval);
+    double* dbasis_z_eval, const uint64_t* shell_tile_mask = nullptr );
 
 
   /** Evaluation the collocation matrix + gradient + hessian
@@ -136,6 +149,31 @@ public:
     double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
     double* d2basis_zz_eval );
 
+  /** Evaluation the collocation matrix + gradient + laplacian
+   *
+   *  Fused evaluation which does not form the full hessian.
+   *
+   *  @param[in] npts     Same as `eval_collocation`
+   *  @param[in] nshells  Same as `eval_collocation`
+   *  @param[in] nbe      Same as `eval_collocation`
+   *  @param[in] pts      Same as `eval_collocation`
+   *  @param[in] basis    Same as `eval_collocation`
+   *  @param[in] shell_list Same as `eval_collocation`
+   *
+   *  @param[out] basis_eval    Same as `eval_collocation`
+   *  @param[out] dbasis_x_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_y_eval Same as `eval_collocation_gradient`
+   *  @param[out] dbasis_z_eval Same as `eval_collocation_gradient`
+   *  @param[out] lbasis_eval   Laplacian of `basis_eval` (same dimensions)
+   *
+   *  @param[in] shell_tile_mask Same as `eval_collocation`
+   */
+  void eval_collocation_laplacian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval, 
+    const uint64_t* shell_tile_mask = nullptr );
+
   /** Evaluation the collocation matrix + gradient + hessian + 3rd derivatives
    *
    *  @param[in] npts     Same as `eval_collocation`
@@ -196,6 +234,90 @@ public:
     const double* basis_eval, size_t ldb, double* X, size_t ldx, 
     double* scr );
 
+  /** Evaluate the compressed "X" matrix = fac * P * B in mixed precision
+   *
+   *  P is rounded to FP32 and the product is formed in FP32, X is returned
+   *  in FP64.
+   *
+   *  @param[in]  npts        Same as `eval_xmat`
+   *  @param[in]  nbf         Same as `eval_xmat`
+   *  @param[in]  nbe         Same as `eval_xmat`
+   *  @param[in]  submat_map  Same as `eval_xmat`
+   *  @param[in]  fac         Same as `eval_xmat`
+   *  @param[in]  P           Same as `eval_xmat`
+   *  @param[in]  ldp         Same as `eval_xmat`
+   *  @param[in]  basis_eval  FP32 collocation matrix ( (nbe,npts) col major)
+   *  @param[in]  ldb         The leading dimension of basis_eval
+   *  @param[out] X           Same as `eval_xmat`
+   *  @param[in]  ldx         Same as `eval_xmat`
+   *  @param[in/out] scr      FP32 scratch space of at least nbe*(nbe+npts)
+   */
+  void eval_xmat_mixed( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, double fac, const double* P, size_t ldp,
+    const float* basis_eval, size_t ldb, double* X, size_t ldx, 
+    float* scr );
+
+  /** Evaluate the compressed "X" matrices X_k = fac * P_k * B for a batch of
+   *  densities sharing one collocation matrix
+   *
+   *  The non-negligible blocks of all P_k are stacked into a (ndm*nbe,nbe)
+   *  matrix such that all X_k are formed by a single GEMM. X_k is returned
+   *  in rows [k*nbe, (k+1)*nbe) of X, i.e. X_k = X + k*nbe with leading
+   *  dimension ldx (>= ndm*nbe).
+   *
+   *  @param[in]  npts        Same as `eval_xmat`
+   *  @param[in]  nbf         Same as `eval_xmat`
+   *  @param[in]  nbe         Same as `eval_xmat`
+   *  @param[in]  submat_map  Same as `eval_xmat`
+   *  @param[in]  ndm         The number of density matrices
+   *  @param[in]  fac         Same as `eval_xmat`
+   *  @param[in]  P           The density matrices ( ndm x (nbf,nbf) col major)
+   *  @param[in]  ldp         The leading dimension of each P_k
+   *  @param[in]  basis_eval  Same as `eval_xmat`
+   *  @param[in]  ldb         Same as `eval_xmat`
+   *  @param[out] X           The stacked X matrices ( (ndm*nbe,npts) col major)
+   *  @param[in]  ldx         The leading dimension of X
+   *  @param[in/out] scr      Scratch space of at least ndm*nbe*nbe
+   */
+  void eval_xmat_batch( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, size_t ndm, double fac, 
+    const double* const* P, size_t ldp, const double* basis_eval, size_t ldb, 
+    double* X, size_t ldx, double* scr );
+
+  /** Evaluate the compressed "X" matrix from the significant shell pair 
+   *  blocks of P
+   *
+   *  X = fac * P' * B, where P' is P with the atom pair blocks (shells of
+   *  the task on the same center) whose largest shell pair norm is at or
+   *  below tol removed. Consecutive atoms with the same pattern of 
+   *  significant blocks share a GEMM. If most of P is significant for the
+   *  task, a dense `eval_xmat` is performed instead.
+   *
+   *  @param[in]  npts        Same as `eval_xmat`
+   *  @param[in]  nbf         Same as `eval_xmat`
+   *  @param[in]  nbe         Same as `eval_xmat`
+   *  @param[in]  submat_map  Same as `eval_xmat`
+   *  @param[in]  nshells     Number of shells of the task
+   *  @param[in]  shell_list  Shells of the task (in the order of the nbe bfns)
+   *  @param[in]  basis_map   Basis map
+   *  @param[in]  shell_norms Shell pair norms of P (e.g. max |P| per block)
+   *  @param[in]  ldn         Leading dimension of shell_norms
+   *  @param[in]  tol         Screening tolerance for the shell pair blocks
+   *  @param[in]  fac         Same as `eval_xmat`
+   *  @param[in]  P           Same as `eval_xmat`
+   *  @param[in]  ldp         Same as `eval_xmat`
+   *  @param[in]  basis_eval  Same as `eval_xmat`
+   *  @param[in]  ldb         Same as `eval_xmat`
+   *  @param[out] X           Same as `eval_xmat`
+   *  @param[in]  ldx         Same as `eval_xmat`
+   *  @param[in/out] scr      Same as `eval_xmat`
+   */
+  void eval_xmat_block_sparse( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, size_t nshells, const int32_t* shell_list,
+    const BasisSetMap& basis_map, const double* shell_norms, size_t ldn, 
+    double tol, double fac, const double* P, size_t ldp, 
+    const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr );
+
   void eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
     size_t nbe_ket, const submat_map_t& submat_map_bra,
     const submat_map_t& submat_map_ket, const double* P, size_t ldp,
@@ -213,6 +335,12 @@ public:
     const double* basis_eval, const submat_map_t& submat_map_bra, 
     const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
     size_t ldk, double* scr );
+
+  /// Same as `inc_exx_k`, K is updated through an accumulation strategy
+  void inc_exx_k( size_t npts, size_t nbf, size_t nbe_bra, size_t nbe_ket, 
+    const double* basis_eval, const submat_map_t& submat_map_bra, 
+    const submat_map_t& submat_map_ket, const double* G, size_t ldg, 
+    HostSubmatAccumulator& K, double* scr );
     
   /** Evaluate the U and V variavles for RKS LDA
    *
@@ -469,6 +597,61 @@ public:
     const submat_map_t& submat_map, const double* Z, size_t ldz, 
     double* VXC, size_t ldvxc, double* scr );
 
+  /// Same as `inc_vxc`, VXC is updated through an accumulation strategy
+  void inc_vxc( size_t npts, size_t nbf, size_t nbe, const double* basis_eval,
+    const submat_map_t& submat_map, const double* Z, size_t ldz, 
+    HostSubmatAccumulator& VXC, double* scr );
+
+  /** Increment a batch of VXC integrands given stacked Z matrices
+   *
+   *  VXC_k += Z_k**H * B + h.c.
+   *
+   *  Z_k = Z + k*nbe share the collocation matrix B, all Z_k**H * B are
+   *  formed by a single GEMM. Only updates the lower triangles.
+   *
+   *  @param[in] npts        Same as `inc_vxc`
+   *  @param[in] nbf         Same as `inc_vxc`
+   *  @param[in] nbe         Same as `inc_vxc`
+   *  @paran[in] basis_eval  Same as `inc_vxc`
+   *  @param[in] submat_map  Same as `inc_vxc`
+   *  @param[in] ndm         The number of Z / VXC matrices
+   *  @param[in] Z           Stacked Z matrices ((ndm*nbe,npts), col major)
+   *  @param[in] ldz         Leading dimension of Z (>= ndm*nbe)
+   *  @param[in/out] VXC     Accumulators of the ndm VXC integrands
+   *  @param[out] scr        Scratch space at least ndm*nbe*nbe
+   *
+   */
+  void inc_vxc_batch( size_t npts, size_t nbf, size_t nbe, 
+    const double* basis_eval, const submat_map_t& submat_map, size_t ndm,
+    const double* Z, size_t ldz, HostSubmatAccumulator* const* VXC, 
+    double* scr );
+
+  /** Increment VXC integrand given Z / Collocation in mixed precision
+   *
+   *  Z is rounded to FP32 and the rank-2k update is formed in FP32, the
+   *  result is accumulated into the FP64 VXC integrand.
+   *
+   *  @param[in] npts        Same as `inc_vxc`
+   *  @param[in] nbf         Same as `inc_vxc`
+   *  @param[in] nbe         Same as `inc_vxc`
+   *  @paran[in] basis_eval  FP32 compressed collocation matrix ((nbe,npts), col major, ld=nbe)
+   *  @param[in] submat_map  Same as `inc_vxc`
+   *  @param[in] Z           Same as `inc_vxc`
+   *  @param[in] ldz         Same as `inc_vxc`
+   *  @param[in/out] VXC     Same as `inc_vxc`
+   *  @param[in]  ldvxc      Same as `inc_vxc`
+   *  @param[out] scr        FP32 scratch space at least nbe*(nbe+npts)
+   *
+   */
+  void inc_vxc_mixed( size_t npts, size_t nbf, size_t nbe, const float* basis_eval,
+    const submat_map_t& submat_map, const double* Z, size_t ldz, 
+    double* VXC, size_t ldvxc, float* scr );
+
+  /// Same as `inc_vxc_mixed`, VXC is updated through an accumulation strategy
+  void inc_vxc_mixed( size_t npts, size_t nbf, size_t nbe, const float* basis_eval,
+    const submat_map_t& submat_map, const double* Z, size_t ldz, 
+    HostSubmatAccumulator& VXC, float* scr );
+
 private: 
 
   pimpl_type pimpl_; ///< Implementation
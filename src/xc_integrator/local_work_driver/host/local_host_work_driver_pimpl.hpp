@@ -28,21 +28,27 @@ struct LocalHostWorkDriverPIMPL {
   // Public APIs
 
   virtual void partition_weights( XCWeightAlg weight_alg, const Molecule& mol, 
-    const MolMeta& meta, task_iterator task_begin, task_iterator task_end ) = 0;
+    const MolMeta& meta, task_iterator task_begin, task_iterator task_end,
+    bool vectorized ) = 0;
 
   virtual void eval_collocation( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
-    double* basis_eval ) = 0;
+    double* basis_eval, const uint64_t* shell_tile_mask ) = 0;
   virtual void eval_collocation_gradient( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
-    double* dbasis_z_eval) = 0;
+    double* dbasis_z_eval, const uint64_t* shell_tile_mask ) = 0;
   virtual void eval_collocation_hessian( size_t npts, size_t nshells, size_t nbe, 
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
     double* dbasis_z_eval, double* d2basis_xx_eval, double* d2basis_xy_eval,
     double* d2basis_xz_eval, double* d2basis_yy_eval, double* d2basis_yz_eval,
     double* d2basis_zz_eval ) = 0;
+  virtual void eval_collocation_laplacian( size_t npts, size_t nshells, size_t nbe, 
+    const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
+    double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
+    double* dbasis_z_eval, double* lbasis_eval, 
+    const uint64_t* shell_tile_mask ) = 0;
   virtual void eval_collocation_der3( size_t npts, size_t nshells, size_t nbe,
     const double* pts, const BasisSet<double>& basis, const int32_t* shell_list, 
     double* basis_eval, double* dbasis_x_eval, double* dbasis_y_eval, 
@@ -56,6 +62,18 @@ struct LocalHostWorkDriverPIMPL {
   virtual void eval_xmat( size_t npts, size_t nbf, size_t nbe, 
     const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
     const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) = 0;
+  virtual void eval_xmat_mixed( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
+    const float* basis_eval, size_t ldb, double* X, size_t ldx, float* scr ) = 0;
+  virtual void eval_xmat_batch( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, size_t ndm, double fac, 
+    const double* const* P, size_t ldp, const double* basis_eval, size_t ldb, 
+    double* X, size_t ldx, double* scr ) = 0;
+  virtual void eval_xmat_block_sparse( size_t npts, size_t nbf, size_t nbe, 
+    const submat_map_t& submat_map, size_t nshells, const int32_t* shell_list,
+    const BasisSetMap& basis_map, const double* shell_norms, size_t ldn, 
+    double tol, double fac, const double* P, size_t ldp, 
+    const double* basis_eval, size_t ldb, double* X, size_t ldx, double* scr ) = 0;
 
   virtual void eval_exx_fmat( size_t npts, size_t nbf, size_t nbe_bra,
     size_t nbe_ket, const submat_map_t& submat_map_bra,
@@ -72,8 +90,8 @@ struct LocalHostWorkDriverPIMPL {
 
   virtual void inc_exx_k( size_t npts, size_t nbf, size_t nbe_bra, size_t nbe_ket, 
     const double* basis_eval, const submat_map_t& submat_map_bra, 
-    const submat_map_t& submat_map_ket, const double* G, size_t ldg, double* K, 
-    size_t ldk, double* scr ) = 0;
+    const submat_map_t& submat_map_ket, const double* G, size_t ldg, 
+    HostSubmatAccumulator& K, double* scr ) = 0;
     
   virtual void eval_uvvar_lda_rks( size_t npts, size_t nbe, const double* basis_eval,
     const double* X, size_t ldx, double* den_eval) = 0;
@@ -168,7 +186,14 @@ struct LocalHostWorkDriverPIMPL {
 
   virtual void inc_vxc( size_t npts, size_t nbf, size_t nbe, 
     const double* basis_eval, const submat_map_t& submat_map, const double* Z, 
-    size_t ldz, double* VXC, size_t ldvxc, double* scr ) = 0;
+    size_t ldz, HostSubmatAccumulator& VXC, double* scr ) = 0;
+  virtual void inc_vxc_batch( size_t npts, size_t nbf, size_t nbe, 
+    const double* basis_eval, const submat_map_t& submat_map, size_t ndm,
+    const double* Z, size_t ldz, HostSubmatAccumulator* const* VXC, 
+    double* scr ) = 0;
+  virtual void inc_vxc_mixed( size_t npts, size_t nbf, size_t nbe, 
+    const float* basis_eval, const submat_map_t& submat_map, const double* Z, 
+    size_t ldz, HostSubmatAccumulator& VXC, float* scr ) = 0;
 
 };
 
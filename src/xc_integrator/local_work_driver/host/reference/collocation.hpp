@@ -75,4 +75,65 @@ void gau2grid_collocation_der3(    size_t                  npts,
 				   double*                 d3basis_yzz_eval,
 				   double*                 d3basis_zzz_eval);
 
+/**
+ *  GauXC native host collocation kernels. Unlike the gau2grid wrappers
+ *  above, these evaluate directly into the (nbe,npts) layout with no
+ *  intermediate storage or transpose.
+ *
+ *  If shell_tile_mask is non-null, it is interpreted as an
+ *  XCTask::shell_tile_mask for the (points,shell_mask) pair and negligible
+ *  (tile,shell) blocks are zeroed rather than evaluated.
+ */
+void host_collocation( size_t                  npts,
+                       size_t                  nshells,
+                       size_t                  nbe,
+                       const double*           points,
+                       const BasisSet<double>& basis,
+                       const int32_t*          shell_mask,
+                       double*                 basis_eval,
+                       const uint64_t*         shell_tile_mask = nullptr );
+
+void host_collocation_gradient( size_t                  npts,
+                                size_t                  nshells,
+                                size_t                  nbe,
+                                const double*           points,
+                                const BasisSet<double>& basis,
+                                const int32_t*          shell_mask,
+                                double*                 basis_eval,
+                                double*                 dbasis_x_eval,
+                                double*                 dbasis_y_eval,
+                                double*                 dbasis_z_eval,
+                                const uint64_t*         shell_tile_mask = nullptr );
+
+void host_collocation_hessian( size_t                  npts,
+                               size_t                  nshells,
+                               size_t                  nbe,
+                               const double*           points,
+                               const BasisSet<double>& basis,
+                               const int32_t*          shell_mask,
+                               double*                 basis_eval,
+                               double*                 dbasis_x_eval,
+                               double*                 dbasis_y_eval,
+                               double*                 dbasis_z_eval,
+                               double*                 d2basis_xx_eval,
+                               double*                 d2basis_xy_eval,
+                               double*                 d2basis_xz_eval,
+                               double*                 d2basis_yy_eval,
+                               double*                 d2basis_yz_eval,
+                               double*                 d2basis_zz_eval,
+                               const uint64_t*         shell_tile_mask = nullptr );
+
+void host_collocation_laplacian( size_t                  npts,
+                                 size_t                  nshells,
+                                 size_t                  nbe,
+                                 const double*           points,
+                                 const BasisSet<double>& basis,
+                                 const int32_t*          shell_mask,
+                                 double*                 basis_eval,
+                                 double*                 dbasis_x_eval,
+                                 double*                 dbasis_y_eval,
+                                 double*                 dbasis_z_eval,
+                                 double*                 lbasis_eval,
+                                 const uint64_t*         shell_tile_mask = nullptr );
+
     }
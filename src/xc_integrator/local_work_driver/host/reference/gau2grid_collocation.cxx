@@ -6,6 +6,7 @@
  * See LICENSE.txt for details
  */
 #include "collocation.hpp"
+#include "host/host_scratch_arena.hpp"
 
 
 #ifdef GAUXC_HAS_GAU2GRID
@@ -28,8 +29,8 @@ void gau2grid_collocation( size_t                  npts,
 
 #ifdef GAUXC_HAS_GAU2GRID
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( npts * nbe );
+  HostScratchScope scratch( thread_scratch_arena() );
+  auto* rv = scratch.allocate<double>( npts * nbe );
 
   size_t ncomp = 0;
   for( size_t i = 0; i < nshells; ++i ) {
@@ -44,7 +45,6 @@ void gau2grid_collocation( size_t                  npts,
   }
 
   gg_fast_transpose( ncomp, npts, rv, basis_eval );
-  a.deallocate( rv, npts*nbe );
 
 #else
   
@@ -85,8 +85,8 @@ void gau2grid_collocation_gradient( size_t                  npts,
 
 #ifdef GAUXC_HAS_GAU2GRID
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 4 * npts * nbe );
+  HostScratchScope scratch( thread_scratch_arena() );
+  auto* rv = scratch.allocate<double>( 4 * npts * nbe );
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -109,7 +109,6 @@ void gau2grid_collocation_gradient( size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_y, dbasis_y_eval );
   gg_fast_transpose( ncomp, npts, rv_z, dbasis_z_eval );
 
-  a.deallocate( rv, 4*npts*nbe );
 
 #else 
 
@@ -159,8 +158,8 @@ void gau2grid_collocation_hessian( size_t                  npts,
                                    double*                 d2basis_yz_eval,
                                    double*                 d2basis_zz_eval) {
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 10 * npts * nbe );
+  HostScratchScope scratch( thread_scratch_arena() );
+  auto* rv = scratch.allocate<double>( 10 * npts * nbe );
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -198,7 +197,6 @@ void gau2grid_collocation_hessian( size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_yz, d2basis_yz_eval );
   gg_fast_transpose( ncomp, npts, rv_zz, d2basis_zz_eval );
 
-  a.deallocate( rv, 10*npts*nbe );
 
 }
 
@@ -230,8 +228,8 @@ void gau2grid_collocation_der3(    size_t                  npts,
                                    double*                 d3basis_yzz_eval,
                                    double*                 d3basis_zzz_eval) {
 
-  std::allocator<double> a;
-  auto* rv = a.allocate( 20 * npts * nbe );
+  HostScratchScope scratch( thread_scratch_arena() );
+  auto* rv = scratch.allocate<double>( 20 * npts * nbe );
   auto* rv_x = rv   + npts * nbe;
   auto* rv_y = rv_x + npts * nbe;
   auto* rv_z = rv_y + npts * nbe;
@@ -292,7 +290,6 @@ void gau2grid_collocation_der3(    size_t                  npts,
   gg_fast_transpose( ncomp, npts, rv_yzz, d3basis_yzz_eval );
   gg_fast_transpose( ncomp, npts, rv_zzz, d3basis_zzz_eval );
 
-  a.deallocate( rv, 20*npts*nbe );
 
 }
 
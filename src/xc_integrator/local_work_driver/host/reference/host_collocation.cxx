@@ -0,0 +1,382 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "collocation.hpp"
+#include <gauxc/exceptions.hpp>
+#include <gauxc/gauxc_config.hpp>
+#include <gauxc/xc_task.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace GauXC {
+
+namespace detail {
+
+// Number of points processed per block. The radial parts of a shell are
+// stored over a block of points in (stack) scratch, the block is small
+// enough for the scratch to remain in L1. N.B. the radial loops are plain
+// loops over the block, exp() is only vectorized where the compiler / math
+// library provide vector variants (e.g. glibc libmvec with -ffast-math)
+constexpr size_t host_collocation_block = 64;
+
+constexpr int    host_collocation_max_l    = GAUXC_CPU_XC_MAX_AM;
+constexpr size_t host_collocation_max_ncart =
+  (host_collocation_max_l+1)*(host_collocation_max_l+2)/2;
+
+inline constexpr size_t ncart( int l ) { return (l+1)*(l+2)/2; }
+
+/**
+ *  Cartesian -> (unnormalized) real solid harmonic transformation for
+ *  angular momentum L. Row m (m = -L,...,L) is stored contiguously over the
+ *  CCA ordered cartesian components. This matches the normalization used
+ *  by gau2grid (GG_SPHERICAL_CCA) and the device collocation kernels.
+ */
+inline std::vector<double> generate_cart_to_sph( int l ) {
+
+  auto fact = [](int n) {
+    double f = 1.; for( int i = 2; i <= n; ++i ) f *= i; return f;
+  };
+  auto binom = [&](int n, int k) {
+    return (k < 0 or k > n) ? 0. : fact(n) / (fact(k) * fact(n-k));
+  };
+
+  // CCA index of (lx,ly,lz)
+  auto cart_idx = [l](int lx, int ly) {
+    const int i = l - lx;
+    return i*(i+1)/2 + (i - ly);
+  };
+
+  const int nc = ncart(l);
+  std::vector<double> T( (2*l+1) * nc, 0. );
+  for( int m = -l; m <= l; ++m ) {
+    const int am = std::abs(m);
+    const double N = std::sqrt( 2. * fact(l+am) * fact(l-am) / (m==0 ? 2. : 1.) ) /
+      ( std::pow(2., am) * fact(l) );
+
+    auto* T_m = T.data() + (m+l)*nc;
+    const int vm = m < 0; // 2*v_m
+    for( int t = 0; t <= (l-am)/2; ++t )
+    for( int u = 0; u <= t;        ++u )
+    for( int k = vm; k <= am;      k += 2 ) { // k = 2*v
+      const double sign = ((t + (k-vm)/2) % 2) ? -1. : 1.;
+      const double c = sign * std::pow(0.25, t) * binom(l,t) * binom(l-t, am+t) *
+        binom(t,u) * binom(am,k);
+      const int lx = 2*t + am - 2*u - k;
+      const int ly = 2*u + k;
+      T_m[ cart_idx(lx,ly) ] += N * c;
+    }
+  }
+
+  return T;
+}
+
+inline const double* cart_to_sph( int l ) {
+  static const auto tables = [](){
+    std::array<std::vector<double>, host_collocation_max_l+1> t;
+    for( int i = 0; i <= host_collocation_max_l; ++i )
+      t[i] = generate_cart_to_sph(i);
+    return t;
+  }();
+  return tables[l].data();
+}
+
+/**
+ *  Evaluate the collocation matrix (and optionally its derivatives) of a
+ *  set of shells directly into the column-major (nbe,npts) layout consumed
+ *  by eval_xmat / inc_vxc.
+ *
+ *  Points are processed in blocks: the radial part (and its derivative
+ *  factors) of each shell is evaluated over the block, the angular part is
+ *  then expanded point-by-point s.t. each shell writes a contiguous segment
+ *  of a basis_eval column. No temporaries are allocated and no transpose is
+ *  required, i.e. this differs from gau2grid in the memory layout / traffic
+ *  and not in the arithmetic.
+ *
+ *  Deriv = 0 : value
+ *  Deriv = 1 : value + gradient
+ *  Deriv = 2 : value + gradient + hessian (xx,xy,xz,yy,yz,zz)
+ *  Deriv = 3 : value + gradient + laplacian (fused, no hessian storage)
+ *
+ *  If tile_mask is provided (see XCTask::shell_tile_mask), only the
+ *  significant (tile,shell) blocks are evaluated, all others are set to
+ *  zero.
+ */
+template <int Deriv>
+void host_collocation_impl( size_t npts, size_t nshells, size_t nbe,
+  const double* points, const BasisSet<double>& basis,
+  const int32_t* shell_list, const uint64_t* tile_mask,
+  std::array<double*, 10> eval ) {
+
+  constexpr size_t nblk = host_collocation_block;
+  constexpr int    neval = Deriv == 0 ? 1 : (Deriv == 1 ? 4 : 
+                           (Deriv == 2 ? 10 : 5));
+
+  // Radial scratch (stack resident)
+  alignas(64) double x_blk [nblk];
+  alignas(64) double y_blk [nblk];
+  alignas(64) double z_blk [nblk];
+  alignas(64) double r0_blk[nblk];
+  alignas(64) double r1_blk[nblk];
+  alignas(64) double r2_blk[nblk];
+
+  // Cartesian scratch for spherical transformation
+  double cart[neval][host_collocation_max_ncart];
+
+  constexpr size_t ntile = XCTask::shell_tile_size;
+  const size_t mask_stride = (nshells + 63) / 64;
+  auto significant = [&]( size_t ipt, size_t ish ) {
+    return (tile_mask[(ipt/ntile)*mask_stride + ish/64] >> (ish%64)) & 1;
+  };
+
+  for( size_t ipt_st = 0; ipt_st < npts; ipt_st += nblk ) {
+
+    const size_t npts_blk = std::min( nblk, npts - ipt_st );
+    const double* pts_blk = points + 3*ipt_st;
+
+    size_t ioff = 0;
+    for( size_t i = 0; i < nshells; ++i ) {
+
+      const auto& sh   = basis.at(shell_list[i]);
+      const int    l     = sh.l();
+      const bool   pure  = sh.pure();
+      const size_t shsz  = sh.size();
+      const auto   nprim = sh.nprim();
+      const auto*  O     = sh.O_data();
+      const auto*  alpha = sh.alpha_data();
+      const auto*  coeff = sh.coeff_data();
+
+      if( l > host_collocation_max_l )
+        GAUXC_GENERIC_EXCEPTION("Host Collocation: L > MAX_L");
+
+      // Restrict the radial evaluation to the span of significant tiles
+      size_t p_lo = 0, p_hi = npts_blk;
+      if( tile_mask ) {
+        p_lo = npts_blk; p_hi = 0;
+        for( size_t p = 0; p < npts_blk; p += ntile - (ipt_st + p) % ntile )
+        if( significant(ipt_st + p, i) ) {
+          p_lo = std::min( p_lo, p );
+          p_hi = std::min( npts_blk, p + ntile - (ipt_st + p) % ntile );
+        }
+      }
+
+      // Radial part over the block
+      #pragma omp simd
+      for( size_t p = p_lo; p < p_hi; ++p ) {
+        x_blk[p] = pts_blk[3*p + 0] - O[0];
+        y_blk[p] = pts_blk[3*p + 1] - O[1];
+        z_blk[p] = pts_blk[3*p + 2] - O[2];
+        r0_blk[p] = 0.; r1_blk[p] = 0.; r2_blk[p] = 0.;
+      }
+
+      for( int32_t k = 0; k < nprim; ++k ) {
+        const double a = alpha[k];
+        const double c = coeff[k];
+        #pragma omp simd
+        for( size_t p = p_lo; p < p_hi; ++p ) {
+          const double rsq = x_blk[p]*x_blk[p] + y_blk[p]*y_blk[p] +
+                             z_blk[p]*z_blk[p];
+          const double e = c * std::exp( -a * rsq );
+          r0_blk[p] += e;
+          if constexpr (Deriv > 0) r1_blk[p] += a * e;
+          if constexpr (Deriv > 1) r2_blk[p] += a * a * e;
+        }
+      }
+
+      if constexpr (Deriv > 0) {
+        #pragma omp simd
+        for( size_t p = p_lo; p < p_hi; ++p ) {
+          r1_blk[p] *= -2.;
+          if constexpr (Deriv > 1) r2_blk[p] *= 4.;
+        }
+      }
+
+      const int  nc = ncart(l);
+      const auto* T = pure ? cart_to_sph(l) : nullptr;
+
+      // Angular part, point by point
+      for( size_t p = 0; p < npts_blk; ++p ) {
+
+        const size_t col = (ipt_st + p)*nbe + ioff;
+
+        // Negligible (tile,shell) block
+        if( tile_mask and (p < p_lo or p >= p_hi or not significant(ipt_st+p, i)) ) {
+          for( int ie = 0; ie < neval; ++ie )
+            std::fill_n( eval[ie] + col, shsz, 0. );
+          continue;
+        }
+
+        const double x = x_blk[p], y = y_blk[p], z = z_blk[p];
+        const double R0 = r0_blk[p], R1 = r1_blk[p], R2 = r2_blk[p];
+
+        // Powers with two leading zeros s.t. pw[j+2] = x**j and
+        // pw[1] = pw[0] = 0 absorbs the negative powers arising in
+        // the derivatives of the monomials
+        double xp[host_collocation_max_l+3], yp[host_collocation_max_l+3],
+               zp[host_collocation_max_l+3];
+        xp[0] = xp[1] = yp[0] = yp[1] = zp[0] = zp[1] = 0.;
+        xp[2] = yp[2] = zp[2] = 1.;
+        for( int j = 1; j <= l; ++j ) {
+          xp[j+2] = xp[j+1] * x;
+          yp[j+2] = yp[j+1] * y;
+          zp[j+2] = zp[j+1] * z;
+        }
+
+        // Cartesian output is written in place, spherical is staged
+        auto store = [&](int ie, int ic, double v) {
+          if( pure ) cart[ie][ic] = v;
+          else       eval[ie][col + ic] = v;
+        };
+
+        int ic = 0;
+        for( int ii = 0; ii <= l; ++ii ) {
+          const int lx = l - ii;
+        for( int jj = 0; jj <= ii; ++jj, ++ic ) {
+          const int ly = ii - jj;
+          const int lz = jj;
+
+          const double X = xp[lx+2], Y = yp[ly+2], Z = zp[lz+2];
+          const double M = X*Y*Z;
+          store(0, ic, M * R0);
+
+          if constexpr (Deriv > 0) {
+            const double Xm = lx * xp[lx+1], Ym = ly * yp[ly+1], Zm = lz * zp[lz+1];
+            const double Mx = Xm*Y*Z, My = X*Ym*Z, Mz = X*Y*Zm;
+
+            store(1, ic, Mx * R0 + M * R1 * x);
+            store(2, ic, My * R0 + M * R1 * y);
+            store(3, ic, Mz * R0 + M * R1 * z);
+
+            if constexpr (Deriv == 3) {
+              // Lapl = R0 * Lapl(M) + M * ( (2L+3) R1 + R2 r**2 ) as 
+              // x * dM/dx + y * dM/dy + z * dM/dz = L * M
+              const double lap_M = lx*(lx-1) * xp[lx] * Y * Z +
+                                   ly*(ly-1) * X * yp[ly] * Z +
+                                   lz*(lz-1) * X * Y * zp[lz];
+              const double rsq = x*x + y*y + z*z;
+              store(4, ic, lap_M*R0 + M*((2*l+3)*R1 + R2*rsq));
+            }
+
+            if constexpr (Deriv == 2) {
+              const double Mxx = lx*(lx-1) * xp[lx] * Y * Z;
+              const double Myy = ly*(ly-1) * X * yp[ly] * Z;
+              const double Mzz = lz*(lz-1) * X * Y * zp[lz];
+              const double Mxy = Xm*Ym*Z, Mxz = Xm*Y*Zm, Myz = X*Ym*Zm;
+
+              store(4, ic, Mxx*R0 + 2.*Mx*R1*x + M*(R1 + R2*x*x));
+              store(5, ic, Mxy*R0 + (Mx*y + My*x)*R1 + M*R2*x*y);
+              store(6, ic, Mxz*R0 + (Mx*z + Mz*x)*R1 + M*R2*x*z);
+              store(7, ic, Myy*R0 + 2.*My*R1*y + M*(R1 + R2*y*y));
+              store(8, ic, Myz*R0 + (My*z + Mz*y)*R1 + M*R2*y*z);
+              store(9, ic, Mzz*R0 + 2.*Mz*R1*z + M*(R1 + R2*z*z));
+            }
+          }
+
+        } // ly
+        } // lx
+
+        if( pure ) {
+          for( int ie = 0; ie < neval; ++ie ) {
+            auto* out = eval[ie] + col;
+            for( size_t m = 0; m < shsz; ++m ) {
+              const auto* T_m = T + m*nc;
+              double v = 0.;
+              for( int c = 0; c < nc; ++c ) v += T_m[c] * cart[ie][c];
+              out[m] = v;
+            }
+          }
+        }
+
+      } // Loop over points in block
+
+      ioff += shsz;
+    } // Loop over shells
+
+  } // Loop over point blocks
+
+}
+
+}
+
+void host_collocation( size_t                  npts,
+                       size_t                  nshells,
+                       size_t                  nbe,
+                       const double*           points,
+                       const BasisSet<double>& basis,
+                       const int32_t*          shell_mask,
+                       double*                 basis_eval,
+                       const uint64_t*          shell_tile_mask ) {
+
+  detail::host_collocation_impl<0>( npts, nshells, nbe, points, basis,
+    shell_mask, shell_tile_mask, {basis_eval} );
+
+}
+
+void host_collocation_gradient( size_t                  npts,
+                                size_t                  nshells,
+                                size_t                  nbe,
+                                const double*           points,
+                                const BasisSet<double>& basis,
+                                const int32_t*          shell_mask,
+                                double*                 basis_eval,
+                                double*                 dbasis_x_eval,
+                                double*                 dbasis_y_eval,
+                                double*                 dbasis_z_eval,
+                                const uint64_t*          shell_tile_mask ) {
+
+  detail::host_collocation_impl<1>( npts, nshells, nbe, points, basis,
+    shell_mask, shell_tile_mask, {basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval} );
+
+}
+
+void host_collocation_hessian( size_t                  npts,
+                               size_t                  nshells,
+                               size_t                  nbe,
+                               const double*           points,
+                               const BasisSet<double>& basis,
+                               const int32_t*          shell_mask,
+                               double*                 basis_eval,
+                               double*                 dbasis_x_eval,
+                               double*                 dbasis_y_eval,
+                               double*                 dbasis_z_eval,
+                               double*                 d2basis_xx_eval,
+                               double*                 d2basis_xy_eval,
+                               double*                 d2basis_xz_eval,
+                               double*                 d2basis_yy_eval,
+                               double*                 d2basis_yz_eval,
+                               double*                 d2basis_zz_eval,
+                               const uint64_t*          shell_tile_mask ) {
+
+  detail::host_collocation_impl<2>( npts, nshells, nbe, points, basis,
+    shell_mask, shell_tile_mask, {basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+    d2basis_xx_eval, d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval,
+    d2basis_yz_eval, d2basis_zz_eval} );
+
+}
+
+void host_collocation_laplacian( size_t                  npts,
+                                 size_t                  nshells,
+                                 size_t                  nbe,
+                                 const double*           points,
+                                 const BasisSet<double>& basis,
+                                 const int32_t*          shell_mask,
+                                 double*                 basis_eval,
+                                 double*                 dbasis_x_eval,
+                                 double*                 dbasis_y_eval,
+                                 double*                 dbasis_z_eval,
+                                 double*                 lbasis_eval,
+                                 const uint64_t*          shell_tile_mask ) {
+
+  detail::host_collocation_impl<3>( npts, nshells, nbe, points, basis,
+    shell_mask, shell_tile_mask, {basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+    lbasis_eval} );
+
+}
+
+}
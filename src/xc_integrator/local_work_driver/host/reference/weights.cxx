@@ -6,9 +6,14 @@
  * See LICENSE.txt for details
  */
 #include "host/reference/weights.hpp"
+#include "host/reference/weights_common.hpp"
 #include "common/integrator_constants.hpp"
 
 #include <gauxc/molgrid/defaults.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
 
 namespace GauXC {
 
@@ -115,96 +120,154 @@ void reference_ssf_weights_host(
   task_iterator          task_end
 ) {
 
-  auto gFrisch = [&](double x) {
-    const double s_x  = x / integrator::magic_ssf_factor<>;
-    const double s_x2 = s_x  * s_x;
-    const double s_x3 = s_x  * s_x2;
-    const double s_x5 = s_x3 * s_x2;
-    const double s_x7 = s_x5 * s_x2;
-
-    return (35.*(s_x - s_x3) + 21.*s_x5 - 5.*s_x7) / 16.;
-  };
+  using detail::ssf_c;
+  using detail::ssf_g;
 
   const size_t ntasks = std::distance(task_begin,task_end);
   const size_t natoms = mol.natoms();
 
   const auto&  RAB    = meta.rab();
 
+  // The partition weights of each task are only evaluated over the atoms
+  // which may contribute at any of its points (see detail::ssf_task_atoms).
+  // The cell functions of each point are only evaluated for atoms with
+  // mu_AN < a w.r.t. the nearest atom N (and the parent), as products over
+  // the atoms of the task list. Points at which the result depends on the
+  // ssf_weight_tol screening of the pairwise loop fall back to it (over the
+  // neighbors of the point).
+  const detail::AtomCellList atom_cells( mol );
+
   #pragma omp parallel 
   {
 
   std::vector<double> partitionScratch( natoms );
   std::vector<double> atomDist( natoms );
+  std::vector<size_t> task_atoms;   task_atoms.reserve( natoms );
+  std::vector<size_t> cell_atoms;   cell_atoms.reserve( natoms );
 
-  #pragma omp for
-  for( size_t iT = 0; iT < ntasks;                  ++iT )
-  for( size_t i  = 0; i  < (task_begin+iT)->points.size(); ++i  ) {
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
 
-    auto&       task   = *(task_begin+iT);
-    auto&       weight = task.weights[i];
-    const auto& point  = task.points[i];
+    auto&        task   = *(task_begin+iT);
+    const size_t npts   = task.points.size();
+    const size_t parent = task.iParent;
+    if( !npts ) continue;
 
     const auto dist_cutoff = 0.5 * (1-integrator::magic_ssf_factor<>) * task.dist_nearest;
 
+    // Task inside of the SSF cutoff sphere, partition weights = 1
+    if( not detail::ssf_task_atoms( mol, meta, atom_cells, task, task_atoms,
+      cell_atoms, atomDist ) ) continue;
+
+  for( size_t i  = 0; i  < npts; ++i  ) {
+
+    auto&       weight = task.weights[i];
+    const auto& point  = task.points[i];
+
     // Compute dist to parent atom
     {
-      const double da_x = point[0] - mol[task.iParent].x;
-      const double da_y = point[1] - mol[task.iParent].y;
-      const double da_z = point[2] - mol[task.iParent].z;
+      const double da_x = point[0] - mol[parent].x;
+      const double da_y = point[1] - mol[parent].y;
+      const double da_z = point[2] - mol[parent].z;
 
-      atomDist[task.iParent] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
+      atomDist[parent] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
     }
 
-    if( atomDist[task.iParent] < dist_cutoff ) continue; // Partition weight = 1
+    if( atomDist[parent] < dist_cutoff ) continue; // Partition weight = 1
 
     // Compute distances of each center to point
-    for(size_t iA = 0; iA < natoms; iA++) {
+    size_t iNearest = parent;
+    for( auto iA : task_atoms ) {
 
-      if( iA == (size_t)task.iParent ) continue;
+      if( iA == parent ) continue;
 
       const double da_x = point[0] - mol[iA].x;
       const double da_y = point[1] - mol[iA].y;
       const double da_z = point[2] - mol[iA].z;
 
       atomDist[iA] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
+      if( atomDist[iA] < atomDist[iNearest] ) iNearest = iA;
 
     }
 
-    // Evaluate unnormalized partition functions 
-    std::fill(partitionScratch.begin(),partitionScratch.end(),1.);
-    for( size_t iA = 0; iA < natoms; iA++ ) 
-    for( size_t jA = 0; jA < iA;     jA++ )
-    if( partitionScratch[iA] > integrator::ssf_weight_tol or 
-        partitionScratch[jA] > integrator::ssf_weight_tol ) {
-
-      const double mu = (atomDist[iA] - atomDist[jA]) / RAB[jA + iA*natoms];
-
-      if( mu <= -integrator::magic_ssf_factor<> ) {
-
-        partitionScratch[jA] = 0.;
-
-      } else if (mu >= integrator::magic_ssf_factor<>) {
+    // Atoms with a non-zero cell function
+    cell_atoms.clear();
+    for( auto iA : task_atoms ) 
+    if( iA == parent or iA == iNearest or 
+        (atomDist[iA] - atomDist[iNearest]) / RAB[iNearest + iA*natoms] < 
+        integrator::magic_ssf_factor<> ) 
+      cell_atoms.emplace_back( iA );
+
+    // Unnormalized partition function of A, P_A = prod_B s(mu_AB). The
+    // factors are applied in the order of the pairwise loop. Once P_A
+    // drops below ssf_weight_tol, the pairwise loop only applies factors of
+    // atoms B with P_B > ssf_weight_tol. If this may not be decided (P_B has
+    // not been evaluated), -1 is returned unless P_A vanishes regardless.
+    auto cell_function = [&]( size_t iA, bool screen ) {
+
+      const double r_A     = atomDist[iA];
+      const double r_B_max = ssf_c * r_A;
+
+      double P_A = 1.;
+      bool undetermined = false;
+      for( auto iB : task_atoms ) {
+
+        if( iB == iA or atomDist[iB] >= r_B_max ) continue; // s(mu_AB) = 1
+
+        double g;
+        if( iB < iA ) {
+          const double mu = (r_A - atomDist[iB]) / RAB[iB + iA*natoms];
+          if( mu <= -integrator::magic_ssf_factor<> ) continue;
+          g = mu >= integrator::magic_ssf_factor<> ? 0. : 
+              0.5 * ( 1. - ssf_g(mu) );
+        } else {
+          const double mu = (atomDist[iB] - r_A) / RAB[iA + iB*natoms];
+          if( mu >= integrator::magic_ssf_factor<> ) continue;
+          g = mu <= -integrator::magic_ssf_factor<> ? 0. :
+              1. - 0.5 * ( 1. - ssf_g(mu) );
+        }
+
+        const bool B_above_tol = partitionScratch[iB] > integrator::ssf_weight_tol;
+        if( undetermined ) {
+          if( g == 0. and B_above_tol ) return 0.; // Always evaluated
+          continue;
+        }
+        if( screen and P_A <= integrator::ssf_weight_tol and not B_above_tol ) {
+          undetermined = true;
+          continue;
+        }
+
+        if( g == 0. ) return 0.;
+        P_A *= g;
 
-        partitionScratch[iA] = 0.;
+      }
 
-      } else {
+      return undetermined ? -1. : P_A;
 
-        double g = 0.5 * ( 1. - gFrisch(mu) );
-        partitionScratch[iA] *= g;
-        partitionScratch[jA] *= 1. - g;
+    };
 
-      }
+    // Evaluate unnormalized partition functions, the parent last
+    for( auto iA : task_atoms ) partitionScratch[iA] = 0.;
+    for( auto iA : cell_atoms ) 
+    if( iA != parent ) partitionScratch[iA] = cell_function( iA, false );
+    partitionScratch[parent] = cell_function( parent, true );
 
+    // Sub-tolerance cell function of the parent
+    if( partitionScratch[parent] < 0. ) {
+      weight *= detail::ssf_pairwise_weight( meta, parent, task_atoms, 
+        cell_atoms, atomDist.data(), partitionScratch.data() );
+      continue;
     }
 
     // Normalization
     double sum = 0.;
-    for( size_t iA = 0; iA < natoms; iA++ )  sum += partitionScratch[iA];
+    for( auto iA : cell_atoms ) sum += partitionScratch[iA];
 
     // Update Weights
-    weight *= partitionScratch[task.iParent] / sum;
+    weight *= partitionScratch[parent] / sum;
 
-  } // Collapsed loop over tasks and points
+  } // Loop over points
+  } // Loop over tasks
 
   } // OMP context
 
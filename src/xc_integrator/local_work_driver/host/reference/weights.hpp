@@ -32,4 +32,27 @@ void reference_lko_weights_host(
   task_iterator          task_end
 );
 
+// Point vectorized (SoA) variants of the above, each processes blocks of
+// points of a task as SIMD lanes
+void soa_ssf_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
+void soa_becke_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
+void soa_lko_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+);
+
 }
@@ -0,0 +1,300 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "common/integrator_constants.hpp"
+#include <gauxc/molecule.hpp>
+#include <gauxc/molmeta.hpp>
+#include <gauxc/xc_task.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace GauXC::detail {
+
+/// Becke partition function (f_3)
+inline double becke_g( double x ) {
+  auto h = [](double x) {return 1.5 * x - 0.5 * x * x * x;}; // Eq. 19
+  return h(h(h(x))); // Eq. 20
+}
+
+/// SSF partition function (|x| < a)
+inline double ssf_g( double x ) {
+  const double s_x  = x / integrator::magic_ssf_factor<>;
+  const double s_x2 = s_x  * s_x;
+  const double s_x3 = s_x  * s_x2;
+  const double s_x5 = s_x3 * s_x2;
+  const double s_x7 = s_x5 * s_x2;
+
+  return (35.*(s_x - s_x3) + 21.*s_x5 - 5.*s_x7) / 16.;
+}
+
+/// c = (1+a)/(1-a): s(mu_AB) = 1 for r_B >= c * r_A (SSF)
+inline constexpr double ssf_c = (1. + integrator::magic_ssf_factor<>) /
+                                (1. - integrator::magic_ssf_factor<>);
+
+/// Axis aligned bounding box of the points of a task
+struct TaskBoundingBox {
+
+  std::array<double,3> lo, hi;
+
+  TaskBoundingBox( const XCTask& task ) :
+    lo(task.points.at(0)), hi(task.points.at(0)) {
+    for( const auto& point : task.points )
+    for( int k = 0; k < 3; ++k ) {
+      lo[k] = std::min( lo[k], point[k] );
+      hi[k] = std::max( hi[k], point[k] );
+    }
+  }
+
+  /// Smallest distance of any point in the box to an atom
+  double min_dist( const Atom& atom ) const {
+    const std::array<double,3> r = { atom.x, atom.y, atom.z };
+    double d2 = 0.;
+    for( int k = 0; k < 3; ++k ) {
+      const double d = std::max( {lo[k] - r[k], r[k] - hi[k], 0.} );
+      d2 += d*d;
+    }
+    return std::sqrt(d2);
+  }
+
+  /// Largest distance of any point in the box to an atom
+  double max_dist( const Atom& atom ) const {
+    const std::array<double,3> r = { atom.x, atom.y, atom.z };
+    double d2 = 0.;
+    for( int k = 0; k < 3; ++k ) {
+      const double d = std::max( std::abs(r[k] - lo[k]),
+                                 std::abs(hi[k] - r[k]) );
+      d2 += d*d;
+    }
+    return std::sqrt(d2);
+  }
+
+};
+
+/**
+ *  Uniform grid of cells over the atoms of a molecule. Queries visit the
+ *  atoms of the cells overlapping a bounding box grown by a distance, i.e.
+ *  a superset of the atoms within that distance of the box, without a pass
+ *  over all atoms.
+ */
+class AtomCellList {
+
+  std::array<double,3>  lo_;
+  std::array<int64_t,3> dims_ = {1, 1, 1};
+  double                h_    = 1.;
+
+  std::vector<size_t> cell_start_; ///< Atoms of cell i: [cell_start_[i], cell_start_[i+1])
+  std::vector<size_t> atoms_;      ///< Atom indices ordered by cell
+
+  int64_t cell_coord( double x, int k ) const {
+    const double c = std::floor( (x - lo_[k]) / h_ );
+    return std::clamp( c, 0., double(dims_[k] - 1) );
+  }
+
+  int64_t cell_index( const Atom& atom ) const {
+    return cell_coord( atom.x, 0 ) + dims_[0] * ( cell_coord( atom.y, 1 ) + 
+      dims_[1] * cell_coord( atom.z, 2 ) );
+  }
+
+public:
+
+  /// Cells of about one atom per unit of volume of the (padded) molecule
+  explicit AtomCellList( const Molecule& mol ) {
+
+    const size_t natoms = mol.natoms();
+    if( not natoms ) { cell_start_ = {0, 0}; return; }
+
+    std::array<double,3> hi;
+    lo_ = hi = { mol[0].x, mol[0].y, mol[0].z };
+    for( const auto& atom : mol ) {
+      const std::array<double,3> r = { atom.x, atom.y, atom.z };
+      for( int k = 0; k < 3; ++k ) {
+        lo_[k] = std::min( lo_[k], r[k] );
+        hi [k] = std::max( hi [k], r[k] );
+      }
+    }
+
+    double vol = 1.;
+    for( int k = 0; k < 3; ++k ) vol *= hi[k] - lo_[k] + 1.;
+    h_ = std::cbrt( vol / natoms );
+    for( int k = 0; k < 3; ++k ) 
+      dims_[k] = int64_t( (hi[k] - lo_[k]) / h_ ) + 1;
+
+    // Counting sort of the atoms on their cells
+    const size_t ncells = dims_[0] * dims_[1] * dims_[2];
+    cell_start_.assign( ncells + 1, 0 );
+    for( const auto& atom : mol ) cell_start_[ cell_index(atom) + 1 ]++;
+    for( size_t i = 0; i < ncells; ++i ) cell_start_[i+1] += cell_start_[i];
+
+    atoms_.resize( natoms );
+    auto fill = cell_start_;
+    for( size_t iA = 0; iA < natoms; ++iA ) 
+      atoms_[ fill[ cell_index(mol[iA]) ]++ ] = iA;
+
+  }
+
+  /// Visit the atoms of the cells which overlap [lo - r, hi + r]
+  template <typename Op>
+  void for_each( const std::array<double,3>& lo, const std::array<double,3>& hi,
+    double r, Op&& op ) const {
+
+    std::array<int64_t,3> c_lo, c_hi;
+    for( int k = 0; k < 3; ++k ) {
+      c_lo[k] = cell_coord( lo[k] - r, k );
+      c_hi[k] = cell_coord( hi[k] + r, k );
+    }
+
+    for( int64_t z = c_lo[2]; z <= c_hi[2]; ++z )
+    for( int64_t y = c_lo[1]; y <= c_hi[1]; ++y ) {
+      const int64_t row = dims_[0] * (y + dims_[1] * z);
+      for( auto i = cell_start_[row + c_lo[0]]; 
+               i < cell_start_[row + c_hi[0] + 1]; ++i ) op( atoms_[i] );
+    }
+
+  }
+
+};
+
+/**
+ *  Atoms which may contribute to the SSF partition weights of a task
+ *  (ascending order, always containing the parent and the cell atoms).
+ *
+ *  The cell function of A vanishes unless mu_AN < a w.r.t. the nearest atom
+ *  N, which implies r_A < c * r_N. For the points of a task, r_N is bounded
+ *  by the largest distance of the task bounding box to any atom. Atoms B
+ *  contribute if r_B - r_A < a * R_AB for any of these A.
+ *
+ *  Each criterion bounds the distance of the atoms to the bounding box,
+ *  the candidates are queried from atom_cells (built once per molecule).
+ *  As R_AB <= r_A + r_B, the atoms B lie within c * max_A r_A of the box.
+ *
+ *  @returns false if the task lies inside the SSF cutoff sphere of its
+ *  parent (i.e. all partition weights are 1)
+ */
+inline bool ssf_task_atoms( const Molecule& mol, const MolMeta& meta,
+  const AtomCellList& atom_cells, const XCTask& task, 
+  std::vector<size_t>& task_atoms, std::vector<size_t>& scratch_atoms, 
+  std::vector<double>& scratch_dist ) {
+
+  const size_t natoms = mol.natoms();
+  const size_t parent = task.iParent;
+  const auto&  RAB    = meta.rab();
+
+  const TaskBoundingBox box( task );
+  const auto dist_cutoff =
+    0.5 * (1-integrator::magic_ssf_factor<>) * task.dist_nearest;
+  const double r_parent = box.max_dist( mol[parent] );
+  if( r_parent < dist_cutoff ) return false;
+
+  // Only atoms within r_parent of the box may be nearer than the parent
+  double r_nearest_max = r_parent;
+  atom_cells.for_each( box.lo, box.hi, r_parent, [&]( size_t iA ) {
+    r_nearest_max = std::min( r_nearest_max, box.max_dist( mol[iA] ) );
+  });
+
+  // Atoms which may have a non-zero cell function at any point of the task
+  const double r_cell = ssf_c * r_nearest_max;
+  double r_cell_max = 0.;
+  scratch_atoms.clear();
+  atom_cells.for_each( box.lo, box.hi, r_cell, [&]( size_t iA ) {
+    if( box.min_dist( mol[iA] ) < r_cell ) {
+      scratch_atoms.emplace_back( iA );
+      scratch_dist[iA] = box.max_dist( mol[iA] );
+      r_cell_max = std::max( r_cell_max, scratch_dist[iA] );
+    }
+  });
+  std::sort( scratch_atoms.begin(), scratch_atoms.end() );
+
+  // The parent and the cell atoms are always kept. The pair criterion
+  // alone may drop them for degenerate (e.g. single point) boxes, where
+  // r_min(A) == r_max(A).
+  task_atoms.clear();
+  bool has_parent = false;
+  atom_cells.for_each( box.lo, box.hi, ssf_c * r_cell_max, [&]( size_t iB ) {
+    const double r_min = box.min_dist( mol[iB] );
+    bool keep = iB == parent or std::binary_search( scratch_atoms.begin(),
+      scratch_atoms.end(), iB );
+    for( auto iA : scratch_atoms ) {
+      if( keep ) break;
+      keep = r_min < scratch_dist[iA] + integrator::magic_ssf_factor<> *
+                                        RAB[iB + iA*natoms];
+    }
+    if( keep ) task_atoms.emplace_back( iB );
+    has_parent = has_parent or iB == parent;
+  });
+  if( not has_parent ) task_atoms.emplace_back( parent );
+  std::sort( task_atoms.begin(), task_atoms.end() );
+
+  return true;
+
+}
+
+/**
+ *  SSF partition weight of a point by the (screened) pairwise evaluation
+ *  over the neighbors of the point, i.e. the atoms of the task list within
+ *  c * r_A of any of the cell atoms A.
+ *
+ *  @param[in,out] atoms  Cell atoms on entry, neighbors on exit
+ */
+inline double ssf_pairwise_weight( const MolMeta& meta, size_t parent,
+  const std::vector<size_t>& task_atoms, std::vector<size_t>& atoms,
+  const double* atomDist, double* partitionScratch ) {
+
+  const size_t natoms = meta.natoms();
+  const auto&  RAB    = meta.rab();
+
+  double r_keep = 0.;
+  for( auto iA : atoms ) r_keep = std::max( r_keep, atomDist[iA] );
+  r_keep *= ssf_c;
+
+  atoms.clear();
+  for( auto iA : task_atoms )
+  if( iA == parent or atomDist[iA] < r_keep ) {
+    atoms.emplace_back( iA );
+    partitionScratch[iA] = 1.;
+  }
+
+  const size_t nkeep = atoms.size();
+  for( size_t i_A = 0; i_A < nkeep; i_A++ )
+  for( size_t j_A = 0; j_A < i_A;   j_A++ ) {
+
+    const size_t iA = atoms[i_A];
+    const size_t jA = atoms[j_A];
+    if( partitionScratch[iA] <= integrator::ssf_weight_tol and
+        partitionScratch[jA] <= integrator::ssf_weight_tol ) continue;
+
+    const double mu = (atomDist[iA] - atomDist[jA]) / RAB[jA + iA*natoms];
+
+    if( mu <= -integrator::magic_ssf_factor<> ) {
+
+      partitionScratch[jA] = 0.;
+
+    } else if (mu >= integrator::magic_ssf_factor<>) {
+
+      partitionScratch[iA] = 0.;
+
+    } else {
+
+      double g = 0.5 * ( 1. - ssf_g(mu) );
+      partitionScratch[iA] *= g;
+      partitionScratch[jA] *= 1. - g;
+
+    }
+
+  }
+
+  double sum = 0.;
+  for( auto iA : atoms ) sum += partitionScratch[iA];
+  return partitionScratch[parent] / sum;
+
+}
+
+}
@@ -0,0 +1,503 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "host/reference/weights.hpp"
+#include "host/reference/weights_common.hpp"
+#include "common/integrator_constants.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace GauXC {
+
+namespace {
+
+/// Number of points processed as SoA lanes
+constexpr size_t weights_simd_width = 8;
+constexpr size_t W = weights_simd_width;
+
+/// Block of (up to) W points of a task in SoA layout. Partial blocks
+/// replicate the last point, i.e. all lanes hold valid points.
+struct PointLanes {
+
+  alignas(64) double x[W];
+  alignas(64) double y[W];
+  alignas(64) double z[W];
+  size_t n;
+
+  PointLanes( const XCTask& task, size_t ipt ) :
+    n( std::min( W, task.points.size() - ipt ) ) {
+    for( size_t l = 0; l < W; ++l ) {
+      const auto& point = task.points[ ipt + std::min( l, n-1 ) ];
+      x[l] = point[0]; y[l] = point[1]; z[l] = point[2];
+    }
+  }
+
+  /// Distances of the points to an atom
+  inline void dist( const Atom& atom, double* __restrict__ r ) const {
+    const double ax = atom.x, ay = atom.y, az = atom.z;
+    #pragma omp simd aligned(r:64)
+    for( size_t l = 0; l < W; ++l ) {
+      const double da_x = x[l] - ax;
+      const double da_y = y[l] - ay;
+      const double da_z = z[l] - az;
+      r[l] = std::sqrt(da_x*da_x + da_y*da_y + da_z*da_z);
+    }
+  }
+
+};
+
+/**
+ *  Lane-wise factor s(mu_AB) applied to P_A by the pairwise SSF loop, i.e.
+ *  0.5 * (1 - g(mu_AB)) for B < A and 1 - 0.5 * (1 - g(mu_BA)) otherwise.
+ *  s < 0 denotes s(mu_AB) = 1 (skipped). Returns whether any lane is not
+ *  skipped.
+ */
+template <bool BLower>
+inline bool ssf_factor_lanes( const double* __restrict__ r_A,
+  const double* __restrict__ r_B, double rab, double* __restrict__ s ) {
+
+  constexpr double a = integrator::magic_ssf_factor<>;
+  int nkeep = 0;
+  #pragma omp simd aligned(r_A,r_B,s:64) reduction(+:nkeep)
+  for( size_t l = 0; l < W; ++l ) {
+    const double mu   = (r_A[l] - r_B[l]) / rab; // mu_BA = -mu_AB
+    const double G    = detail::ssf_g(mu);
+    const double g    = BLower ? 0.5 * (1. - G) : 1. - 0.5 * (1. + G);
+    const bool   skip = (r_B[l] >= detail::ssf_c * r_A[l]) | (mu <= -a);
+    s[l]   = skip ? -1. : (mu >= a ? 0. : g);
+    nkeep += not skip;
+  }
+  return nkeep > 0;
+
+}
+
+/// Lane data of all atoms (atom major), 64 byte aligned
+class AtomLanes {
+  std::vector<double> data_;
+  double*             base_;
+public:
+  AtomLanes( size_t natoms ) : data_( natoms*W + 8 ) {
+    auto addr = reinterpret_cast<std::uintptr_t>( data_.data() );
+    base_ = data_.data() + ((64 - addr % 64) % 64) / sizeof(double);
+  }
+  inline double* operator[]( size_t iA ) { return base_ + iA*W; }
+};
+
+}
+
+void soa_becke_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const size_t natoms = mol.natoms();
+
+  const auto&  RAB    = meta.rab();
+
+  #pragma omp parallel
+  {
+
+  AtomLanes atomDist( natoms );
+  AtomLanes partitionScratch( natoms );
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto&        task = *(task_begin+iT);
+    const size_t npts = task.points.size();
+
+  for( size_t ipt = 0; ipt < npts; ipt += W ) {
+
+    const PointLanes points( task, ipt );
+
+    // Compute distances of each center to the points
+    for( size_t iA = 0; iA < natoms; ++iA ) {
+      points.dist( mol[iA], atomDist[iA] );
+      std::fill_n( partitionScratch[iA], W, 1. );
+    }
+
+    // Evaluate unnormalized partition functions
+    for( size_t iA = 0; iA < natoms; iA++ )
+    for( size_t jA = 0; jA < iA;     jA++ ) {
+
+      const double  rab = RAB[jA + iA*natoms];
+      const double* r_i = atomDist[iA];
+      const double* r_j = atomDist[jA];
+      double*       P_i = partitionScratch[iA];
+      double*       P_j = partitionScratch[jA];
+
+      #pragma omp simd aligned(r_i,r_j,P_i,P_j:64)
+      for( size_t l = 0; l < W; ++l ) {
+        const double mu = (r_i[l] - r_j[l]) / rab;
+        const double g  = detail::becke_g(mu);
+        P_i[l] *= 0.5 * (1. - g);
+        P_j[l] *= 0.5 * (1. + g);
+      }
+
+    }
+
+    // Normalization
+    alignas(64) double sum[W] = {};
+    for( size_t iA = 0; iA < natoms; iA++ ) {
+      const double* P = partitionScratch[iA];
+      #pragma omp simd aligned(P:64)
+      for( size_t l = 0; l < W; ++l ) sum[l] += P[l];
+    }
+
+    // Update Weights
+    const double* P_parent = partitionScratch[task.iParent];
+    for( size_t l = 0; l < points.n; ++l )
+      task.weights[ipt+l] *= P_parent[l] / sum[l];
+
+  } // Loop over point blocks
+  } // Loop over tasks
+
+  } // OMP context
+
+}
+
+void soa_ssf_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  using detail::ssf_c;
+  using detail::ssf_g;
+  constexpr double a   = integrator::magic_ssf_factor<>;
+  constexpr double tol = integrator::ssf_weight_tol;
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const size_t natoms = mol.natoms();
+
+  const auto&  RAB    = meta.rab();
+
+  // Lane parallel variant of reference_ssf_weights_host: the cell functions
+  // are evaluated for the union of the cell atoms of the points of a block
+  // (and set to 0 for the points at which they are not cell atoms), the
+  // zeroing / screening branches are lane-wise selections.
+  const detail::AtomCellList atom_cells( mol );
+
+  #pragma omp parallel
+  {
+
+  std::vector<double> partitionScratch( natoms );
+  std::vector<double> atomDist( natoms );
+  std::vector<size_t> task_atoms;   task_atoms.reserve( natoms );
+  std::vector<size_t> cell_atoms;   cell_atoms.reserve( natoms );
+  std::vector<size_t> block_atoms;  block_atoms.reserve( natoms );
+
+  AtomLanes dist( natoms );
+  AtomLanes part( natoms );
+  AtomLanes cell( natoms );
+
+  // Lane-wise factor s(mu_AB) applied to P_A by the pairwise loop of
+  // reference_ssf_weights_host, s < 0 denotes that it is skipped (s = 1).
+  // Returns whether any lane is not skipped.
+  auto ssf_factor = [&]( size_t iA, size_t iB, double* s ) {
+    if( iB < iA ) 
+      return ssf_factor_lanes<true>( dist[iA], dist[iB], RAB[iB + iA*natoms], s );
+    else
+      return ssf_factor_lanes<false>( dist[iA], dist[iB], RAB[iA + iB*natoms], s );
+  };
+
+  // Whether r_B < c * r_A for any lane, i.e. s(mu_AB) != 1
+  auto in_range = [&]( size_t iA, size_t iB ) {
+    const double* r_A = dist[iA];
+    const double* r_B = dist[iB];
+    int nrange = 0;
+    #pragma omp simd aligned(r_A,r_B:64) reduction(+:nrange)
+    for( size_t l = 0; l < W; ++l ) nrange += r_B[l] < ssf_c * r_A[l];
+    return nrange > 0;
+  };
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto&        task   = *(task_begin+iT);
+    const size_t npts   = task.points.size();
+    const size_t parent = task.iParent;
+    if( !npts ) continue;
+
+    const auto dist_cutoff = 0.5 * (1-a) * task.dist_nearest;
+
+    // Task inside of the SSF cutoff sphere, partition weights = 1
+    if( not detail::ssf_task_atoms( mol, meta, atom_cells, task, task_atoms,
+      cell_atoms, atomDist ) ) continue;
+
+  for( size_t ipt = 0; ipt < npts; ipt += W ) {
+
+    const PointLanes points( task, ipt );
+
+    // Compute dist to parent atom
+    points.dist( mol[parent], dist[parent] );
+
+    bool any_active = false;
+    for( size_t l = 0; l < points.n; ++l )
+      any_active = any_active or dist[parent][l] >= dist_cutoff;
+    if( not any_active ) continue; // Partition weights = 1
+
+    // Compute distances of each center to the points
+    alignas(64) size_t iNearest[W];
+    alignas(64) double rNearest[W];
+    std::fill_n( iNearest, W, parent );
+    std::copy_n( dist[parent], W, rNearest );
+    for( auto iA : task_atoms ) {
+      if( iA == parent ) continue;
+      double* r = dist[iA];
+      points.dist( mol[iA], r );
+      #pragma omp simd aligned(r:64)
+      for( size_t l = 0; l < W; ++l ) {
+        const bool nearer = r[l] < rNearest[l];
+        iNearest[l] = nearer ? iA   : iNearest[l];
+        rNearest[l] = nearer ? r[l] : rNearest[l];
+      }
+    }
+
+    // Atoms with a non-zero cell function at any of the points (lane mask)
+    block_atoms.clear();
+    for( auto iA : task_atoms ) {
+      double* mask = cell[iA];
+      bool any = false;
+      for( size_t l = 0; l < W; ++l ) {
+        const bool is_cell = iA == parent or iA == iNearest[l] or
+          (dist[iA][l] - rNearest[l]) / RAB[iNearest[l] + iA*natoms] < a;
+        mask[l] = is_cell;
+        any = any or is_cell;
+      }
+      if( any ) block_atoms.emplace_back( iA );
+      std::fill_n( part[iA], W, 0. );
+    }
+
+    // Unnormalized partition functions of the cell atoms but the parent
+    for( auto iA : block_atoms ) {
+      if( iA == parent ) continue;
+
+      alignas(64) double P[W];
+      alignas(64) double s_AB[W];
+      std::fill_n( P, W, 1. );
+      for( auto iB : task_atoms ) {
+        if( iB == iA or not in_range( iA, iB ) ) continue;
+        if( not ssf_factor( iA, iB, s_AB ) ) continue;
+
+        int nzero = 0;
+        #pragma omp simd aligned(P,s_AB:64) reduction(+:nzero)
+        for( size_t l = 0; l < W; ++l ) {
+          P[l] = s_AB[l] < 0. ? P[l] : P[l] * s_AB[l];
+          nzero += P[l] == 0.;
+        }
+        if( nzero == W ) break;
+      }
+
+      const double* mask = cell[iA];
+      double*       P_A  = part[iA];
+      for( size_t l = 0; l < W; ++l ) P_A[l] = mask[l] != 0. ? P[l] : 0.;
+    }
+
+    // Parent (screened), see reference_ssf_weights_host
+    alignas(64) double P[W];
+    alignas(64) double s_AB[W];
+    alignas(64) double undetermined[W];
+    alignas(64) double done[W];
+    std::fill_n( P, W, 1. );
+    std::fill_n( undetermined, W, 0. );
+    std::fill_n( done, W, 0. );
+    for( auto iB : task_atoms ) {
+      if( iB == parent or not in_range( parent, iB ) ) continue;
+      if( not ssf_factor( parent, iB, s_AB ) ) continue;
+      const double* P_B = part[iB];
+
+      #pragma omp simd aligned(P,s_AB,P_B,undetermined,done:64)
+      for( size_t l = 0; l < W; ++l ) {
+        const double g     = s_AB[l];
+        const bool   above = P_B[l] > tol;
+        const bool   undet = undetermined[l] != 0.;
+
+        const bool apply = (g >= 0.) & (done[l] == 0.);
+        const bool kill  = apply & undet & (g == 0.) & above;
+        const bool stop  = apply & not undet & (P[l] <= tol) & not above;
+        const bool mult  = apply & not undet & not stop;
+
+        P[l] = kill ? 0. : (mult ? P[l] * g : P[l]);
+        done[l]         = (done[l] != 0.) | kill | (mult & (g == 0.));
+        undetermined[l] = (undet & not kill) | stop;
+      }
+    }
+    std::copy_n( P, W, part[parent] );
+
+    // Normalization
+    alignas(64) double sum[W] = {};
+    for( auto iA : block_atoms ) {
+      const double* P_A = part[iA];
+      #pragma omp simd aligned(P_A:64)
+      for( size_t l = 0; l < W; ++l ) sum[l] += P_A[l];
+    }
+
+    // Update Weights
+    for( size_t l = 0; l < points.n; ++l ) {
+      if( dist[parent][l] < dist_cutoff ) continue; // Partition weight = 1
+
+      auto& weight = task.weights[ipt+l];
+      if( undetermined[l] != 0. ) {
+        // Sub-tolerance cell function of the parent
+        cell_atoms.clear();
+        for( auto iA : task_atoms ) {
+          atomDist[iA] = dist[iA][l];
+          if( cell[iA][l] != 0. ) cell_atoms.emplace_back( iA );
+        }
+        weight *= detail::ssf_pairwise_weight( meta, parent, task_atoms,
+          cell_atoms, atomDist.data(), partitionScratch.data() );
+      } else {
+        weight *= P[l] / sum[l];
+      }
+    }
+
+  } // Loop over point blocks
+  } // Loop over tasks
+
+  } // OMP context
+
+}
+
+void soa_lko_weights_host(
+  const Molecule&        mol,
+  const MolMeta&         meta,
+  task_iterator          task_begin,
+  task_iterator          task_end
+) {
+
+  // Sort on atom index (as reference_lko_weights_host)
+  std::stable_sort( task_begin, task_end,
+    [](const auto& a, const auto&b ) { return a.iParent < b.iParent; } );
+
+  constexpr double R_cutoff = 5;
+
+  const size_t ntasks = std::distance(task_begin,task_end);
+  const size_t natoms = mol.natoms();
+
+  const auto&  RAB    = meta.rab();
+
+  // Only atoms within R_cutoff of the nearest atom contribute. The nearest
+  // atom distance of the points of a task is bounded by the largest distance
+  // of its bounding box to any atom.
+
+  #pragma omp parallel
+  {
+
+  std::vector<size_t> task_atoms; task_atoms.reserve( natoms );
+  AtomLanes atomDist( natoms );
+  AtomLanes atomKeep( natoms );
+  AtomLanes partitionScratch( natoms );
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    auto&        task   = *(task_begin+iT);
+    const size_t npts   = task.points.size();
+    const size_t parent = task.iParent;
+    if( !npts ) continue;
+
+    const detail::TaskBoundingBox box( task );
+    double r_nearest_max = std::numeric_limits<double>::infinity();
+    for( size_t iA = 0; iA < natoms; ++iA )
+      r_nearest_max = std::min( r_nearest_max, box.max_dist( mol[iA] ) );
+
+    task_atoms.clear();
+    for( size_t iA = 0; iA < natoms; ++iA )
+    if( iA == parent or box.min_dist( mol[iA] ) <= r_nearest_max + R_cutoff )
+      task_atoms.emplace_back( iA );
+
+  for( size_t ipt = 0; ipt < npts; ipt += W ) {
+
+    const PointLanes points( task, ipt );
+
+    // Compute distances of each center to the points
+    alignas(64) double rNearest[W];
+    std::fill_n( rNearest, W, std::numeric_limits<double>::infinity() );
+    for( auto iA : task_atoms ) {
+      double* r = atomDist[iA];
+      points.dist( mol[iA], r );
+      #pragma omp simd aligned(r:64)
+      for( size_t l = 0; l < W; ++l ) rNearest[l] = std::min( rNearest[l], r[l] );
+    }
+
+    // Non-negligible centers (r_A <= r_N + R_cutoff)
+    for( auto iA : task_atoms ) {
+      const double* r    = atomDist[iA];
+      double*       keep = atomKeep[iA];
+      double*       P    = partitionScratch[iA];
+      #pragma omp simd aligned(r,keep,P:64)
+      for( size_t l = 0; l < W; ++l ) {
+        keep[l] = r[l] <= rNearest[l] + R_cutoff;
+        P[l]    = keep[l];
+      }
+    }
+
+    // Evaluate unnormalized partition functions
+    const size_t nkeep = task_atoms.size();
+    for( size_t i = 0; i < nkeep; ++i )
+    for( size_t j = 0; j < i;     ++j ) {
+
+      const size_t iA  = task_atoms[i];
+      const size_t jA  = task_atoms[j];
+      const double rab = std::min( RAB[iA*natoms + jA], R_cutoff );
+
+      const double* r_i    = atomDist[iA];
+      const double* r_j    = atomDist[jA];
+      const double* keep_i = atomKeep[iA];
+      const double* keep_j = atomKeep[jA];
+      double*       P_i    = partitionScratch[iA];
+      double*       P_j    = partitionScratch[jA];
+
+      // s is evaluated w.r.t. the farther atom (as in the distance ordered
+      // loop of reference_lko_weights_host)
+      #pragma omp simd aligned(r_i,r_j,keep_i,keep_j,P_i,P_j:64)
+      for( size_t l = 0; l < W; ++l ) {
+        const bool   keep  = (keep_i[l] != 0.) & (keep_j[l] != 0.);
+        const bool   i_far = r_i[l] >= r_j[l];
+        const double mu    = std::abs(r_i[l] - r_j[l]) / rab;
+        const double s     = 0.5 * (1. - detail::becke_g(mu));
+        const double s_i   = i_far ? s : 1. - s;
+        const double s_j   = i_far ? 1. - s : s;
+        P_i[l] = keep ? P_i[l] * s_i : P_i[l];
+        P_j[l] = keep ? P_j[l] * s_j : P_j[l];
+      }
+
+    }
+
+    // Normalization
+    alignas(64) double sum[W] = {};
+    for( auto iA : task_atoms ) {
+      const double* P = partitionScratch[iA];
+      #pragma omp simd aligned(P:64)
+      for( size_t l = 0; l < W; ++l ) sum[l] += P[l];
+    }
+
+    // Update Weights (partition weight is 0 if the parent is negligible)
+    const double* P_parent    = partitionScratch[parent];
+    const double* keep_parent = atomKeep[parent];
+    for( size_t l = 0; l < points.n; ++l )
+      task.weights[ipt+l] = keep_parent[l] != 0. ? 
+        task.weights[ipt+l] * P_parent[l] / sum[l] : 0.;
+
+  } // Loop over point blocks
+  } // Loop over tasks
+
+  } // OMP context
+
+}
+
+}
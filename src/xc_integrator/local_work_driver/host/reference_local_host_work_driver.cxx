@@ -11,7 +11,10 @@
 #include "host/reference/collocation.hpp"
 
 #include "host/util.hpp"
+#include "host/host_accumulator.hpp"
 #include "host/blas.hpp"
+#include "host/small_gemm.hpp"
+#include "host/host_scratch_arena.hpp"
 #include <stdexcept>
 
 #include <gauxc/basisset_map.hpp>
@@ -36,16 +39,22 @@ namespace GauXC {
   // Partition weights
   void ReferenceLocalHostWorkDriver::partition_weights( XCWeightAlg weight_alg, 
 							const Molecule& mol, const MolMeta& meta, task_iterator task_begin, 
-							task_iterator task_end ) {
+							task_iterator task_end, bool vectorized ) {
+    // The SoA kernels of SSF / LKO rely on vectorized lane selections, i.e.
+    // the scalar kernels may be faster on targets without masked blends
+    // (e.g. pre-AVX)
     switch( weight_alg ) {
       case XCWeightAlg::Becke:
-        reference_becke_weights_host( mol, meta, task_begin, task_end );
+        if( vectorized ) soa_becke_weights_host( mol, meta, task_begin, task_end );
+        else       reference_becke_weights_host( mol, meta, task_begin, task_end );
         break;
       case XCWeightAlg::SSF:
-        reference_ssf_weights_host( mol, meta, task_begin, task_end );
+        if( vectorized ) soa_ssf_weights_host( mol, meta, task_begin, task_end );
+        else       reference_ssf_weights_host( mol, meta, task_begin, task_end );
         break;
       case XCWeightAlg::LKO:
-        reference_lko_weights_host( mol, meta, task_begin, task_end );
+        if( vectorized ) soa_lko_weights_host( mol, meta, task_begin, task_end );
+        else       reference_lko_weights_host( mol, meta, task_begin, task_end );
         break;
       default:
         GAUXC_GENERIC_EXCEPTION("Weight Alg Not Supported");
@@ -56,8 +65,10 @@ namespace GauXC {
   // Collocation
   void ReferenceLocalHostWorkDriver::eval_collocation( size_t npts, size_t nshells, 
 						       size_t nbe, const double* pts, const BasisSet<double>& basis, 
-						       const int32_t* shell_list, double* basis_eval ) {
-    gau2grid_collocation( npts, nshells, nbe, pts, basis, shell_list, basis_eval );
+						       const int32_t* shell_list, double* basis_eval,
+						       const uint64_t* shell_tile_mask ) {
+    host_collocation( npts, nshells, nbe, pts, basis, shell_list, basis_eval,
+      shell_tile_mask );
   }
 
 
@@ -65,9 +76,11 @@ namespace GauXC {
   void ReferenceLocalHostWorkDriver::eval_collocation_gradient( size_t npts, 
 								size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
 								const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
-								double* dbasis_y_eval, double* dbasis_z_eval) {
-    gau2grid_collocation_gradient(npts, nshells, nbe, pts, basis, shell_list,
-				  basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+								double* dbasis_y_eval, double* dbasis_z_eval,
+								const uint64_t* shell_tile_mask ) {
+    host_collocation_gradient(npts, nshells, nbe, pts, basis, shell_list,
+				  basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
+				  shell_tile_mask );
   }
 
   void ReferenceLocalHostWorkDriver::eval_collocation_hessian( size_t npts, 
@@ -76,12 +89,22 @@ namespace GauXC {
 							       double* dbasis_y_eval, double* dbasis_z_eval, double* d2basis_xx_eval, 
 							       double* d2basis_xy_eval, double* d2basis_xz_eval, double* d2basis_yy_eval, 
 							       double* d2basis_yz_eval, double* d2basis_zz_eval ) {
-    gau2grid_collocation_hessian(npts, nshells, nbe, pts, basis, shell_list,
+    host_collocation_hessian(npts, nshells, nbe, pts, basis, shell_list,
 				 basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
 				 d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
 				 d2basis_zz_eval);
   }
 
+  void ReferenceLocalHostWorkDriver::eval_collocation_laplacian( size_t npts, 
+							       size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
+							       const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
+							       double* dbasis_y_eval, double* dbasis_z_eval, double* lbasis_eval,
+							       const uint64_t* shell_tile_mask ) {
+    host_collocation_laplacian(npts, nshells, nbe, pts, basis, shell_list,
+				 basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, lbasis_eval,
+				 shell_tile_mask);
+  }
+
   void ReferenceLocalHostWorkDriver::eval_collocation_der3( size_t npts,
 							    size_t nshells, size_t nbe, const double* pts, const BasisSet<double>& basis, 
 							     const int32_t* shell_list, double* basis_eval, double* dbasis_x_eval, 
@@ -107,7 +130,12 @@ namespace GauXC {
     const auto* P_use = P;
     size_t ldp_use = ldp;
      
-    if( submat_map.size() > 1 ) {
+    if( submat_map.size() > 1 and 
+        detail::use_inplace_submat( submat_map, submat_map ) ) {
+      detail::gemm_submat_a<double>( npts, fac, P, ldp, submat_map, submat_map, 
+        basis_eval, ldb, 0., X, ldx );
+      return;
+    } else if( submat_map.size() > 1 ) {
       detail::submat_set( nbf, nbf, nbe, nbe, P, ldp, scr, nbe, submat_map );
       P_use = scr;
       ldp_use = nbe;
@@ -115,12 +143,156 @@ namespace GauXC {
       P_use = P + submat_map[0][0]*(ldp+1);
     }
 
-    blas::gemm( 'N', 'N', nbe, npts, nbe, fac, P_use, ldp_use, basis_eval, ldb, 
+    detail::small_gemm( 'N', 'N', nbe, npts, nbe, fac, P_use, ldp_use, basis_eval, ldb, 
+		0., X, ldx );
+
+  }
+
+  void ReferenceLocalHostWorkDriver::eval_xmat_mixed( size_t npts, size_t nbf, size_t nbe, 
+						      const submat_map_t& submat_map, double fac, const double* P, size_t ldp, 
+						      const float* basis_eval, size_t ldb, double* X, size_t ldx, float* scr ) {
+
+    (void)(nbf);
+
+    // Gather (and round) the non-negligible block of P
+    auto* P_sp = scr;
+    auto* X_sp = scr + nbe*nbe;
+    size_t j_sp = 0;
+    for( const auto& jCut : submat_map ) {
+    for( int32_t j = jCut[0]; j < jCut[0] + jCut[1]; ++j, ++j_sp ) {
+      size_t i_sp = 0;
+      for( const auto& iCut : submat_map ) {
+      for( int32_t i = iCut[0]; i < iCut[0] + iCut[1]; ++i, ++i_sp ) {
+        P_sp[i_sp + j_sp*nbe] = P[i + j*ldp];
+      }
+      }
+    }
+    }
+
+    detail::small_gemm( 'N', 'N', nbe, npts, nbe, float(fac), P_sp, nbe, basis_eval, ldb, 
+		0.f, X_sp, nbe );
+
+    for( size_t j = 0; j < npts; ++j )
+    for( size_t i = 0; i < nbe;  ++i ) X[i + j*ldx] = X_sp[i + j*nbe];
+
+  }
+
+  void ReferenceLocalHostWorkDriver::eval_xmat_batch( size_t npts, size_t nbf,
+    size_t nbe, const submat_map_t& submat_map, size_t ndm, double fac,
+    const double* const* P, size_t ldp, const double* basis_eval, size_t ldb,
+    double* X, size_t ldx, double* scr ) {
+
+    // Stack the non-negligible blocks of all densities: (ndm*nbe, nbe)
+    const size_t ldscr = ndm * nbe;
+    for( size_t k = 0; k < ndm; ++k )
+      detail::submat_set( nbf, nbf, nbe, nbe, P[k], ldp, scr + k*nbe, ldscr,
+        submat_map );
+
+    detail::small_gemm( 'N', 'N', ldscr, npts, nbe, fac, scr, ldscr, basis_eval, ldb,
 		0., X, ldx );
 
   }
 
 
+  // Largest fraction of the (nbe,nbe) block of P, weighted by the block
+  // sizes, for which the block sparse X matrix is formed, denser tasks are
+  // evaluated by a single GEMM. See the "[xmat-block-sparse-bench]" timings
+  // of tests/host_kernels.cxx.
+  static constexpr double xmat_block_sparse_max_fill = 0.5;
+
+  void ReferenceLocalHostWorkDriver::eval_xmat_block_sparse( size_t npts, 
+    size_t nbf, size_t nbe, const submat_map_t& submat_map, size_t nshells, 
+    const int32_t* shell_list, const BasisSetMap& basis_map, 
+    const double* shell_norms, size_t ldn, double tol, double fac, 
+    const double* P, size_t ldp, const double* basis_eval, size_t ldb, 
+    double* X, size_t ldx, double* scr ) {
+
+    // Temporaries are sliced from the scratch arena of the calling thread
+    HostScratchScope scratch( thread_scratch_arena() );
+
+    // Consecutive shells of the task on the same center form an atom block,
+    // blocks [blk_sh[b], blk_sh[b+1]) of the shells and [blk_off[b], 
+    // blk_off[b+1]) of the compressed basis
+    auto* blk_sh  = scratch.allocate<size_t>( nshells + 1 );
+    auto* blk_off = scratch.allocate<size_t>( nshells + 1 );
+    size_t nblk = 0;
+    blk_sh[0] = blk_off[0] = 0;
+    for( size_t i = 0, off = 0; i < nshells; ++i ) {
+      off += basis_map.shell_size( shell_list[i] );
+      const bool last = i + 1 == nshells or 
+        basis_map.shell_to_center( shell_list[i+1] ) != 
+        basis_map.shell_to_center( shell_list[i] );
+      if( last ) {
+        ++nblk;
+        blk_sh [nblk] = i + 1;
+        blk_off[nblk] = off;
+      }
+    }
+
+    // Significant atom pair blocks of the task (row major)
+    auto* sig = scratch.allocate<char>( nblk * nblk );
+    size_t sig_size = 0;
+    for( size_t ib = 0; ib < nblk; ++ib )
+    for( size_t jb = 0; jb < nblk; ++jb ) {
+      double nrm = 0.;
+      for( size_t j = blk_sh[jb]; j < blk_sh[jb+1]; ++j )
+      for( size_t i = blk_sh[ib]; i < blk_sh[ib+1]; ++i )
+        nrm = std::max( nrm, 
+          shell_norms[ shell_list[i] + size_t(shell_list[j])*ldn ] );
+      sig[jb + ib*nblk] = nrm > tol;
+      if( nrm > tol ) sig_size += (blk_off[ib+1] - blk_off[ib]) * 
+                                  (blk_off[jb+1] - blk_off[jb]);
+    }
+
+    // Not worth it
+    if( sig_size > xmat_block_sparse_max_fill * nbe * nbe ) {
+      eval_xmat( npts, nbf, nbe, submat_map, fac, P, ldp, basis_eval, ldb, X,
+        ldx, scr );
+      return;
+    }
+
+    const auto* P_use = P;
+    size_t ldp_use = ldp;
+    if( submat_map.size() > 1 ) {
+      detail::submat_set( nbf, nbf, nbe, nbe, P, ldp, scr, nbe, submat_map );
+      P_use = scr;
+      ldp_use = nbe;
+    } else if( nbe != nbf ) {
+      P_use = P + submat_map[0][0]*(ldp+1);
+    }
+
+    for( size_t j = 0; j < npts; ++j )
+    for( size_t i = 0; i < nbe;  ++i ) X[i + j*ldx] = 0.;
+
+    for( size_t i_st = 0; i_st < nblk; ) {
+
+      // Consecutive row blocks with the same significant blocks
+      const auto* sig_i = sig + i_st*nblk;
+      size_t i_en = i_st + 1;
+      while( i_en < nblk and 
+        std::equal( sig_i, sig_i + nblk, sig + i_en*nblk ) ) ++i_en;
+
+      const size_t nrow = blk_off[i_en] - blk_off[i_st];
+      for( size_t j_st = 0; j_st < nblk; ) {
+        if( not sig_i[j_st] ) { ++j_st; continue; }
+
+        // Contiguous run of significant column blocks
+        size_t j_en = j_st + 1;
+        while( j_en < nblk and sig_i[j_en] ) ++j_en;
+
+        detail::small_gemm( 'N', 'N', nrow, npts, blk_off[j_en] - blk_off[j_st],
+          fac, P_use + blk_off[i_st] + blk_off[j_st]*ldp_use, ldp_use, 
+          basis_eval + blk_off[j_st], ldb, 1., X + blk_off[i_st], ldx );
+
+        j_st = j_en;
+      }
+
+      i_st = i_en;
+    }
+
+  }
+
+
   // U/VVar LDA (density)
   void ReferenceLocalHostWorkDriver::eval_uvvar_lda_rks( size_t npts, size_t nbe, 
 						     const double* basis_eval, const double* X, size_t ldx, double* den_eval) {
@@ -129,8 +301,9 @@ namespace GauXC {
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
       const size_t ioff = size_t(i) * ldx;
+      const size_t boff = size_t(i) * nbe;
       const auto*   X_i = X + ioff;
-      den_eval[i] = blas::dot( nbe, basis_eval + ioff, 1, X_i, 1 );
+      den_eval[i] = blas::dot( nbe, basis_eval + boff, 1, X_i, 1 );
 
     }    
 
@@ -145,12 +318,13 @@ namespace GauXC {
 
       const size_t ioffs = size_t(i) * ldxs;
       const size_t ioffz = size_t(i) * ldxz;
+      const size_t boff  = size_t(i) * nbe;
 
       const auto*   Xs_i = Xs + ioffs;
       const auto*   Xz_i = Xz + ioffz;
 
-      const double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 );
-      const double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 );
+      const double rhos = blas::dot( nbe, basis_eval + boff, 1, Xs_i, 1 );
+      const double rhoz = blas::dot( nbe, basis_eval + boff, 1, Xz_i, 1 );
       
       den_eval[2*i]   = 0.5*(rhos + rhoz); // rho_+
       den_eval[2*i+1] = 0.5*(rhos - rhoz); // rho_-
@@ -176,16 +350,17 @@ namespace GauXC {
       const size_t ioffz = size_t(i) * ldxz;
       const size_t ioffx = size_t(i) * ldxx;
       const size_t ioffy = size_t(i) * ldxy;
+      const size_t boff  = size_t(i) * nbe;
 
       const auto*   Xs_i = Xs + ioffs;
       const auto*   Xz_i = Xz + ioffz;
       const auto*   Xx_i = Xx + ioffx;
       const auto*   Xy_i = Xy + ioffy;
 
-      const double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 );
-      const double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 );
-      const double rhox = blas::dot( nbe, basis_eval + ioffx, 1, Xx_i, 1 );
-      const double rhoy = blas::dot( nbe, basis_eval + ioffy, 1, Xy_i, 1 );
+      const double rhos = blas::dot( nbe, basis_eval + boff, 1, Xs_i, 1 );
+      const double rhoz = blas::dot( nbe, basis_eval + boff, 1, Xz_i, 1 );
+      const double rhox = blas::dot( nbe, basis_eval + boff, 1, Xx_i, 1 );
+      const double rhoy = blas::dot( nbe, basis_eval + boff, 1, Xy_i, 1 );
  
       double mtemp = rhoz * rhoz + rhox * rhox + rhoy * rhoy;
       double mnorm = 0;
@@ -219,13 +394,14 @@ namespace GauXC {
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
       const size_t ioff = size_t(i) * ldx;
+      const size_t boff = size_t(i) * nbe;
       const auto*   X_i = X + ioff;
 
-      den_eval[i] = blas::dot( nbe, basis_eval + ioff, 1, X_i, 1 );
+      den_eval[i] = blas::dot( nbe, basis_eval + boff, 1, X_i, 1 );
 
-      const auto dx = 2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, X_i, 1 );
-      const auto dy = 2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, X_i, 1 );
-      const auto dz = 2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, X_i, 1 );
+      const auto dx = 2. * blas::dot( nbe, dbasis_x_eval + boff, 1, X_i, 1 );
+      const auto dy = 2. * blas::dot( nbe, dbasis_y_eval + boff, 1, X_i, 1 );
+      const auto dz = 2. * blas::dot( nbe, dbasis_z_eval + boff, 1, X_i, 1 );
 
       dden_x_eval[i] = dx;
       dden_y_eval[i] = dy;
@@ -247,30 +423,31 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_gga_uks( size_t npts, size_t nbe,
 
       const size_t ioffs = size_t(i) * ldxs;
       const size_t ioffz = size_t(i) * ldxz;
+      const size_t boff  = size_t(i) * nbe;
 
       const auto*   Xs_i = Xs + ioffs;
       const auto*   Xz_i = Xz + ioffz;
 
-      double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 ); // S density
-      double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 ); // Z density
+      double rhos = blas::dot( nbe, basis_eval + boff, 1, Xs_i, 1 ); // S density
+      double rhoz = blas::dot( nbe, basis_eval + boff, 1, Xz_i, 1 ); // Z density
 
 
       den_eval[2*i]   = 0.5*(rhos + rhoz); // rho_+
       den_eval[2*i+1] = 0.5*(rhos - rhoz); // rho_-
 
       const auto dndx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + boff, 1, Xs_i, 1 );
       const auto dndy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + boff, 1, Xs_i, 1 );
       const auto dndz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + boff, 1, Xs_i, 1 );
 
       const auto dMzdx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + boff, 1, Xz_i, 1 );
       const auto dMzdy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + boff, 1, Xz_i, 1 );
       const auto dMzdz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + boff, 1, Xz_i, 1 );
 
       dden_x_eval[2*i] = dndx; // dn / dx
       dden_y_eval[2*i] = dndy; // dn / dy
@@ -306,13 +483,15 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_mgga_rks( size_t npts, size_t nbe,
    for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
       const size_t ioff = size_t(i) * ldx;
+      const size_t boff = size_t(i) * nbe;
+      const size_t moff = size_t(i) * ldm;
       const auto*   X_i = X + ioff;
 
-      den_eval[i] = blas::dot( nbe, basis_eval + ioff, 1, X_i, 1 );
+      den_eval[i] = blas::dot( nbe, basis_eval + boff, 1, X_i, 1 );
 
-      const auto dx = 2. * blas::dot( nbe, dbasis_x_eval + ioff, 1, X_i, 1 );
-      const auto dy = 2. * blas::dot( nbe, dbasis_y_eval + ioff, 1, X_i, 1 );
-      const auto dz = 2. * blas::dot( nbe, dbasis_z_eval + ioff, 1, X_i, 1 );
+      const auto dx = 2. * blas::dot( nbe, dbasis_x_eval + boff, 1, X_i, 1 );
+      const auto dy = 2. * blas::dot( nbe, dbasis_y_eval + boff, 1, X_i, 1 );
+      const auto dz = 2. * blas::dot( nbe, dbasis_z_eval + boff, 1, X_i, 1 );
 
       dden_x_eval[i] = dx;
       dden_y_eval[i] = dy;
@@ -320,12 +499,12 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_mgga_rks( size_t npts, size_t nbe,
 
       gamma[i] = dx*dx + dy*dy + dz*dz;
 
-      tau[i]  = 0.5*blas::dot( nbe, dbasis_x_eval + ioff, 1, mmat_x + ioff, 1);
-      tau[i] += 0.5*blas::dot( nbe, dbasis_y_eval + ioff, 1, mmat_y + ioff, 1);
-      tau[i] += 0.5*blas::dot( nbe, dbasis_z_eval + ioff, 1, mmat_z + ioff, 1);
+      tau[i]  = 0.5*blas::dot( nbe, dbasis_x_eval + boff, 1, mmat_x + moff, 1);
+      tau[i] += 0.5*blas::dot( nbe, dbasis_y_eval + boff, 1, mmat_y + moff, 1);
+      tau[i] += 0.5*blas::dot( nbe, dbasis_z_eval + boff, 1, mmat_z + moff, 1);
 
       if (lapl != nullptr)
-        lapl[i]  = 2. * blas::dot( nbe, lbasis_eval + ioff, 1, X_i, 1) + 4. * tau[i];
+        lapl[i]  = 2. * blas::dot( nbe, lbasis_eval + boff, 1, X_i, 1) + 4. * tau[i];
 
    }
 }
@@ -343,30 +522,33 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_mgga_uks( size_t npts, size_t nbe,
 
       const size_t ioffs = size_t(i) * ldxs;
       const size_t ioffz = size_t(i) * ldxz;
+      const size_t boff  = size_t(i) * nbe;
+      const size_t moffs = size_t(i) * ldms;
+      const size_t moffz = size_t(i) * ldmz;
 
       const auto*   Xs_i = Xs + ioffs;
       const auto*   Xz_i = Xz + ioffz;
 
-      double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 ); // S density
-      double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 ); // Z density
+      double rhos = blas::dot( nbe, basis_eval + boff, 1, Xs_i, 1 ); // S density
+      double rhoz = blas::dot( nbe, basis_eval + boff, 1, Xz_i, 1 ); // Z density
 
 
       den_eval[2*i]   = 0.5*(rhos + rhoz); // rho_+
       den_eval[2*i+1] = 0.5*(rhos - rhoz); // rho_-
 
       const auto dndx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + boff, 1, Xs_i, 1 );
       const auto dndy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + boff, 1, Xs_i, 1 );
       const auto dndz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + boff, 1, Xs_i, 1 );
 
       const auto dMzdx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + boff, 1, Xz_i, 1 );
       const auto dMzdy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + boff, 1, Xz_i, 1 );
       const auto dMzdz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + boff, 1, Xz_i, 1 );
 
       dden_x_eval[2*i] = dndx; // dn / dx
       dden_y_eval[2*i] = dndy; // dn / dy
@@ -387,19 +569,19 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_mgga_uks( size_t npts, size_t nbe,
       gamma[3*i+1] = 0.25*(dn_sq - dMz_sq);
       gamma[3*i+2] = 0.25*(dn_sq + dMz_sq) - 0.5*dn_dMz;
 
-      auto taus  = 0.5*blas::dot( nbe, dbasis_x_eval + ioffs, 1, mmat_xs + ioffs, 1);
-           taus += 0.5*blas::dot( nbe, dbasis_y_eval + ioffs, 1, mmat_ys + ioffs, 1);
-           taus += 0.5*blas::dot( nbe, dbasis_z_eval + ioffs, 1, mmat_zs + ioffs, 1);
-      auto tauz  = 0.5*blas::dot( nbe, dbasis_x_eval + ioffz, 1, mmat_xz + ioffz, 1);
-           tauz += 0.5*blas::dot( nbe, dbasis_y_eval + ioffz, 1, mmat_yz + ioffz, 1);
-           tauz += 0.5*blas::dot( nbe, dbasis_z_eval + ioffz, 1, mmat_zz + ioffz, 1);
+      auto taus  = 0.5*blas::dot( nbe, dbasis_x_eval + boff, 1, mmat_xs + moffs, 1);
+           taus += 0.5*blas::dot( nbe, dbasis_y_eval + boff, 1, mmat_ys + moffs, 1);
+           taus += 0.5*blas::dot( nbe, dbasis_z_eval + boff, 1, mmat_zs + moffs, 1);
+      auto tauz  = 0.5*blas::dot( nbe, dbasis_x_eval + boff, 1, mmat_xz + moffz, 1);
+           tauz += 0.5*blas::dot( nbe, dbasis_y_eval + boff, 1, mmat_yz + moffz, 1);
+           tauz += 0.5*blas::dot( nbe, dbasis_z_eval + boff, 1, mmat_zz + moffz, 1);
 
       tau[2*i]   = 0.5*(taus + tauz);
       tau[2*i+1] = 0.5*(taus - tauz);
 
       if (lapl != nullptr) {
-        auto lapls = 2. * blas::dot( nbe, lbasis_eval + ioffs, 1, Xs_i, 1) + 4. * taus;
-        auto laplz = 2. * blas::dot( nbe, lbasis_eval + ioffz, 1, Xz_i, 1) + 4. * tauz;
+        auto lapls = 2. * blas::dot( nbe, lbasis_eval + boff, 1, Xs_i, 1) + 4. * taus;
+        auto laplz = 2. * blas::dot( nbe, lbasis_eval + boff, 1, Xz_i, 1) + 4. * tauz;
 
         lapl[2*i]   = 0.5*(lapls + laplz);
         lapl[2*i+1] = 0.5*(lapls - laplz);
@@ -433,44 +615,45 @@ void ReferenceLocalHostWorkDriver::eval_uvvar_gga_gks( size_t npts, size_t nbe,
       const size_t ioffz = size_t(i) * ldxz;
       const size_t ioffx = size_t(i) * ldxx;
       const size_t ioffy = size_t(i) * ldxy;
+      const size_t boff  = size_t(i) * nbe;
 
       const auto*   Xs_i = Xs + ioffs;
       const auto*   Xz_i = Xz + ioffz;
       const auto*   Xx_i = Xx + ioffx;
       const auto*   Xy_i = Xy + ioffy;
 
-      const double rhos = blas::dot( nbe, basis_eval + ioffs, 1, Xs_i, 1 );
-      const double rhoz = blas::dot( nbe, basis_eval + ioffz, 1, Xz_i, 1 );
-      const double rhox = blas::dot( nbe, basis_eval + ioffx, 1, Xx_i, 1 );
-      const double rhoy = blas::dot( nbe, basis_eval + ioffy, 1, Xy_i, 1 );
+      const double rhos = blas::dot( nbe, basis_eval + boff, 1, Xs_i, 1 );
+      const double rhoz = blas::dot( nbe, basis_eval + boff, 1, Xz_i, 1 );
+      const double rhox = blas::dot( nbe, basis_eval + boff, 1, Xx_i, 1 );
+      const double rhoy = blas::dot( nbe, basis_eval + boff, 1, Xy_i, 1 );
 
       const auto dndx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + boff, 1, Xs_i, 1 );
       const auto dndy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + boff, 1, Xs_i, 1 );
       const auto dndz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffs, 1, Xs_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + boff, 1, Xs_i, 1 );
 
       const auto dMzdx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + boff, 1, Xz_i, 1 );
       const auto dMzdy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + boff, 1, Xz_i, 1 );
       const auto dMzdz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffz, 1, Xz_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + boff, 1, Xz_i, 1 );
 
       const auto dMxdx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffx, 1, Xx_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + boff, 1, Xx_i, 1 );
       const auto dMxdy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffx, 1, Xx_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + boff, 1, Xx_i, 1 );
       const auto dMxdz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffx, 1, Xx_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + boff, 1, Xx_i, 1 );
 
       const auto dMydx =
-        2. * blas::dot( nbe, dbasis_x_eval + ioffy, 1, Xy_i, 1 );
+        2. * blas::dot( nbe, dbasis_x_eval + boff, 1, Xy_i, 1 );
       const auto dMydy =
-        2. * blas::dot( nbe, dbasis_y_eval + ioffy, 1, Xy_i, 1 );
+        2. * blas::dot( nbe, dbasis_y_eval + boff, 1, Xy_i, 1 );
       const auto dMydz =
-        2. * blas::dot( nbe, dbasis_z_eval + ioffy, 1, Xy_i, 1 );
+        2. * blas::dot( nbe, dbasis_z_eval + boff, 1, Xy_i, 1 );
 
 
       dden_x_eval[4 * i] = dndx;
@@ -628,14 +811,13 @@ void ReferenceLocalHostWorkDriver::eval_zmat_lda_vxc_gks( size_t npts, size_t nb
 							const double* dbasis_z_eval, const double* dden_x_eval, 
 							const double* dden_y_eval, const double* dden_z_eval, double* Z, size_t ldz ) {
 
-    if( ldz != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
-    blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Z, nbf );
+    blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Z, ldz );
 
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
       const int32_t ioff = i * nbf;
 
-      auto* z_col    = Z + ioff;
+      auto* z_col    = Z + i*ldz;
       auto* bf_x_col = dbasis_x_eval + ioff; 
       auto* bf_y_col = dbasis_y_eval + ioff; 
       auto* bf_z_col = dbasis_z_eval + ioff; 
@@ -664,8 +846,6 @@ void ReferenceLocalHostWorkDriver::eval_zmat_lda_vxc_gks( size_t npts, size_t nb
               size_t ldzs, double* Zz, size_t ldzz ) {
 
 
-    if( ldzs != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
-    if( ldzz != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
     blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Zs, ldzs);
     blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Zz, ldzz);
 
@@ -673,8 +853,8 @@ void ReferenceLocalHostWorkDriver::eval_zmat_lda_vxc_gks( size_t npts, size_t nb
 
       const int32_t ioff = i * nbf;
 
-      auto* zs_col = Zs + ioff;
-      auto* zz_col = Zz + ioff;
+      auto* zs_col = Zs + i*ldzs;
+      auto* zz_col = Zz + i*ldzz;
       auto* bf_x_col = dbasis_x_eval + ioff;
       auto* bf_y_col = dbasis_y_eval + ioff;
       auto* bf_z_col = dbasis_z_eval + ioff;
@@ -721,14 +901,13 @@ void ReferenceLocalHostWorkDriver::eval_zmat_lda_vxc_gks( size_t npts, size_t nb
               const double* dden_x_eval,
               const double* dden_y_eval, const double* dden_z_eval, double* Z, size_t ldz ) {
 
-    if( ldz != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
-    blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Z, nbf );
+    blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Z, ldz );
 
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
       const int32_t ioff = i * nbf;
 
-      auto* z_col    = Z + ioff;
+      auto* z_col    = Z + i*ldz;
       auto* bf_x_col = dbasis_x_eval + ioff;
       auto* bf_y_col = dbasis_y_eval + ioff;
       auto* bf_z_col = dbasis_z_eval + ioff;
@@ -765,8 +944,6 @@ void ReferenceLocalHostWorkDriver::eval_zmat_mgga_vxc_uks( size_t npts, size_t n
               size_t ldzs, double* Zz, size_t ldzz ) {
 
 
-    if( ldzs != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
-    if( ldzz != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
     blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Zs, ldzs);
     blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Zz, ldzz);
 
@@ -774,8 +951,8 @@ void ReferenceLocalHostWorkDriver::eval_zmat_mgga_vxc_uks( size_t npts, size_t n
 
       const int32_t ioff = i * nbf;
 
-      auto* zs_col = Zs + ioff;
-      auto* zz_col = Zz + ioff;
+      auto* zs_col = Zs + i*ldzs;
+      auto* zz_col = Zz + i*ldzz;
       auto* bf_x_col = dbasis_x_eval + ioff;
       auto* bf_y_col = dbasis_y_eval + ioff;
       auto* bf_z_col = dbasis_z_eval + ioff;
@@ -828,7 +1005,6 @@ void ReferenceLocalHostWorkDriver::eval_zmat_mgga_vxc_uks( size_t npts, size_t n
               const double* dbasis_z_eval,
               double* mmat_x, double* mmat_y, double* mmat_z, size_t ldm ) {
 
-    if( ldm != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
     
     blas::lacpy( 'A', nbf, npts, dbasis_x_eval, nbf, mmat_x, ldm);
     blas::lacpy( 'A', nbf, npts, dbasis_y_eval, nbf, mmat_y, ldm);
@@ -837,9 +1013,9 @@ void ReferenceLocalHostWorkDriver::eval_zmat_mgga_vxc_uks( size_t npts, size_t n
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
       const int32_t ioff = i * nbf;
-      auto* mmat_x_col = mmat_x + ioff;
-      auto* mmat_y_col = mmat_y + ioff;
-      auto* mmat_z_col = mmat_z + ioff;
+      auto* mmat_x_col = mmat_x + i*ldm;
+      auto* mmat_y_col = mmat_y + i*ldm;
+      auto* mmat_z_col = mmat_z + i*ldm;
       auto* bf_x_col = dbasis_x_eval + ioff;
       auto* bf_y_col = dbasis_y_eval + ioff;
       auto* bf_z_col = dbasis_z_eval + ioff;
@@ -866,8 +1042,6 @@ void ReferenceLocalHostWorkDriver::eval_mmat_mgga_vxc_uks(size_t npts, size_t nb
               double* mmat_xs, double* mmat_ys, double* mmat_zs, size_t ldms,
               double* mmat_xz, double* mmat_yz, double* mmat_zz, size_t ldmz) {
 
-    if( ldms != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
-    if( ldmz != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
     
     blas::lacpy( 'A', nbf, npts, dbasis_x_eval, nbf, mmat_xs, ldms);
     blas::lacpy( 'A', nbf, npts, dbasis_y_eval, nbf, mmat_ys, ldms);
@@ -879,12 +1053,12 @@ void ReferenceLocalHostWorkDriver::eval_mmat_mgga_vxc_uks(size_t npts, size_t nb
     for( int32_t i = 0; i < (int32_t)npts; ++i ) {
 
       const int32_t ioff = i * nbf;
-      auto* xs_col = mmat_xs + ioff;
-      auto* ys_col = mmat_ys + ioff;
-      auto* zs_col = mmat_zs + ioff;
-      auto* xz_col = mmat_xz + ioff;
-      auto* yz_col = mmat_yz + ioff;
-      auto* zz_col = mmat_zz + ioff;
+      auto* xs_col = mmat_xs + i*ldms;
+      auto* ys_col = mmat_ys + i*ldms;
+      auto* zs_col = mmat_zs + i*ldms;
+      auto* xz_col = mmat_xz + i*ldmz;
+      auto* yz_col = mmat_yz + i*ldmz;
+      auto* zz_col = mmat_zz + i*ldmz;
       auto* bf_x_col = dbasis_x_eval + ioff;
       auto* bf_y_col = dbasis_y_eval + ioff;
       auto* bf_z_col = dbasis_z_eval + ioff;
@@ -933,10 +1107,6 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
     auto *HY = HZ + npts;
     auto *HX = HY + npts;
 
-    if( ldzs != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
-    if( ldzz != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
-    if( ldzx != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
-    if( ldzy != nbf ) GAUXC_GENERIC_EXCEPTION(std::string("Invalid Dims"));
 
     blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Zs, ldzs);
     blas::lacpy( 'A', nbf, npts, basis_eval, nbf, Zz, ldzz);
@@ -947,10 +1117,10 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
 
       const int32_t ioff = i * nbf;
 
-      auto* zs_col = Zs + ioff;
-      auto* zz_col = Zz + ioff;
-      auto* zx_col = Zx + ioff;
-      auto* zy_col = Zy + ioff;
+      auto* zs_col = Zs + i*ldzs;
+      auto* zz_col = Zz + i*ldzz;
+      auto* zx_col = Zx + i*ldzx;
+      auto* zy_col = Zy + i*ldzy;
 
       auto* bf_x_col = dbasis_x_eval + ioff;
       auto* bf_y_col = dbasis_y_eval + ioff;
@@ -1031,11 +1201,80 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
   // Increment VXC by Z
   void ReferenceLocalHostWorkDriver::inc_vxc( size_t npts, size_t nbf, size_t nbe, 
 					      const double* basis_eval, const submat_map_t& submat_map, const double* Z,
-					      size_t ldz, double* VXC, size_t ldvxc, double* scr ) {
+					      size_t ldz, HostSubmatAccumulator& VXC, double* scr ) {
+
+      // Update the lower triangle blocks of the destination in place
+      auto [ A, lda ] = VXC.local_target();
+      if( A and VXC.lower() and 
+          detail::use_inplace_submat( submat_map, submat_map ) ) {
+        size_t i = 0;
+        for( const auto& iCut : submat_map ) {
+          size_t j = 0;
+        for( const auto& jCut : submat_map ) {
+          auto* A_ij = A + iCut[0] + size_t(jCut[0]) * lda;
+          if( i == j ) {
+            detail::small_syr2k('L', 'N', iCut[1], npts, 1., basis_eval + i, nbe, 
+              Z + i, ldz, 1., A_ij, lda );
+          } else if( jCut[0] < iCut[0] ) {
+            detail::small_gemm( 'N', 'T', iCut[1], jCut[1], npts, 1., basis_eval + i, 
+              nbe, Z + j, ldz, 1., A_ij, lda );
+            detail::small_gemm( 'N', 'T', iCut[1], jCut[1], npts, 1., Z + i, ldz, 
+              basis_eval + j, nbe, 1., A_ij, lda );
+          }
+          j += jCut[1];
+        }
+          i += iCut[1];
+        }
+        return;
+      }
+
+      detail::small_syr2k('L', 'N', nbe, npts, 1., basis_eval, nbe, Z, ldz, 0., scr, nbe );
+
+      (void)(nbf);
+      VXC.inc( nbe, nbe, scr, nbe, submat_map );
+
+  }
+
+  void ReferenceLocalHostWorkDriver::inc_vxc_batch( size_t npts, size_t nbf, 
+    size_t nbe, const double* basis_eval, const submat_map_t& submat_map, 
+    size_t ndm, const double* Z, size_t ldz, HostSubmatAccumulator* const* VXC,
+    double* scr ) {
 
-      blas::syr2k('L', 'N', nbe, npts, 1., basis_eval, nbe, Z, ldz, 0., scr, nbe );
+      // W_k = Z_k * B**T for all k: (ndm*nbe, nbe)
+      const size_t ldw = ndm * nbe;
+      detail::small_gemm( 'N', 'T', ldw, nbe, npts, 1., Z, ldz, basis_eval, nbe, 0., 
+        scr, ldw );
 
-      detail::inc_by_submat_atomic( nbf, nbf, nbe, nbe, VXC, ldvxc, scr, nbe, submat_map );
+      (void)(nbf);
+      for( size_t k = 0; k < ndm; ++k ) {
+
+        // LT(W_k + W_k**T), the upper triangle of W_k is only read
+        auto* W = scr + k*nbe;
+        for( size_t j = 0; j < nbe; ++j ) {
+          W[j + j*ldw] *= 2.;
+          for( size_t i = j+1; i < nbe; ++i ) W[i + j*ldw] += W[j + i*ldw];
+        }
+
+        VXC[k]->inc( nbe, nbe, W, ldw, submat_map );
+
+      }
+
+  }
+
+  void ReferenceLocalHostWorkDriver::inc_vxc_mixed( size_t npts, size_t nbf, size_t nbe, 
+						    const float* basis_eval, const submat_map_t& submat_map, const double* Z,
+						    size_t ldz, HostSubmatAccumulator& VXC, float* scr ) {
+
+      auto* Z_sp   = scr;
+      auto* VXC_sp = scr + nbe*npts;
+      for( size_t j = 0; j < npts; ++j )
+      for( size_t i = 0; i < nbe;  ++i ) Z_sp[i + j*nbe] = Z[i + j*ldz];
+
+      detail::small_syr2k('L', 'N', nbe, npts, 1.f, basis_eval, nbe, Z_sp, nbe, 0.f, VXC_sp, nbe );
+
+      // Accumulate in FP64
+      (void)(nbf);
+      VXC.inc( nbe, nbe, VXC_sp, nbe, submat_map );
 
   }
 
@@ -1043,13 +1282,30 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
   void ReferenceLocalHostWorkDriver::inc_exx_k( size_t npts, size_t nbf, 
 						size_t nbe_bra, size_t nbe_ket, const double* basis_eval, 
 						const submat_map_t& submat_map_bra, const submat_map_t& submat_map_ket, 
-						const double* G, size_t ldg, double* K, size_t ldk, double* scr ) {
+						const double* G, size_t ldg, HostSubmatAccumulator& K, double* scr ) {
+
+      // Update the blocks of the destination in place
+      auto [ A, lda ] = K.local_target();
+      if( A and not K.lower() and 
+          detail::use_inplace_submat( submat_map_bra, submat_map_ket ) ) {
+        size_t i = 0;
+        for( const auto& iCut : submat_map_bra ) {
+          size_t j = 0;
+        for( const auto& jCut : submat_map_ket ) {
+          detail::small_gemm( 'N', 'T', iCut[1], jCut[1], npts, 1., basis_eval + i, 
+            nbe_bra, G + j, ldg, 1., A + iCut[0] + size_t(jCut[0]) * lda, lda );
+          j += jCut[1];
+        }
+          i += iCut[1];
+        }
+        return;
+      }
 
-      blas::gemm( 'N', 'T', nbe_bra, nbe_ket, npts, 1., basis_eval, nbe_bra,
+      detail::small_gemm( 'N', 'T', nbe_bra, nbe_ket, npts, 1., basis_eval, nbe_bra,
 		  G, ldg, 0., scr, nbe_bra );
 
-      detail::inc_by_submat_atomic( nbf, nbf, nbe_bra, nbe_ket, K, ldk, scr, nbe_bra, 
-			     submat_map_bra, submat_map_ket );
+      (void)(nbf);
+      K.inc( nbe_bra, nbe_ket, scr, nbe_bra, submat_map_bra, submat_map_ket );
 
   }
 
@@ -1064,7 +1320,12 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
     const auto* P_use = P;
     size_t ldp_use = ldp;
 
-    if( submat_map_bra.size() > 1 or submat_map_ket.size() > 1 ) {
+    const bool cut = submat_map_bra.size() > 1 or submat_map_ket.size() > 1;
+    if( cut and detail::use_inplace_submat( submat_map_bra, submat_map_ket ) ) {
+      detail::gemm_submat_a<double>( npts, 1., P, ldp, submat_map_bra, 
+        submat_map_ket, basis_eval, ldb, 0., F, ldf );
+      return;
+    } else if( cut ) {
       detail::submat_set( nbf, nbf, nbe_bra, nbe_ket, P, ldp,
 			  scr, nbe_bra, submat_map_bra, submat_map_ket );
       P_use = scr;
@@ -1073,7 +1334,7 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
       P_use = P + submat_map_ket[0][0]*ldp + submat_map_bra[0][0];
     }
 
-    blas::gemm( 'N', 'N', nbe_bra, npts, nbe_ket, 1., P_use, ldp_use, basis_eval,
+    detail::small_gemm( 'N', 'N', nbe_bra, npts, nbe_ket, 1., P_use, ldp_use, basis_eval,
 		ldb, 0., F, ldf );
 
   }
@@ -1091,7 +1352,10 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
     // Cast points to Rys format (binary compatable)
     XCPU::point* _points = 
       reinterpret_cast<XCPU::point*>(const_cast<double*>(points));
-    std::vector<double> _points_transposed(3 * npts);
+
+    // Temporaries are sliced from the scratch arena of the calling thread
+    HostScratchScope scratch( thread_scratch_arena() );
+    double* _points_transposed = scratch.allocate<double>( 3 * npts );
 
     for(size_t i = 0; i < npts; ++i) {
       _points_transposed[i + 0 * npts] = _points[i].x;
@@ -1116,10 +1380,12 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
     const size_t nbe_cart = 
       basis.nbf_cart_subset( shell_list, shell_list + nshells );
 
-    std::vector<double> X_cart, G_cart;
+    double* X_cart = nullptr;
+    double* G_cart = nullptr;
     if( any_pure ){
-      X_cart.resize( nbe_cart * npts );
-      G_cart.resize( nbe_cart * npts, 0. );
+      X_cart = scratch.allocate<double>( nbe_cart * npts );
+      G_cart = scratch.allocate<double>( nbe_cart * npts );
+      std::fill_n( G_cart, nbe_cart * npts, 0. );
 
       // Transform X into cartesian
       int ioff = 0;
@@ -1133,23 +1399,24 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
         
         if( shell.pure() and shell_l > 0 ) {
           sph_trans.itform_bra_cm( shell_l, npts, X + ioff, ldx,
-        			   X_cart.data() + ioff_cart, nbe_cart );
+        			   X_cart + ioff_cart, nbe_cart );
         } else {
           blas::lacpy( 'A', shell_sz, npts, X + ioff, ldx,
-        	       X_cart.data() + ioff_cart, nbe_cart );
+        	       X_cart + ioff_cart, nbe_cart );
         }
         ioff += shell_sz;
         ioff_cart += shell_cart_sz;
       }
     }
 
-    const auto* X_use = any_pure ? X_cart.data() : X;
-    auto*       G_use = any_pure ? G_cart.data() : G;
+    const auto* X_use = any_pure ? X_cart : X;
+    auto*       G_use = any_pure ? G_cart : G;
     const auto ldx_use = any_pure ? nbe_cart : ldx;
     const auto ldg_use = any_pure ? nbe_cart : ldg;
 
-    std::vector<double> X_cart_rm( nbe_cart*npts,0. ), 
-                        G_cart_rm( nbe_cart*npts,0. );
+    double* X_cart_rm = scratch.allocate<double>( nbe_cart*npts );
+    double* G_cart_rm = scratch.allocate<double>( nbe_cart*npts );
+    std::fill_n( G_cart_rm, nbe_cart*npts, 0. );
     for( auto i = 0ul; i < nbe_cart; ++i )
     for( auto j = 0ul; j < npts;     ++j ) {
       X_cart_rm[i*npts + j] = X_use[i + j*ldx_use];
@@ -1193,11 +1460,11 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
         auto nprim_pair     = sh_pair.nprim_pairs();
         
         XCPU::compute_integral_shell_pair( ish == jsh,
-        				   npts, _points_transposed.data(),
+        				   npts, _points_transposed,
         				   bra.l(), ket.l(), bra_origin, ket_origin,
         				   nprim_pair, prim_pair_data,
-        				   X_cart_rm.data()+ioff_cart, X_cart_rm.data()+joff_cart, npts,
-        				   G_cart_rm.data()+ioff_cart, G_cart_rm.data()+joff_cart, npts,
+        				   X_cart_rm+ioff_cart, X_cart_rm+joff_cart, npts,
+        				   G_cart_rm+ioff_cart, G_cart_rm+joff_cart, npts,
         				   const_cast<double*>(weights), this->boys_table );
         
         //joff_cart += ket_cart_sz * npts;
@@ -1227,11 +1494,11 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
       
       ndo++;  
       XCPU::compute_integral_shell_pair( ish == jsh,
-      				   npts, _points_transposed.data(),
+      				   npts, _points_transposed,
       				   bra.l(), ket.l(), bra_origin, ket_origin,
       				   nprim_pair, prim_pair_data,
-      				   X_cart_rm.data()+ioff_cart, X_cart_rm.data()+joff_cart, npts,
-      				   G_cart_rm.data()+ioff_cart, G_cart_rm.data()+joff_cart, npts,
+      				   X_cart_rm+ioff_cart, X_cart_rm+joff_cart, npts,
+      				   G_cart_rm+ioff_cart, G_cart_rm+joff_cart, npts,
       				   const_cast<double*>(weights), this->boys_table );
     }
 #endif
@@ -1255,10 +1522,10 @@ void ReferenceLocalHostWorkDriver::eval_zmat_gga_vxc_gks( size_t npts, size_t nb
         const int shell_cart_sz = shell.cart_size();
         
         if( shell.pure() and shell_l > 0 ) {
-          sph_trans.tform_bra_cm( shell_l, npts, G_cart.data() + ioff_cart, nbe_cart,
+          sph_trans.tform_bra_cm( shell_l, npts, G_cart + ioff_cart, nbe_cart,
         			  G + ioff, ldg );
         } else {
-          blas::lacpy( 'A', shell_sz, npts, G_cart.data() + ioff_cart, nbe_cart,
+          blas::lacpy( 'A', shell_sz, npts, G_cart + ioff_cart, nbe_cart,
         	       G + ioff, ldg );
         }
         ioff += shell_sz;
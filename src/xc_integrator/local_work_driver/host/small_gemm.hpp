@@ -0,0 +1,138 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include "host/blas.hpp"
+#include <cstddef>
+#include <type_traits>
+
+namespace GauXC  {
+namespace detail {
+
+/**
+ *  GEMM / SYR2K for the small dimensions of the per-task XC products
+ *
+ *  The task GEMMs are short and wide, i.e. the basis dimensions (nbe) are
+ *  small while the point dimension is up to the batch size:
+ *
+ *    X = P * B          (nbe, npts, nbe)   'N','N'  (eval_xmat / fmat)
+ *    K = B * G**T       (nbe, nbe, npts)   'N','T'  (inc_exx_k)
+ *    V = B * Z**T + h.c (nbe, npts)        'L','N'  (inc_vxc)
+ *
+ *  GEMMs are passed to BLAS. The lower SYR2K of up to small_syr2k_max_dim
+ *  basis functions is formed by the microkernels below, which keep an
+ *  (MR,NR) tile of C in registers (compile time tile sizes, MR = 8,4,2,1
+ *  and NR = 4,1) and stream the point dimension through it.
+ *
+ *  The limit follows the "Small SYR2K Timings" benchmark (host_kernels.cxx
+ *  in tests) against a single threaded OpenBLAS: the microkernels are
+ *  faster up to nbe = 24 with FMA code generation only. A limit of 0 passes
+ *  every call to BLAS.
+ */
+#ifdef __FMA__
+inline constexpr int small_syr2k_max_dim = 24;
+#else
+inline constexpr int small_syr2k_max_dim = 0;
+#endif
+
+namespace small_gemm_impl {
+
+/// Write back the lower triangle (C(r,c) with r + diag >= c) of the (MR,NR)
+/// tile
+template <int MR, int NR, typename T>
+inline void store_tile( const T (&acc)[NR][MR], T alpha, T beta, T* C,
+  int ldc, int diag ) {
+  for( int c = 0; c < NR; ++c )
+  for( int r = 0; r < MR; ++r ) {
+    if( r + diag < c ) continue;
+    auto& c_rc = C[r + size_t(c)*ldc];
+    c_rc = (beta == T(0)) ? alpha * acc[c][r] : alpha * acc[c][r] + beta * c_rc;
+  }
+}
+
+/// (MR,NR) tile of C = alpha * (A * B**T + B * A**T) + beta * C, rows of
+/// the tile start at diag rows below the diagonal (lower triangle only)
+template <int MR, int NR, typename T>
+inline void syr2k_tile( int K, T alpha, const T* A_i, const T* A_j, int lda,
+  const T* B_i, const T* B_j, int ldb, T beta, T* C, int ldc, int diag ) {
+
+  T acc[NR][MR] = {};
+  for( int k = 0; k < K; ++k ) {
+    const T* a_ik = A_i + size_t(k)*lda;
+    const T* b_ik = B_i + size_t(k)*ldb;
+    for( int c = 0; c < NR; ++c ) {
+      const T a_jk = A_j[c + size_t(k)*lda];
+      const T b_jk = B_j[c + size_t(k)*ldb];
+      #pragma omp simd
+      for( int r = 0; r < MR; ++r ) acc[c][r] += a_ik[r] * b_jk + b_ik[r] * a_jk;
+    }
+  }
+
+  store_tile<MR,NR>( acc, alpha, beta, C, ldc, diag );
+
+}
+
+/// Column panel (N-j,NR) of the lower triangle of a SYR2K starting at C(j,j)
+template <int NR, typename T>
+inline void syr2k_panel( int N, int j, int K, T alpha, const T* A, int lda,
+  const T* B, int ldb, T beta, T* C, int ldc ) {
+
+  auto tile = [&]( auto mr, int i ) {
+    constexpr int MR = decltype(mr)::value;
+    syr2k_tile<MR,NR>( K, alpha, A + i, A + j, lda, B + i, B + j, ldb, beta,
+      C + i + size_t(j)*ldc, ldc, i - j );
+  };
+
+  int i = j;
+  for( ; i + 8 <= N; i += 8 ) tile( std::integral_constant<int,8>{}, i );
+  if( i + 4 <= N ) { tile( std::integral_constant<int,4>{}, i ); i += 4; }
+  if( i + 2 <= N ) { tile( std::integral_constant<int,2>{}, i ); i += 2; }
+  if( i < N )        tile( std::integral_constant<int,1>{}, i );
+
+}
+
+/// Lower triangle of C = alpha * (A * B**T + B * A**T) + beta * C by
+/// microkernels
+template <typename T>
+void syr2k( int N, int K, T alpha, const T* A, int lda, const T* B, int ldb,
+  T beta, T* C, int ldc ) {
+
+  int j = 0;
+  for( ; j + 4 <= N; j += 4 )
+    syr2k_panel<4>( N, j, K, alpha, A, lda, B, ldb, beta, C, ldc );
+  for( ; j < N; ++j )
+    syr2k_panel<1>( N, j, K, alpha, A, lda, B, ldb, beta, C, ldc );
+
+}
+
+}
+
+/// C = alpha * op(A) * op(B) + beta * C, same interface as blas::gemm
+template <typename T>
+inline void small_gemm( char TA, char TB, int M, int N, int K, T alpha,
+  const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc ) {
+  blas::gemm( TA, TB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc );
+}
+
+/// C = alpha * (A * B**T + B * A**T) + beta * C (lower triangle), same
+/// interface as blas::syr2k
+template <typename T>
+void small_syr2k( char UPLO, char TRANS, int N, int K, T alpha,
+  const T* A, int lda, const T* B, int ldb, T beta, T* C, int ldc ) {
+
+  if( (UPLO != 'L' and UPLO != 'l') or (TRANS != 'N' and TRANS != 'n') or
+      N > small_syr2k_max_dim ) {
+    blas::syr2k( UPLO, TRANS, N, K, alpha, A, lda, B, ldb, beta, C, ldc );
+    return;
+  }
+
+  small_gemm_impl::syr2k( N, K, alpha, A, lda, B, ldb, beta, C, ldc );
+
+}
+
+}
+}
@@ -6,7 +6,9 @@
  * See LICENSE.txt for details
  */
 #pragma once
-#include "host/blas.hpp"
+#include "host/small_gemm.hpp"
+#include <algorithm>
+#include <array>
 #include <vector>
 #include <tuple>
 #include <cstdint>
@@ -59,6 +61,59 @@ void submat_set(int32_t M, int32_t N, int32_t MSub,
 
 }
 
+/// Minimum mean cut length for which submatrices are accessed in place
+inline constexpr int32_t submat_inplace_min_cut = 32;
+
+/**
+ *  Whether products with the submatrix of a big matrix given by row / column
+ *  cuts should address the cut blocks in place (one GEMM per block) rather
+ *  than pack the submatrix (one copy per block followed by one GEMM).
+ *
+ *  Fragmented maps of many short cuts are packed as per-block GEMMs would
+ *  be tiny, a few large blocks are read / written in place.
+ */
+inline bool use_inplace_submat(
+  const std::vector<std::array<int32_t,3>> &submat_map_rows,
+  const std::vector<std::array<int32_t,3>> &submat_map_cols ) {
+
+  auto mean_cut = []( const auto& submat_map ) {
+    int64_t n = 0;
+    for( auto& cut : submat_map ) n += cut[1];
+    return submat_map.size() ? n / int64_t(submat_map.size()) : int64_t(0);
+  };
+
+  return std::min( mean_cut(submat_map_rows), mean_cut(submat_map_cols) ) >= 
+    submat_inplace_min_cut;
+
+}
+
+/**
+ *  C = ALPHA * ASub * B + BETA * C, where ASub is the (MSub,NSub) submatrix 
+ *  of ABig given by row / column cuts. ASub is read in place, one GEMM per 
+ *  cut block.
+ */
+template <typename T>
+void gemm_submat_a( int32_t N, T ALPHA, const T* ABig, int32_t LDAB,
+  const std::vector<std::array<int32_t,3>> &submat_map_rows,
+  const std::vector<std::array<int32_t,3>> &submat_map_cols,
+  const T* B, int32_t LDB, T BETA, T* C, int32_t LDC ) {
+
+  int32_t i(0);
+  for( auto& iCut : submat_map_rows ) {
+    int32_t j(0);
+  for( auto& jCut : submat_map_cols ) {
+  
+    const auto* ABig_use = ABig + iCut[0] + size_t(jCut[0]) * LDAB;
+    GauXC::detail::small_gemm( 'N', 'N', iCut[1], N, jCut[1], ALPHA, ABig_use, LDAB,
+      B + j, LDB, j ? T(1) : BETA, C + i, LDC );
+
+    j += jCut[1];
+  }
+    i += iCut[1];
+  }
+
+}
+
 #if 0
 template <typename _F1, typename _F2>
 void submat_set_row_pack(int32_t M, int32_t N, int32_t MSub, 
@@ -70,6 +70,8 @@ void IncoreReplicatedXCDeviceIntegrator<ValueType>::
     this->reduction_driver_->allreduce_inplace( &N_EL, 1    , ReductionOp::Sum );
   });
 
+  this->n_el_ = N_EL;
+
 }
 
 
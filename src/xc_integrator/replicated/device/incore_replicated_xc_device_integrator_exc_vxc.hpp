@@ -211,6 +211,8 @@ void IncoreReplicatedXCDeviceIntegrator<ValueType>::
       }
     }
   }
+
+  this->n_el_ = N_EL;
 }
 
 
@@ -0,0 +1,161 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/xc_task.hpp>
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+namespace GauXC::detail {
+
+/**
+ *  Per-task cache of collocation matrices (and derivatives) for the host
+ *  integrator.
+ *
+ *  Grid, basis and shell screening are invariant across SCF iterations, so
+ *  the (ncomp * nbe * npts) basis_eval block of a task may be reused between
+ *  calls. Entries are admitted by descending XCTask::cost_exc_vxc until the
+ *  memory budget is exhausted, the remaining tasks are recomputed on every
+ *  call. Values may optionally be stored in single precision to double the
+ *  effective capacity.
+ *
+ *  Entries are keyed on task content (parent, size and first point) s.t.
+ *  reordering of the task list by other integrands does not invalidate the
+ *  cache (no entries are admitted if the keys are not unique). `prepare` is
+ *  to be called serially before the task loop, after which each slot is only
+ *  ever touched by the thread processing the corresponding task.
+ */
+template <typename F>
+class HostCollocationCache {
+
+  using key_type = std::tuple<int32_t, int32_t, int32_t, std::array<double,3>>;
+
+  struct entry_type {
+    bool                  admitted = false;
+    bool                  filled   = false;
+    size_t                size     = 0;
+    std::vector<F>        data;
+    std::vector<float>    data_sp;
+  };
+
+  std::vector<entry_type>   entries_;
+  std::map<key_type,size_t> index_;
+  std::vector<size_t>       slot_;    ///< Task position -> entry
+
+  size_t ncomp_     = 0;
+  size_t max_bytes_ = 0;
+  bool   use_fp32_  = false;
+
+  static key_type task_key( const XCTask& t ) {
+    std::array<double,3> pt0 = {0., 0., 0.};
+    if( t.points.size() ) pt0 = t.points.front();
+    return key_type( t.iParent, t.points.size(), t.bfn_screening.nbe, pt0 );
+  }
+
+public:
+
+  /// Validate / (re)build the cache for the current task set
+  template <typename TaskIterator>
+  void prepare( TaskIterator task_begin, TaskIterator task_end, size_t ncomp,
+    size_t n_deriv, size_t max_bytes, bool use_fp32 ) {
+
+    const size_t ntasks = std::distance( task_begin, task_end );
+
+    // Attempt to map the current task order onto existing entries
+    bool valid = entries_.size() == ntasks and index_.size() == ntasks and
+      ncomp == ncomp_ and max_bytes == max_bytes_ and use_fp32 == use_fp32_;
+    if( valid ) {
+      for( size_t i = 0; i < ntasks; ++i ) {
+        auto it = index_.find( task_key(*(task_begin + i)) );
+        if( it == index_.end() ) { valid = false; break; }
+        slot_[i] = it->second;
+      }
+    }
+    if( valid ) return;
+
+    // Rebuild
+    entries_.clear(); entries_.resize( ntasks );
+    index_.clear();
+    slot_.resize( ntasks );
+    ncomp_     = ncomp;
+    max_bytes_ = max_bytes;
+    use_fp32_  = use_fp32;
+
+    for( size_t i = 0; i < ntasks; ++i ) {
+      const auto& task = *(task_begin + i);
+      slot_[i] = i;
+      index_[ task_key(task) ] = i;
+      entries_[i].size = ncomp * task.points.size() * task.bfn_screening.nbe;
+    }
+
+    // Keys do not identify the tasks uniquely, disable caching
+    if( index_.size() != ntasks ) return;
+
+    // Rank tasks by cost, admit greedily under the memory budget
+    std::vector<size_t> idx( ntasks );
+    std::iota( idx.begin(), idx.end(), 0 );
+    std::stable_sort( idx.begin(), idx.end(), [&]( auto i, auto j ) {
+      return (task_begin+i)->cost_exc_vxc(n_deriv) >
+             (task_begin+j)->cost_exc_vxc(n_deriv);
+    });
+
+    const size_t word = use_fp32 ? sizeof(float) : sizeof(F);
+    size_t used = 0;
+    for( auto i : idx ) {
+      auto& e = entries_[i];
+      const size_t sz = e.size * word;
+      if( used + sz > max_bytes ) continue;
+      e.admitted = true;
+      used += sz;
+    }
+
+  }
+
+  /// Whether the task at position i is held by the cache
+  inline bool admitted( size_t i ) const { return entries_[slot_[i]].admitted; }
+
+  /// Whether the task at position i has been populated
+  inline bool filled( size_t i ) const { return entries_[slot_[i]].filled; }
+
+  /// Number of populated entries
+  inline size_t nfilled() const {
+    return std::count_if( entries_.begin(), entries_.end(),
+      []( const auto& e ) { return e.filled; } );
+  }
+
+  /// Direct (zero-copy) access to a filled FP64 entry, null for FP32 storage.
+  /// Cached data is read-only by contract
+  inline F* data( size_t i ) {
+    return use_fp32_ ? nullptr : entries_[slot_[i]].data.data();
+  }
+
+  /// Populate the entry for task i from a freshly evaluated basis_eval block
+  void store( size_t i, const F* basis_eval ) {
+    auto& e = entries_[slot_[i]];
+    if( use_fp32_ ) e.data_sp.assign( basis_eval, basis_eval + e.size );
+    else            e.data   .assign( basis_eval, basis_eval + e.size );
+    e.filled = true;
+  }
+
+  /// Expand the entry for task i into basis_eval
+  void load( size_t i, F* basis_eval ) const {
+    const auto& e = entries_[slot_[i]];
+    if( use_fp32_ ) std::copy( e.data_sp.begin(), e.data_sp.end(), basis_eval );
+    else            std::copy( e.data   .begin(), e.data   .end(), basis_eval );
+  }
+
+  /// Drop all cached data
+  inline void clear() { entries_.clear(); index_.clear(); slot_.clear(); }
+
+};
+
+}
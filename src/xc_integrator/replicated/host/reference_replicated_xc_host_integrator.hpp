@@ -8,6 +8,9 @@
 #pragma once
 #include <gauxc/xc_integrator/replicated/replicated_xc_host_integrator.hpp>
 #include "xc_host_data.hpp"
+#include "host_collocation_cache.hpp"
+#include "xc_execution_plan.hpp"
+#include "xc_incremental_state.hpp"
 
 namespace GauXC::detail {
 
@@ -28,6 +31,15 @@ public:
 
 protected:
 
+  /// Collocation retained across calls (see IntegratorSettingsKS)
+  HostCollocationCache<value_type> collocation_cache_;
+
+  /// Task order / submatrix maps of the EXC/VXC task loop retained across calls
+  XCExecutionPlan exec_plan_;
+
+  /// Retained density / potentials of incremental EXC/VXC builds
+  XCIncrementalState<value_type> incremental_state_;
+
   // Density Integration 
   void integrate_den_( int64_t m, int64_t n, const value_type* P, int64_t ldp, value_type* N_EL ) override;
 
@@ -70,6 +82,18 @@ protected:
                       value_type* VXCx, int64_t ldvxcx,
                       value_type* EXC, const IntegratorSettingsXC& ks_settings ) override;
 
+  /// Batched RKS EXC/VXC
+  void eval_exc_vxc_batch_( int64_t m, int64_t n, int64_t ndm,
+                            const value_type* const* P, int64_t ldp,
+                            value_type* const* VXC, int64_t ldvxc,
+                            value_type* EXC, const IntegratorSettingsXC& ks_settings ) override;
+
+  /// RKS XC kernel contraction
+  void eval_fxc_contraction_( int64_t m, int64_t n, const value_type* P, int64_t ldp,
+                              int64_t ntrial, const value_type* const* tP, int64_t ldtp,
+                              value_type* const* FXC, int64_t ldfxc,
+                              const IntegratorSettingsXC& ks_settings ) override;
+
 
   /// RKS EXC Gradient
   void eval_exc_grad_( int64_t m, int64_t n, const value_type* P,
@@ -96,7 +120,29 @@ protected:
                             value_type* VXCy, int64_t ldvxcy,
                             value_type* VXCx, int64_t ldvxcx,
                             value_type* EXC, value_type *N_EL, const IntegratorSettingsXC& ks_settings,
-                            task_iterator task_begin, task_iterator task_end );
+                            task_iterator task_begin, task_iterator task_end,
+                            bool symmetrize_vxc = true );
+
+  // Implementation details of the batched RKS exc_vxc
+  void exc_vxc_batch_local_work_( int64_t ndm, const value_type* const* P, int64_t ldp,
+                                  value_type* const* VXC, int64_t ldvxc,
+                                  value_type* EXC, value_type* N_EL,
+                                  const IntegratorSettingsXC& ks_settings );
+
+  // Incremental RKS EXC/VXC
+  void eval_exc_vxc_incremental_( int64_t m, int64_t n, const value_type* P, int64_t ldp,
+                                  value_type* VXC, int64_t ldvxc, value_type* EXC,
+                                  const IntegratorSettingsKS& ks_settings );
+  void exc_vxc_incremental_local_work_( const value_type* P, int64_t ldp,
+                                        value_type* dVXC, int64_t lddvxc,
+                                        value_type* dEXC, value_type* dNEL,
+                                        const IntegratorSettingsKS& ks_settings );
+
+  // Implementation details of the RKS FXC contraction
+  void fxc_contraction_local_work_( const value_type* P, int64_t ldp,
+                                    int64_t ntrial, const value_type* const* tP,
+                                    value_type* const* FXC, int64_t ldfxc,
+                                    const IntegratorSettingsXC& ks_settings );
                             
   // Implemetation details of exc_grad
   void exc_grad_local_work_( const value_type* P, int64_t ldp, value_type* EXC_GRAD );
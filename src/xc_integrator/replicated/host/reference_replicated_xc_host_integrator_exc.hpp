@@ -68,6 +68,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
   });
 
+  this->n_el_ = N_EL;
+
 }
 
 template <typename ValueType>
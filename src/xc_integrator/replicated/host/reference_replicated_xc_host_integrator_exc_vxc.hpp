@@ -9,9 +9,13 @@
 
 #include "reference_replicated_xc_host_integrator.hpp"
 #include "integrator_util/integrator_common.hpp"
+#include "integrator_util/symmetric_reduction.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host/host_accumulator.hpp"
 #include "host/blas.hpp"
+#include "xc_host_tile_pipeline.hpp"
 #include <stdexcept>
+#include <algorithm>
 
 namespace GauXC::detail {
 
@@ -62,6 +66,11 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   if( ldvxcx and ldvxcx < nbf )
     GAUXC_GENERIC_EXCEPTION("Invalid LDVXCY");
 
+  // Incremental builds are only implemented for RKS (see the RKS driver)
+  auto* ks = dynamic_cast<const IntegratorSettingsKS*>(&ks_settings);
+  if( ks and ks->incremental_vxc )
+    GAUXC_GENERIC_EXCEPTION("Incremental EXC/VXC Only Supported for RKS");
+
   // Get Tasks
   auto& tasks = this->load_balancer_->get_tasks();
 
@@ -73,7 +82,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     exc_vxc_local_work_( basis, Ps, ldps, Pz, ldpz, Py, ldpy, Px, ldpx, 
                          VXCs, ldvxcs, VXCz, ldvxcz,
                          VXCy, ldvxcy, VXCx, ldvxcx, EXC, &N_EL, ks_settings,
-                         tasks.begin(), tasks.end() );
+                         tasks.begin(), tasks.end(), false );
   });
 
 
@@ -83,16 +92,22 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     if( not this->reduction_driver_->takes_host_memory() )
       GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
 
-    this->reduction_driver_->allreduce_inplace( VXCs, nbf*nbf, ReductionOp::Sum );
-    if(VXCz) this->reduction_driver_->allreduce_inplace( VXCz, nbf*nbf, ReductionOp::Sum );
-    if(VXCy) this->reduction_driver_->allreduce_inplace( VXCy, nbf*nbf, ReductionOp::Sum ); 
-    if(VXCx) this->reduction_driver_->allreduce_inplace( VXCx, nbf*nbf, ReductionOp::Sum );
+    // Only the lower triangle of VXC has been assembled, reduce in packed
+    // storage and symmetrize
+    auto& rd = *this->reduction_driver_;
+    const int comm_size = this->load_balancer_->runtime().comm_size();
+    allreduce_symmetric_inplace( rd, comm_size, nbf, VXCs, ldvxcs );
+    if(VXCz) allreduce_symmetric_inplace( rd, comm_size, nbf, VXCz, ldvxcz );
+    if(VXCy) allreduce_symmetric_inplace( rd, comm_size, nbf, VXCy, ldvxcy );
+    if(VXCx) allreduce_symmetric_inplace( rd, comm_size, nbf, VXCx, ldvxcx );
 
     this->reduction_driver_->allreduce_inplace( EXC,   1    , ReductionOp::Sum );
     this->reduction_driver_->allreduce_inplace( &N_EL, 1    , ReductionOp::Sum );
 
   });
 
+  this->n_el_ = N_EL;
+
 
 }
 
@@ -111,7 +126,8 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
                        value_type* VXCx, int64_t ldvxcx,
                        value_type* EXC, value_type *N_EL, 
                        const IntegratorSettingsXC& settings,
-                       task_iterator task_begin, task_iterator task_end) {
+                       task_iterator task_begin, task_iterator task_end,
+                       bool symmetrize_vxc ) {
 
   const bool is_gks = (Pz != nullptr) and (Py != nullptr) and (Px != nullptr);
   const bool is_uks = (Pz != nullptr) and (Py == nullptr) and (Px == nullptr);
@@ -145,9 +161,6 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     GAUXC_GENERIC_EXCEPTION("GKS Not Yet Implemented With MGGA Functionals!");
   }
 
-  // Get basis map
-  BasisSetMap basis_map(basis,mol);
-
   const int32_t nbf = basis.nbf();
 
   // Sort tasks on size (XXX: maybe doesnt matter?)
@@ -155,8 +168,76 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
   };
 
+  // The execution plan (task order, basis map, submatrix maps) is reused
+  // when integrating over the full task list of the load balancer, other
+  // callers (e.g. shell batching) pass temporary basis subsets / tasks
   auto& tasks = this->load_balancer_->get_tasks();
-  std::sort( task_begin, task_end, task_comparator );
+  const bool use_plan = (&basis == &this->load_balancer_->basis()) and
+    task_begin == tasks.begin() and task_end == tasks.end();
+
+  std::unique_ptr<BasisSetMap> basis_map_local;
+  if( use_plan ) {
+    exec_plan_.prepare( this->load_balancer_.get(), basis, mol, task_begin,
+      task_end, task_comparator );
+  } else {
+    basis_map_local = std::make_unique<BasisSetMap>(basis,mol);
+    std::sort( task_begin, task_end, task_comparator );
+  }
+  const auto& basis_map = use_plan ? exec_plan_.basis_map() : *basis_map_local;
+
+  // Number of (npts,nbe) collocation blocks per task
+  const auto   tile_family  = xc_family( func );
+  const size_t ncomp_colloc = xc_colloc_ncomp( tile_family, needs_laplacian );
+
+  // Spin / derivative dimensions of the per-task data
+  const size_t spin_dim_scal = is_rks ? 1 : is_uks ? 2 : 4; // last case is_gks
+  const size_t sds           = is_rks ? 1 : 2;
+  const size_t gga_dim_scal  = is_rks ? 1 : 3;
+  const size_t mgga_dim_scal = func.is_mgga() ? 4 : 1; // basis + d1basis
+
+  // Setup collocation cache
+  const bool use_colloc_cache = ks_settings.cache_collocation;
+  if( use_colloc_cache ) {
+    // Derivative order of the collocation (cost heuristic)
+    const size_t colloc_deriv = needs_laplacian ? 2 : (func.is_lda() ? 0 : 1);
+    collocation_cache_.prepare( task_begin, task_end, ncomp_colloc, colloc_deriv,
+      ks_settings.collocation_cache_bytes, ks_settings.collocation_cache_fp32 );
+  }
+
+  const bool mixed_precision = ks_settings.mixed_precision;
+
+  // Shell pair norms of the densities for block sparse X matrices
+  const double xmat_block_tol    = ks_settings.xmat_block_tol;
+  const bool   xmat_block_sparse = xmat_block_tol > 0. and not mixed_precision;
+  const int32_t nshells_bas = basis.nshells();
+  std::vector<double> P_shell_norms;
+  if( xmat_block_sparse ) {
+    P_shell_norms.assign( size_t(nshells_bas) * nshells_bas, 0. );
+    for( auto [P, ldp] : { std::make_pair(Ps, ldps), std::make_pair(Pz, ldpz),
+                           std::make_pair(Py, ldpy), std::make_pair(Px, ldpx) } )
+    if( P ) shell_block_max_abs( basis_map, nshells_bas, P, ldp, 
+      P_shell_norms.data() );
+  }
+
+  // Density screening is only performed for RKS / UKS
+  const bool screen_density = ks_settings.screen_density and not is_gks;
+  const double density_tol  = ks_settings.density_tol;
+
+  // Point tiled pipeline, specialized on the functional family and spin
+  const bool use_tile_pipeline = ks_settings.xc_tile_bytes > 0 and
+    not is_gks and not screen_density;
+  const auto tile_spin = is_rks ? XCSpin::RKS : XCSpin::UKS;
+
+  // Generate sub-tile shell significance masks (persist on the tasks)
+  const bool use_tile_mask = ks_settings.screen_collocation_tiles;
+  if( use_tile_mask ) {
+    const size_t ntasks = std::distance(task_begin, task_end);
+    #pragma omp parallel for schedule(dynamic)
+    for( size_t iT = 0; iT < ntasks; ++iT ) {
+      auto& task = *(task_begin + iT);
+      if( not task.has_shell_tile_mask() ) task.generate_shell_tile_mask( basis );
+    }
+  }
 
 
   // Check that Partition Weights have been calculated
@@ -197,37 +278,195 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   // Loop over tasks
   const size_t ntasks = std::distance(task_begin, task_end);
 
+  // VXC accumulators
+  // (the accumulation budget is shared by the VXC components)
+  std::vector<std::unique_ptr<HostSubmatAccumulator>> vxc_acc;
+  const size_t nvxc = (VXCs != nullptr) + (VXCz != nullptr) +
+                      (VXCy != nullptr) + (VXCx != nullptr);
+  const size_t acc_bytes = ks_settings.accumulation_bytes /
+                           std::max( nvxc, size_t(1) );
+  auto make_acc = [&]( value_type* VXC, int64_t ldvxc ) {
+    if( not VXC ) return (HostSubmatAccumulator*)nullptr;
+    vxc_acc.emplace_back( std::make_unique<HostSubmatAccumulator>(
+      ks_settings.accumulation, nbf, nbf, VXC, ldvxc, acc_bytes, true ) );
+    return vxc_acc.back().get();
+  };
+  auto* VXCs_acc = make_acc( VXCs, ldvxcs );
+  auto* VXCz_acc = make_acc( VXCz, ldvxcz );
+  auto* VXCy_acc = make_acc( VXCy, ldvxcy );
+  auto* VXCx_acc = make_acc( VXCx, ldvxcx );
+  HostSubmatAccumulator* VXC_spin[] = { VXCs_acc, VXCz_acc, VXCy_acc, VXCx_acc };
+
+  // Group consecutive small tasks (tasks are sorted on decreasing cost) for
+  // a single functional evaluation, the group boundaries are
+  // [task_groups[i], task_groups[i+1])
+  const size_t func_batch_npts = (use_tile_pipeline and not mixed_precision) ?
+    ks_settings.xc_func_batch_npts : 0;
+  auto is_small_task = [&]( size_t iT ) {
+    return (task_begin + iT)->points.size() < func_batch_npts;
+  };
+  std::vector<size_t> task_groups = { 0 };
+  size_t max_group_size = 1;
+  for( size_t iT = 0; iT < ntasks; ) {
+    size_t iT_end   = iT + 1;
+    size_t npts_grp = (task_begin + iT)->points.size();
+    if( is_small_task(iT) )
+    while( iT_end < ntasks and is_small_task(iT_end) and 
+           npts_grp < func_batch_npts and 
+           iT_end - iT < xc_func_batch_max_tasks )
+      npts_grp += (task_begin + iT_end++)->points.size();
+    max_group_size = std::max( max_group_size, iT_end - iT );
+    task_groups.emplace_back( iT = iT_end );
+  }
+  const size_t ngroups = task_groups.size() - 1;
+
+  // Scratch high water marks of the host data of the first task of every
+  // group (host_data_pool[0], any task) and of the remaining tasks of the
+  // groups (host_data_pool[k > 0], small tasks), and the number of points
+  // of the largest group
+  struct scratch_marks { size_t npts = 0, nbe = 0, npts_x_nbe = 0; };
+  scratch_marks lead_marks, member_marks;
+  size_t max_group_npts = 0, ntasks_grouped = 0;
+  for( size_t iG = 0; iG < ngroups; ++iG ) {
+    size_t npts_grp = 0;
+    for( size_t iT = task_groups[iG]; iT < task_groups[iG+1]; ++iT ) {
+      const auto& task = *(task_begin + iT);
+      const size_t npts = task.points.size();
+      const size_t nbe  = task.bfn_screening.nbe;
+      auto& m = iT == task_groups[iG] ? lead_marks : member_marks;
+      m.npts       = std::max( m.npts, npts );
+      m.nbe        = std::max( m.nbe,  nbe  );
+      m.npts_x_nbe = std::max( m.npts_x_nbe, npts * nbe );
+      npts_grp += npts;
+    }
+    if( task_groups[iG+1] - task_groups[iG] > 1 ) {
+      max_group_npts = std::max( max_group_npts, npts_grp );
+      ntasks_grouped += task_groups[iG+1] - task_groups[iG];
+    }
+  }
+
+  // Arena bytes for the scratch of a task, i.e. the collocation, Z, 
+  // nbe x nbe scratch, per-point U/V variables and (if enabled) the 
+  // screened weights and FP32 operands
+  auto scratch_bytes = [&]( const scratch_marks& m ) {
+    const size_t basis_sz = ncomp_colloc * m.npts_x_nbe;
+    const size_t zmat_sz  = spin_dim_scal * mgga_dim_scal * m.npts_x_nbe +
+      (is_gks ? 6 * m.npts : 0);
+    const size_t nbe_sz   = spin_dim_scal * m.nbe * m.nbe;
+    const size_t sp_sz    = mgga_dim_scal * m.npts_x_nbe;
+    const size_t sp_scr_sz = m.nbe * m.nbe + mgga_dim_scal * m.npts_x_nbe;
+
+    auto slice = []( size_t bytes ) {
+      return HostScratchArena::slice_bytes( bytes );
+    };
+    size_t bytes = slice( sizeof(value_type) * basis_sz ) +
+      slice( sizeof(value_type) * zmat_sz ) +
+      slice( sizeof(value_type) * nbe_sz  ) +
+      xc_point_buffer_bytes<value_type>( tile_family, spin_dim_scal,
+        gga_dim_scal, needs_laplacian, m.npts );
+    if( screen_density )
+      bytes += slice( sizeof(value_type) * m.npts );
+    if( mixed_precision )
+      bytes += slice( sizeof(float) * sp_sz ) +
+               slice( sizeof(float) * sp_scr_sz );
+    return bytes;
+  };
+
+  // Cache entries filled by previous calls are reused by this call
+  const size_t ncache_filled = use_colloc_cache ? 
+    collocation_cache_.nfilled() : 0;
+  size_t npts_screened = 0;
+
   #pragma omp parallel
   {
 
-  XCHostData<value_type> host_data; // Thread local host data
+  // Thread local host data, one per task of a group
+  std::vector<XCHostData<value_type>> host_data_pool( max_group_size );
+
+  // Size the arenas of the pool (and of the group functional evaluation)
+  // up front. Every task re-slices its buffers from the start of the
+  // arena, i.e. no further memory is allocated during the integration.
+  host_data_pool[0].arena->reserve( scratch_bytes( lead_marks ) );
+  for( size_t k = 1; k < max_group_size; ++k )
+    host_data_pool[k].arena->reserve( scratch_bytes( member_marks ) );
+
+  // Functional, Z matrices and VXC of a group whose U variables are
+  // stored in group_data (tasks [iT_begin, iT_begin + group_data.size()))
+  XCHostData<value_type> func_batch_data;
+  if( max_group_npts )
+    func_batch_data.arena->reserve( xc_point_buffer_bytes<value_type>( 
+      tile_family, spin_dim_scal, gga_dim_scal, needs_laplacian, 
+      max_group_npts ) );
+  std::vector<XCTaskTileData> group_data;
+  group_data.reserve( max_group_size );
+  auto eval_task_group = [&]( size_t iT_begin ) {
+    const size_t ngrp = group_data.size();
+    func_batch_data.release_scratch();
+    double EXC_local = 0.0;
+    double NEL_local = 0.0;
+    xc_family_spin_dispatch( tile_family, tile_spin, [&]( auto fam, auto spin ) {
+      constexpr auto F = decltype(fam)::value;
+      constexpr auto S = decltype(spin)::value;
+      xc_task_functional_batch<F,S>( func, group_data.data(), ngrp, 
+        needs_laplacian, func_batch_data );
+      for( const auto& d : group_data )
+        xc_task_zmat<F,S>( lwd, d, needs_laplacian, not is_exc_only, 
+          EXC_local, NEL_local );
+    });
+
+    #pragma omp atomic
+    EXC_WORK += EXC_local;
+    #pragma omp atomic
+    NEL_WORK += NEL_local;
+
+    if( not is_exc_only )
+    for( size_t k = 0; k < ngrp; ++k ) {
+      const auto& d  = group_data[k];
+      auto& host_data = host_data_pool[k];
+      const auto& submat_map = use_plan ? exec_plan_.submat_map(iT_begin + k) : 
+                                          host_data.submat_map;
+      const size_t ncol = (func.is_mgga() ? 4 : 1) * d.npts;
+      if( is_rks )
+        lwd->inc_vxc( ncol, nbf, d.nbe, d.basis, submat_map, d.zmat, d.ldz,
+          *VXCs_acc, host_data.nbe_scr.data() );
+      else
+        lwd->inc_vxc_batch( ncol, nbf, d.nbe, d.basis, submat_map, 2, d.zmat,
+          d.ldz, VXC_spin, host_data.nbe_scr.data() );
+    }
+    group_data.clear();
+  };
 
   #pragma omp for schedule(dynamic)
-  for( size_t iT = 0; iT < ntasks; ++iT ) {
+  for( size_t iG = 0; iG < ngroups; ++iG ) 
+  for( size_t iT = task_groups[iG]; iT < task_groups[iG+1]; ++iT ) {
+
+    // Tasks of a group are evaluated with separate host data
+    const bool grouped   = task_groups[iG+1] - task_groups[iG] > 1;
+    auto&      host_data = host_data_pool[iT - task_groups[iG]];
+
+    // The buffers of the task are re-sliced from the start of the arena
+    host_data.release_scratch();
      
     //std::cout << iT << "/" << ntasks << std::endl;
     //if(is_exc_only) printf("%lu / %lu\n", iT, ntasks);
     // Alias current task
     const auto& task = *(task_begin + iT);
 
-    // Get tasks constants
-    const int32_t  npts    = task.points.size();
+    // Get tasks constants (npts may be reduced by density screening)
+    int32_t        npts    = task.points.size();
     const int32_t  nbe     = task.bfn_screening.nbe;
     const int32_t  nshells = task.bfn_screening.shell_list.size();
 
-    const auto* points      = task.points.data()->data();
     const auto* weights     = task.weights.data();
     const int32_t* shell_list = task.bfn_screening.shell_list.data();
+    const uint64_t* tile_mask = use_tile_mask ? task.shell_tile_mask.data() : nullptr;
 
     // Allocate enough memory for batch
    
-    const size_t spin_dim_scal = is_rks ? 1 : is_uks ? 2 : 4; // last case is_gks
-    const size_t sds          = is_rks ? 1 : 2;
     const size_t gks_mod_KH = is_gks ? 6*npts : 0; // used to store H and H
-    const size_t mgga_dim_scal = func.is_mgga() ? 4 : 1; // basis + d1basis
 
     // Things that every calc needs
-    host_data.nbe_scr .resize(nbe  * nbe);
+    host_data.nbe_scr .resize(nbe  * nbe * spin_dim_scal);
     host_data.zmat    .resize(npts * nbe * spin_dim_scal * mgga_dim_scal + gks_mod_KH); 
     host_data.eps     .resize(npts);
     host_data.vrho    .resize(npts * spin_dim_scal);
@@ -239,7 +478,6 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     }
      
     // GGA data requirements
-    const size_t gga_dim_scal = is_rks ? 1 : 3;
     if( func.is_gga() ){
       host_data.basis_eval .resize( 4 * npts * nbe );
       host_data.den_scr    .resize( spin_dim_scal * 4 * npts );
@@ -249,7 +487,7 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
 
     if( func.is_mgga() ){
       if ( needs_laplacian ) {
-        host_data.basis_eval .resize( 11 * npts * nbe ); // basis + grad (3) + hess (6) + lapl 
+        host_data.basis_eval .resize( 5 * npts * nbe ); // basis + grad (3) + lapl 
         host_data.lapl       .resize( spin_dim_scal * npts );
         host_data.vlapl      .resize( spin_dim_scal * npts );
       } else {
@@ -263,21 +501,34 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       host_data.vtau       .resize( npts * spin_dim_scal );
     }
 
+    if( mixed_precision ) {
+      host_data.basis_eval_sp.resize( mgga_dim_scal * npts * nbe );
+      host_data.sp_scr       .resize( nbe * (nbe + mgga_dim_scal * npts) );
+    }
+
+    // Evaluate Collocation (+ Grad and Laplacian), cached collocation is
+    // either used in place (FP64) or expanded into scratch (FP32)
+    auto* basis_eval = xc_task_collocation( lwd, basis, task, iT, tile_family,
+      needs_laplacian, tile_mask, use_colloc_cache ? &collocation_cache_ : 
+      nullptr, host_data.basis_eval.data() );
+
     // Alias/Partition out scratch memory
-    auto* basis_eval = host_data.basis_eval.data();
     auto* den_eval   = host_data.den_scr.data();
     auto* nbe_scr    = host_data.nbe_scr.data();
     auto* zmat       = host_data.zmat.data();
 
+    // The X/Z matrices of the spin components are stored side by side,
+    // i.e. rows [k*nbe, (k+1)*nbe) of a (spin_dim_scal*nbe, *) matrix
+    const int32_t ldz = spin_dim_scal * nbe;
     decltype(zmat) zmat_z = nullptr;
     decltype(zmat) zmat_x = nullptr;
     decltype(zmat) zmat_y = nullptr;
     if(!is_rks) {
-      zmat_z = zmat + mgga_dim_scal * nbe * npts;
+      zmat_z = zmat + nbe;
     }
     if(is_gks) {
-      zmat_x = zmat_z + nbe * npts;
-      zmat_y = zmat_x + nbe * npts;
+      zmat_x = zmat_z + nbe;
+      zmat_y = zmat_x + nbe;
     }
      
     auto* eps        = host_data.eps.data();
@@ -293,12 +544,6 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     value_type* dbasis_x_eval = nullptr;
     value_type* dbasis_y_eval = nullptr;
     value_type* dbasis_z_eval = nullptr;
-    value_type* d2basis_xx_eval = nullptr;
-    value_type* d2basis_xy_eval = nullptr;
-    value_type* d2basis_xz_eval = nullptr;
-    value_type* d2basis_yy_eval = nullptr;
-    value_type* d2basis_yz_eval = nullptr;
-    value_type* d2basis_zz_eval = nullptr;
     value_type* lbasis_eval = nullptr;
     value_type* dden_x_eval = nullptr;
     value_type* dden_y_eval = nullptr;
@@ -330,114 +575,225 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       dden_x_eval   = den_eval    + spin_dim_scal * npts;
       dden_y_eval   = dden_x_eval + spin_dim_scal * npts;
       dden_z_eval   = dden_y_eval + spin_dim_scal * npts;
-      mmat_x        = zmat + npts * nbe;
-      mmat_y        = mmat_x + npts * nbe;
-      mmat_z        = mmat_y + npts * nbe;
+      mmat_x        = zmat + npts * ldz;
+      mmat_y        = mmat_x + npts * ldz;
+      mmat_z        = mmat_y + npts * ldz;
       if ( needs_laplacian ) {
-        d2basis_xx_eval = dbasis_z_eval + npts * nbe;
-        d2basis_xy_eval = d2basis_xx_eval + npts * nbe;
-        d2basis_xz_eval = d2basis_xy_eval + npts * nbe;
-        d2basis_yy_eval = d2basis_xz_eval + npts * nbe;
-        d2basis_yz_eval = d2basis_yy_eval + npts * nbe;
-        d2basis_zz_eval = d2basis_yz_eval + npts * nbe;
-        lbasis_eval     = d2basis_zz_eval + npts * nbe;
+        lbasis_eval     = dbasis_z_eval + npts * nbe;
       }
       if(is_uks) {
-        mmat_x_z = zmat_z + npts * nbe;
-        mmat_y_z = mmat_x_z + npts * nbe;
-        mmat_z_z = mmat_y_z + npts * nbe;
+        mmat_x_z = zmat_z + npts * ldz;
+        mmat_y_z = mmat_x_z + npts * ldz;
+        mmat_z_z = mmat_y_z + npts * ldz;
       }
     }
 
 
     // Get the submatrix map for batch
-    std::vector< std::array<int32_t, 3> > submat_map;
-    std::tie(submat_map, std::ignore) =
-          gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
+    if( not use_plan )
+      std::tie(host_data.submat_map, std::ignore) =
+        gen_compressed_submat_map(basis_map, task.bfn_screening.shell_list, nbf, nbf);
+    const auto& submat_map = use_plan ? exec_plan_.submat_map(iT) : 
+                                        host_data.submat_map;
+
+    // Round the GEMM operands of the collocation matrix to FP32
+    float* basis_eval_sp = nullptr;
+    if( mixed_precision ) {
+      basis_eval_sp = host_data.basis_eval_sp.data();
+      std::copy_n( basis_eval, mgga_dim_scal * npts * nbe, basis_eval_sp );
+    }
 
-    // Evaluate Collocation (+ Grad and Hessian)
-    if( func.is_mgga() ) {
-      if ( needs_laplacian ) {
-        // TODO: Modify gau2grid to compute Laplacian instead of full hessian
-        lwd->eval_collocation_hessian( npts, nshells, nbe, points, basis, shell_list,
-          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval, d2basis_xx_eval,
-          d2basis_xy_eval, d2basis_xz_eval, d2basis_yy_eval, d2basis_yz_eval,
-          d2basis_zz_eval);
-        blas::lacpy( 'A', nbe, npts, d2basis_xx_eval, nbe, lbasis_eval, nbe );
-        blas::axpy( nbe * npts, 1., d2basis_yy_eval, 1, lbasis_eval, 1);
-        blas::axpy( nbe * npts, 1., d2basis_zz_eval, 1, lbasis_eval, 1);
+    // X = fac * P * B, Z**T * B + h.c. for all spin components. In FP64
+    // the spin components are handled by a single GEMM each
+    const value_type* P_spin[] = { Ps, Pz, Py, Px };
+    const int64_t   ldp_spin[] = { ldps, ldpz, ldpy, ldpx };
+    const bool batch_xmat = not is_rks and std::all_of( ldp_spin, 
+      ldp_spin + spin_dim_scal, [&]( int64_t ld ){ return ld == ldps; } );
+    auto eval_xmat = [&]( size_t ncol, double fac, value_type* X ) {
+      if( mixed_precision ) {
+        for( size_t k = 0; k < spin_dim_scal; ++k )
+          lwd->eval_xmat_mixed( ncol, nbf, nbe, submat_map, fac, P_spin[k], 
+            ldp_spin[k], basis_eval_sp, nbe, X + k*nbe, ldz, 
+            host_data.sp_scr.data() );
+      } else if( xmat_block_sparse ) {
+        for( size_t k = 0; k < spin_dim_scal; ++k )
+          lwd->eval_xmat_block_sparse( ncol, nbf, nbe, submat_map, nshells, 
+            shell_list, basis_map, P_shell_norms.data(), nshells_bas, 
+            xmat_block_tol, fac, P_spin[k], ldp_spin[k], basis_eval, nbe, 
+            X + k*nbe, ldz, nbe_scr );
+      } else if( batch_xmat ) {
+        lwd->eval_xmat_batch( ncol, nbf, nbe, submat_map, spin_dim_scal, fac,
+          P_spin, ldps, basis_eval, nbe, X, ldz, nbe_scr );
       } else {
-        lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
-          basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
+        for( size_t k = 0; k < spin_dim_scal; ++k )
+          lwd->eval_xmat( ncol, nbf, nbe, submat_map, fac, P_spin[k], 
+            ldp_spin[k], basis_eval, nbe, X + k*nbe, ldz, nbe_scr );
       }
-    }
-    // Evaluate Collocation (+ Grad)
-    else if( func.is_gga() )
-      lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, shell_list,
-        basis_eval, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval );
-    else
-      lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list,
-        basis_eval );
-
+    };
+    auto inc_vxc = [&]( size_t ncol, const value_type* Z ) {
+      if( mixed_precision ) {
+        for( size_t k = 0; k < spin_dim_scal; ++k )
+          lwd->inc_vxc_mixed( ncol, nbf, nbe, basis_eval_sp, submat_map, 
+            Z + k*nbe, ldz, *VXC_spin[k], host_data.sp_scr.data() );
+      } else if( is_rks )
+        lwd->inc_vxc( ncol, nbf, nbe, basis_eval, submat_map, Z, ldz, 
+          *VXCs_acc, nbe_scr );
+      else
+        lwd->inc_vxc_batch( ncol, nbf, nbe, basis_eval, submat_map, 
+          spin_dim_scal, Z, ldz, VXC_spin, nbe_scr );
+    };
      
     // Evaluate X matrix (fac * P * B) -> store in Z
     const auto xmat_fac = is_rks ? 2.0 : 1.0; // TODO Fix for spinor RKS input
-    lwd->eval_xmat( mgga_dim_scal * npts, nbf, nbe, submat_map, xmat_fac, Ps, ldps, basis_eval, nbe,
-      zmat, nbe, nbe_scr );
-		
-
-    // X matrix for Pz
-    if(not is_rks) {
-      lwd->eval_xmat( mgga_dim_scal * npts, nbf, nbe, submat_map, 1.0, Pz, ldpz, basis_eval, nbe,
-        zmat_z, nbe, nbe_scr);
-    }
-     
-    if(is_gks) {
-      lwd->eval_xmat( npts, nbf, nbe, submat_map, 1.0, Py, ldpy, basis_eval, nbe,
-        zmat_x, nbe, nbe_scr);
-      lwd->eval_xmat( npts, nbf, nbe, submat_map, 1.0, Px, ldpx, basis_eval, nbe,
-        zmat_y, nbe, nbe_scr);
+    eval_xmat( mgga_dim_scal * npts, xmat_fac, zmat );
+
+    // Point tiled U/V variables -> functional -> Z matrix
+    if( use_tile_pipeline ) {
+      XCTaskTileData tile_data;
+      xc_family_spin_dispatch( tile_family, tile_spin, [&]( auto fam, auto spin ) {
+        tile_data = xc_task_data<decltype(fam)::value, decltype(spin)::value>(
+          npts, nbe, weights, basis_eval, zmat, ldz, needs_laplacian, 
+          host_data );
+      });
+
+      // Collocation + X/Z (M) matrices + per-point scalars of one point
+      const size_t tile_pt_bytes = sizeof(value_type) *
+        (ncomp_colloc * nbe + mgga_dim_scal * ldz + 32);
+      const int32_t tile_npts = xc_tile_npts( ks_settings.xc_tile_bytes,
+        tile_pt_bytes, npts );
+
+      // Small tasks: U variables now, the remainder with the whole group
+      if( grouped ) {
+        xc_family_spin_dispatch( tile_family, tile_spin, [&]( auto fam, auto spin ) {
+          xc_task_uvvar<decltype(fam)::value, decltype(spin)::value>( lwd, 
+            tile_data );
+        });
+        group_data.emplace_back( tile_data );
+        if( iT + 1 == task_groups[iG+1] ) eval_task_group( task_groups[iG] );
+        continue;
+      }
+
+      double EXC_local = 0.0;
+      double NEL_local = 0.0;
+      xc_family_spin_dispatch( tile_family, tile_spin, [&]( auto fam, auto spin ) {
+        xc_task_tile_pipeline<decltype(fam)::value, decltype(spin)::value>( 
+          lwd, func, tile_data, tile_npts, needs_laplacian, not is_exc_only,
+          EXC_local, NEL_local );
+      });
+
+      #pragma omp atomic
+      EXC_WORK += EXC_local;
+      #pragma omp atomic
+      NEL_WORK += NEL_local;
+
+      if( not is_exc_only ) inc_vxc( mgga_dim_scal * npts, zmat );
+      continue;
     }
-     
+
     // Evaluate U and V variables
     if( func.is_mgga() ) {
       if (is_rks) {
         lwd->eval_uvvar_mgga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, lbasis_eval, zmat, nbe, mmat_x, mmat_y, mmat_z, 
-          nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval, gamma, tau, lapl);
+          dbasis_z_eval, lbasis_eval, zmat, ldz, mmat_x, mmat_y, mmat_z, 
+          ldz, den_eval, dden_x_eval, dden_y_eval, dden_z_eval, gamma, tau, lapl);
       } else if (is_uks) {
         lwd->eval_uvvar_mgga_uks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, lbasis_eval, zmat, nbe, zmat_z, nbe, 
-          mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe, 
+          dbasis_z_eval, lbasis_eval, zmat, ldz, zmat_z, ldz, 
+          mmat_x, mmat_y, mmat_z, ldz, mmat_x_z, mmat_y_z, mmat_z_z, ldz, 
           den_eval, dden_x_eval, dden_y_eval, dden_z_eval, gamma, tau, lapl);
       }
     } else if ( func.is_gga() ) {
       if(is_rks) {
         lwd->eval_uvvar_gga_rks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, zmat, nbe, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
+          dbasis_z_eval, zmat, ldz, den_eval, dden_x_eval, dden_y_eval, dden_z_eval,
           gamma );
       } else if(is_uks) {
         lwd->eval_uvvar_gga_uks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, zmat, nbe, zmat_z, nbe, den_eval, dden_x_eval, 
+          dbasis_z_eval, zmat, ldz, zmat_z, ldz, den_eval, dden_x_eval, 
           dden_y_eval, dden_z_eval, gamma );
       } else if(is_gks) {
         lwd->eval_uvvar_gga_gks( npts, nbe, basis_eval, dbasis_x_eval, dbasis_y_eval,
-          dbasis_z_eval, zmat, nbe, zmat_z, nbe, zmat_x, nbe, zmat_y, nbe, den_eval, dden_x_eval,
+          dbasis_z_eval, zmat, ldz, zmat_z, ldz, zmat_x, ldz, zmat_y, ldz, den_eval, dden_x_eval,
           dden_y_eval, dden_z_eval, gamma, K, H, gks_dtol );
       }
        
      } else {
       if(is_rks) {
-        lwd->eval_uvvar_lda_rks( npts, nbe, basis_eval, zmat, nbe, den_eval );
+        lwd->eval_uvvar_lda_rks( npts, nbe, basis_eval, zmat, ldz, den_eval );
       } else if(is_uks) {
-        lwd->eval_uvvar_lda_uks( npts, nbe, basis_eval, zmat, nbe, zmat_z, nbe,
+        lwd->eval_uvvar_lda_uks( npts, nbe, basis_eval, zmat, ldz, zmat_z, ldz,
           den_eval );
       } else if(is_gks) {
-        lwd->eval_uvvar_lda_gks( npts, nbe, basis_eval, zmat, nbe, zmat_z, nbe,
-          zmat_x, nbe, zmat_y, nbe, den_eval, K, gks_dtol );
+        lwd->eval_uvvar_lda_gks( npts, nbe, basis_eval, zmat, ldz, zmat_z, ldz,
+          zmat_x, ldz, zmat_y, ldz, den_eval, K, gks_dtol );
       }
      }
     
+    // Gather the points with significant density into a dense sub-batch,
+    // the remaining points do not contribute to EXC/VXC
+    if( screen_density ) {
+      auto& sig = host_data.point_idx;
+      sig.clear();
+      for( int32_t i = 0; i < npts; ++i ) {
+        const auto den = is_rks ? den_eval[i] : (den_eval[2*i] + den_eval[2*i+1]);
+        if( den > density_tol ) sig.emplace_back(i);
+      }
+      const int32_t nsig = sig.size();
+      #pragma omp atomic
+      npts_screened += npts - nsig;
+
+      if( nsig < npts ) {
+        // In-place safe (forward) gather of per-point data in nblk blocks
+        auto gather = [&]( const auto* src, auto* dst, int32_t nblk, 
+          int32_t stride ) {
+          for( int32_t b = 0; b < nblk; ++b )
+          for( int32_t k = 0; k < nsig; ++k )
+            std::copy_n( src + (size_t(b)*npts + sig[k])*stride, stride,
+              dst + (size_t(b)*nsig + k)*stride );
+        };
+
+        host_data.weights_scr.resize( nsig );
+        gather( weights, host_data.weights_scr.data(), 1, 1 );
+        weights = host_data.weights_scr.data();
+
+        // Cached collocation is read-only, gather into scratch
+        gather( basis_eval, host_data.basis_eval.data(), ncomp_colloc, nbe );
+        basis_eval = host_data.basis_eval.data();
+        if( mixed_precision )
+          gather( basis_eval_sp, basis_eval_sp, mgga_dim_scal, nbe );
+
+        const int32_t nden_blk = func.is_lda() ? 1 : 4;
+        gather( den_eval, den_eval, nden_blk, sds );
+        if( not func.is_lda() ) gather( gamma, gamma, 1, gga_dim_scal );
+        if( func.is_mgga() ) {
+          gather( tau, tau, 1, spin_dim_scal );
+          if( needs_laplacian ) gather( lapl, lapl, 1, spin_dim_scal );
+        }
+
+        // Re-alias point dependent partitions of scratch
+        npts = nsig;
+        if( not func.is_lda() ) {
+          dbasis_x_eval = basis_eval    + npts * nbe;
+          dbasis_y_eval = dbasis_x_eval + npts * nbe;
+          dbasis_z_eval = dbasis_y_eval + npts * nbe;
+          dden_x_eval   = den_eval    + spin_dim_scal * npts;
+          dden_y_eval   = dden_x_eval + spin_dim_scal * npts;
+          dden_z_eval   = dden_y_eval + spin_dim_scal * npts;
+        }
+        if( func.is_mgga() ) {
+          mmat_x = zmat + npts * ldz;
+          mmat_y = mmat_x + npts * ldz;
+          mmat_z = mmat_y + npts * ldz;
+          if( needs_laplacian ) lbasis_eval = dbasis_z_eval + npts * nbe;
+          if( is_uks ) {
+            mmat_x_z = zmat_z + npts * ldz;
+            mmat_y_z = mmat_x_z + npts * ldz;
+            mmat_z_z = mmat_y_z + npts * ldz;
+          }
+        }
+      }
+    }
+
     // Evaluate XC functional
     if( func.is_mgga() )
       func.eval_exc_vxc( npts, den_eval, gamma, lapl, tau, eps, vrho, vgamma, vlapl, vtau);
@@ -505,93 +861,75 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
       if(is_rks) {
         lwd->eval_zmat_mgga_vxc_rks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
                                      dbasis_y_eval, dbasis_z_eval, lbasis_eval,
-                                     dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe);
+                                     dden_x_eval, dden_y_eval, dden_z_eval, zmat, ldz);
         lwd->eval_mmat_mgga_vxc_rks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
-                                     mmat_x, mmat_y, mmat_z, nbe);
+                                     mmat_x, mmat_y, mmat_z, ldz);
       } else if (is_uks) {
         lwd->eval_zmat_mgga_vxc_uks( npts, nbe, vrho, vgamma, vlapl, basis_eval, dbasis_x_eval,
                                      dbasis_y_eval, dbasis_z_eval, lbasis_eval,
-                                     dden_x_eval, dden_y_eval, dden_z_eval, zmat, nbe, zmat_z, nbe);
+                                     dden_x_eval, dden_y_eval, dden_z_eval, zmat, ldz, zmat_z, ldz);
         lwd->eval_mmat_mgga_vxc_uks( npts, nbe, vtau, vlapl, dbasis_x_eval, dbasis_y_eval, dbasis_z_eval,
-                                     mmat_x, mmat_y, mmat_z, nbe, mmat_x_z, mmat_y_z, mmat_z_z, nbe);
+                                     mmat_x, mmat_y, mmat_z, ldz, mmat_x_z, mmat_y_z, mmat_z_z, ldz);
       }
     }
     else if( func.is_gga() ) {
       if(is_rks) {
         lwd->eval_zmat_gga_vxc_rks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
                                 dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe);
+                                dden_z_eval, zmat, ldz);
       } else if(is_uks) {
         lwd->eval_zmat_gga_vxc_uks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
                                 dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe, zmat_z, nbe);
+                                dden_z_eval, zmat, ldz, zmat_z, ldz);
       } else if(is_gks) {
         lwd->eval_zmat_gga_vxc_gks( npts, nbe, vrho, vgamma, basis_eval, dbasis_x_eval,
                                 dbasis_y_eval, dbasis_z_eval, dden_x_eval, dden_y_eval,
-                                dden_z_eval, zmat, nbe, zmat_z, nbe, zmat_x, nbe, zmat_y, nbe,
+                                dden_z_eval, zmat, ldz, zmat_z, ldz, zmat_x, ldz, zmat_y, ldz,
                                 K, H);
       }
        
     } else {
       if(is_rks) {
-        lwd->eval_zmat_lda_vxc_rks( npts, nbe, vrho, basis_eval, zmat, nbe );
+        lwd->eval_zmat_lda_vxc_rks( npts, nbe, vrho, basis_eval, zmat, ldz );
       } else if(is_uks) {
-        lwd->eval_zmat_lda_vxc_uks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe );
+        lwd->eval_zmat_lda_vxc_uks( npts, nbe, vrho, basis_eval, zmat, ldz, zmat_z, ldz );
       } else if(is_gks) {
-        lwd->eval_zmat_lda_vxc_gks( npts, nbe, vrho, basis_eval, zmat, nbe, zmat_z, nbe, 
-                                    zmat_x, nbe, zmat_y, nbe, K);
+        lwd->eval_zmat_lda_vxc_gks( npts, nbe, vrho, basis_eval, zmat, ldz, zmat_z, ldz, 
+                                    zmat_x, ldz, zmat_y, ldz, K);
       }
     }
     
 
      
     // Incremeta LT of VXC
-    {
-
-      // Increment VXC
-      lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat, nbe, VXCs, ldvxcs, nbe_scr );
-      if(not is_rks) {
-        lwd->inc_vxc( mgga_dim_scal * npts, nbf, nbe, basis_eval, submat_map, zmat_z, nbe,VXCz, ldvxcz, nbe_scr);
-      }
-      if(is_gks) {
-        lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat_x, nbe, VXCy, ldvxcy,
-          nbe_scr);
-        lwd->inc_vxc( npts, nbf, nbe, basis_eval, submat_map, zmat_y, nbe, VXCx, ldvxcx,
-          nbe_scr);
-      }
-       
-    }
+    inc_vxc( mgga_dim_scal * npts, zmat );
 
   } // Loop over tasks
 
   } // End OpenMP region
 
+  for( auto& acc : vxc_acc ) acc->finalize();
+
+  // Work counters (accumulated over the calls of an evaluation)
+  auto& stats = this->stats_;
+  stats.npts_screened  += npts_screened;
+  stats.ntasks_grouped += ntasks_grouped;
+  if( use_colloc_cache ) {
+    stats.ntasks_colloc_reused += ncache_filled;
+    stats.ntasks_colloc_stored += collocation_cache_.nfilled() - ncache_filled;
+  }
 
   // Set scalar return values
   *EXC  = EXC_WORK;
   *N_EL = NEL_WORK;
 
-  if(not is_exc_only) {
-    // Symmetrize VXC
-    for( int32_t j = 0;   j < nbf; ++j ) {
-      for( int32_t i = j+1; i < nbf; ++i ) {
-        VXCs[ j + i*ldvxcs ] = VXCs[ i + j*ldvxcs ];
-      }
-    }
-    if(not is_rks) {
-      for( int32_t j = 0;   j < nbf; ++j ) {
-        for( int32_t i = j+1; i < nbf; ++i ) {
-          VXCz[ j + i*ldvxcz ] = VXCz[ i + j*ldvxcz ];
-        }
-      }
-    }
-    if( is_gks) {
-      for( int32_t j = 0;   j < nbf; ++j ) {
-        for( int32_t i = j+1; i < nbf; ++i ) {
-          VXCy[ j + i*ldvxcy ] = VXCy[ i + j*ldvxcy ];
-          VXCx[ j + i*ldvxcx ] = VXCx[ i + j*ldvxcx ];
-        }
-      }
+  // Symmetrize VXC (only the lower triangle has been assembled)
+  if(not is_exc_only and symmetrize_vxc) {
+    symmetrize_lower( nbf, VXCs, ldvxcs );
+    if(not is_rks) symmetrize_lower( nbf, VXCz, ldvxcz );
+    if(is_gks) {
+      symmetrize_lower( nbf, VXCy, ldvxcy );
+      symmetrize_lower( nbf, VXCx, ldvxcx );
     }
   }
 
@@ -607,6 +945,13 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
                  value_type* VXC, int64_t ldvxc,
                  value_type* EXC, const IntegratorSettingsXC& ks_settings) {
 
+  // Incremental builds retain state across calls
+  auto* ks = dynamic_cast<const IntegratorSettingsKS*>(&ks_settings);
+  if( ks and ks->incremental_vxc ) {
+    eval_exc_vxc_incremental_(m, n, P, ldp, VXC, ldvxc, EXC, *ks);
+    return;
+  }
+
   eval_exc_vxc_(m, n, P, ldp, nullptr, 0, nullptr, 0, nullptr, 0,
     VXC, ldvxc, nullptr, 0, nullptr, 0, nullptr, 0, EXC, ks_settings);
 
@@ -0,0 +1,270 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "integrator_util/symmetric_reduction.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "host/host_accumulator.hpp"
+#include "xc_host_tile_pipeline.hpp"
+#include <stdexcept>
+
+namespace GauXC::detail {
+
+/// Batched RKS EXC/VXC
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_exc_vxc_batch_( int64_t m, int64_t n, int64_t ndm,
+                       const value_type* const* P, int64_t ldp,
+                       value_type* const* VXC, int64_t ldvxc,
+                       value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P / VXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Have Same Dimension as Basis");
+  if( ldp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+  if( ldvxc < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDVXC");
+  if( ndm < 1 ) return;
+
+  // Temporary electron count to judge integrator accuracy
+  std::vector<value_type> N_EL( ndm );
+
+  // Compute Local contributions to EXC / VXC
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    exc_vxc_batch_local_work_( ndm, P, ldp, VXC, ldvxc, EXC, N_EL.data(),
+                               ks_settings );
+  });
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    auto& rd = *this->reduction_driver_;
+    const int comm_size = this->load_balancer_->runtime().comm_size();
+    for( int64_t k = 0; k < ndm; ++k )
+      allreduce_symmetric_inplace( rd, comm_size, nbf, VXC[k], ldvxc );
+
+    rd.allreduce_inplace( EXC,         ndm, ReductionOp::Sum );
+    rd.allreduce_inplace( N_EL.data(), ndm, ReductionOp::Sum );
+
+  });
+
+  // XCIntegrator::last_n_el reports the count of the last density
+  this->n_el_ = N_EL.back();
+
+}
+
+
+/**
+ *  Local work of the batched RKS EXC/VXC.
+ *
+ *  The collocation of each task is evaluated once and shared by all
+ *  densities, the X matrices of all densities are formed by a single GEMM
+ *  on the stacked density blocks (see LocalHostWorkDriver::eval_xmat_batch).
+ *  Each density then passes through the point tiled pipeline of EXC/VXC
+ *  (xc_task_tile_pipeline), its Z matrix overwrites its X matrix. Only the
+ *  lower triangles of the VXC matrices are assembled.
+ */
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_vxc_batch_local_work_( int64_t ndm, const value_type* const* P,
+                             int64_t ldp, value_type* const* VXC,
+                             int64_t ldvxc, value_type* EXC, value_type* N_EL,
+                             const IntegratorSettingsXC& settings ) {
+
+  // Misc KS settings
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+  const auto& mol   = this->load_balancer_->molecule();
+
+  const bool needs_laplacian = func.needs_laplacian();
+  const int32_t nbf = basis.nbf();
+
+  // Reuse the EXC/VXC execution plan (task order, submatrix maps)
+  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
+    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
+  };
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  auto task_begin = tasks.begin();
+  auto task_end   = tasks.end();
+  exec_plan_.prepare( this->load_balancer_.get(), basis, mol, task_begin,
+    task_end, task_comparator );
+
+  // Number of (npts,nbe) collocation blocks per task
+  const auto   family        = xc_family( func );
+  const size_t ncomp_colloc  = xc_colloc_ncomp( family, needs_laplacian );
+  const size_t mgga_dim_scal = func.is_mgga() ? 4 : 1; // basis + d1basis
+
+  // Setup collocation cache
+  const bool use_colloc_cache = ks_settings.cache_collocation;
+  if( use_colloc_cache ) {
+    // Derivative order of the collocation (cost heuristic)
+    const size_t colloc_deriv = needs_laplacian ? 2 : (func.is_lda() ? 0 : 1);
+    collocation_cache_.prepare( task_begin, task_end, ncomp_colloc, colloc_deriv,
+      ks_settings.collocation_cache_bytes, ks_settings.collocation_cache_fp32 );
+  }
+
+  // Generate sub-tile shell significance masks (persist on the tasks)
+  const bool use_tile_mask = ks_settings.screen_collocation_tiles;
+  const size_t ntasks = std::distance(task_begin, task_end);
+  if( use_tile_mask ) {
+    #pragma omp parallel for schedule(dynamic)
+    for( size_t iT = 0; iT < ntasks; ++iT ) {
+      auto& task = *(task_begin + iT);
+      if( not task.has_shell_tile_mask() ) task.generate_shell_tile_mask( basis );
+    }
+  }
+
+  // Check that Partition Weights have been calculated
+  auto& lb_state = this->load_balancer_->state();
+  if( not lb_state.modified_weights_are_stored ) {
+    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified");
+  }
+
+  // Zero out integrands and setup VXC accumulators (the accumulation budget
+  // is shared by the densities)
+  std::vector<std::unique_ptr<HostSubmatAccumulator>> vxc_acc;
+  for( int64_t k = 0; k < ndm; ++k ) {
+    for( auto j = 0; j < nbf; ++j )
+    for( auto i = 0; i < nbf; ++i ) VXC[k][i + j*ldvxc] = 0.;
+    vxc_acc.emplace_back( std::make_unique<HostSubmatAccumulator>(
+      ks_settings.accumulation, nbf, nbf, VXC[k], ldvxc,
+      ks_settings.accumulation_bytes / size_t(ndm), true ) );
+  }
+
+  std::vector<double> EXC_WORK( ndm, 0.0 );
+  std::vector<double> NEL_WORK( ndm, 0.0 );
+
+  #pragma omp parallel
+  {
+
+  XCHostData<value_type> host_data; // Thread local host data
+
+  // Size the arena for the scratch of the largest task up front, i.e. the
+  // collocation, stacked X/Z, nbe x nbe scratch and the per-point U/V
+  // variables (shared by the densities). Every task re-slices its buffers
+  // from the start of the arena, i.e. no further memory is allocated during
+  // the integration.
+  {
+    const size_t max_npts       = exec_plan_.max_npts();
+    const size_t max_npts_x_nbe = exec_plan_.max_npts_x_nbe();
+    const size_t max_nbe        = exec_plan_.max_nbe();
+    const size_t basis_sz = ncomp_colloc * max_npts_x_nbe;
+    const size_t xmat_sz  = ndm * mgga_dim_scal * max_npts_x_nbe;
+    const size_t nbe_sz   = ndm * max_nbe * max_nbe;
+    host_data.arena->reserve(
+      HostScratchArena::slice_bytes( sizeof(value_type) * basis_sz ) +
+      HostScratchArena::slice_bytes( sizeof(value_type) * xmat_sz  ) +
+      HostScratchArena::slice_bytes( sizeof(value_type) * nbe_sz   ) +
+      xc_point_buffer_bytes<value_type>( family, 1, 1, needs_laplacian,
+        max_npts ) );
+  }
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    // Alias current task
+    const auto& task = *(task_begin + iT);
+
+    // The buffers of the task are re-sliced from the start of the arena
+    host_data.release_scratch();
+
+    // Get tasks constants
+    const int32_t  npts    = task.points.size();
+    const int32_t  nbe     = task.bfn_screening.nbe;
+
+    const auto* weights     = task.weights.data();
+    const uint64_t* tile_mask = use_tile_mask ? task.shell_tile_mask.data() : nullptr;
+    const auto& submat_map = exec_plan_.submat_map(iT);
+
+    // Allocate enough memory for batch
+    const size_t ncol = mgga_dim_scal * npts;
+    const size_t ldx  = ndm * nbe;
+    host_data.basis_eval.resize( ncomp_colloc * npts * nbe );
+    host_data.xmat      .resize( ldx * ncol );
+    host_data.nbe_scr   .resize( ndm * nbe * nbe );
+
+    auto* xmat     = host_data.xmat.data();
+    auto* nbe_scr  = host_data.nbe_scr.data();
+
+    // Evaluate Collocation (+ Grad and Laplacian), shared by all densities
+    auto* basis_eval = xc_task_collocation( lwd, basis, task, iT, family,
+      needs_laplacian, tile_mask, use_colloc_cache ? &collocation_cache_ : 
+      nullptr, host_data.basis_eval.data() );
+
+    // X_k = 2 * P_k * B for all densities in a single GEMM
+    lwd->eval_xmat_batch( ncol, nbf, nbe, submat_map, ndm, 2.0, P, ldp,
+      basis_eval, nbe, xmat, ldx, nbe_scr );
+
+    // Collocation + X/Z (M) matrices + per-point scalars of one point
+    const size_t tile_pt_bytes = sizeof(value_type) *
+      (ncomp_colloc * nbe + mgga_dim_scal * nbe + 16);
+    const int32_t tile_npts = xc_tile_npts( ks_settings.xc_tile_bytes,
+      tile_pt_bytes, npts );
+
+    // Z_k overwrites X_k (rows [k*nbe, (k+1)*nbe) of X) in place
+    for( int64_t k = 0; k < ndm; ++k ) {
+
+      double EXC_local = 0.0;
+      double NEL_local = 0.0;
+      xc_family_spin_dispatch( family, XCSpin::RKS, [&]( auto fam, auto spin ) {
+        constexpr auto F = decltype(fam)::value;
+        constexpr auto S = decltype(spin)::value;
+        const auto d = xc_task_data<F,S>( npts, nbe, weights, basis_eval,
+          xmat + k * nbe, ldx, needs_laplacian, host_data );
+        xc_task_tile_pipeline<F,S>( lwd, func, d, tile_npts, needs_laplacian,
+          true, EXC_local, NEL_local );
+      });
+
+      // Atomic updates
+      #pragma omp atomic
+      EXC_WORK[k] += EXC_local;
+      #pragma omp atomic
+      NEL_WORK[k] += NEL_local;
+
+      // Increment LT of VXC
+      lwd->inc_vxc( ncol, nbf, nbe, basis_eval, submat_map, xmat + k * nbe,
+        ldx, *vxc_acc[k], nbe_scr );
+
+    } // Loop over densities
+
+  } // Loop over tasks
+
+  } // End OpenMP region
+
+  for( auto& acc : vxc_acc ) acc->finalize();
+
+  // Set scalar return values
+  for( int64_t k = 0; k < ndm; ++k ) {
+    EXC[k]  = EXC_WORK[k];
+    N_EL[k] = NEL_WORK[k];
+  }
+
+}
+
+} // namespace GauXC::detail
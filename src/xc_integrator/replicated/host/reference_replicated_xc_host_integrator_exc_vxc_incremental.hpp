@@ -0,0 +1,314 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "integrator_util/symmetric_reduction.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "host/host_accumulator.hpp"
+#include "xc_host_tile_pipeline.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace GauXC::detail {
+
+/// Incremental RKS EXC/VXC (see IntegratorSettingsKS::incremental_vxc)
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_exc_vxc_incremental_( int64_t m, int64_t n, const value_type* P,
+                             int64_t ldp, value_type* VXC, int64_t ldvxc,
+                             value_type* EXC, const IntegratorSettingsKS& ks_settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P / VXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/VXC Must Have Same Dimension as Basis");
+  if( ldp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+  if( ldvxc < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDVXC");
+
+  // Local changes of EXC / N_EL / VXC w.r.t. the previous build
+  value_type dEXC = 0., dNEL = 0.;
+  std::vector<value_type> dVXC( nbf * nbf, 0. );
+
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    exc_vxc_incremental_local_work_( P, ldp, dVXC.data(), nbf, &dEXC, &dNEL,
+      ks_settings );
+  });
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    auto& rd = *this->reduction_driver_;
+    const int comm_size = this->load_balancer_->runtime().comm_size();
+    allreduce_symmetric_inplace( rd, comm_size, nbf, dVXC.data(), nbf );
+
+    rd.allreduce_inplace( &dEXC, 1, ReductionOp::Sum );
+    rd.allreduce_inplace( &dNEL, 1, ReductionOp::Sum );
+
+  });
+
+  // Update the retained results
+  auto& state = incremental_state_;
+  for( int64_t j = 0; j < nbf; ++j )
+  for( int64_t i = 0; i < nbf; ++i ) {
+    state.VXC[i + j*nbf] += dVXC[i + j*nbf];
+    state.P  [i + j*nbf]  = P[i + j*ldp];
+    VXC[i + j*ldvxc] = state.VXC[i + j*nbf];
+  }
+  state.EXC  += dEXC;
+  state.N_EL += dNEL;
+
+  *EXC = state.EXC;
+  this->n_el_ = state.N_EL;
+
+}
+
+
+/**
+ *  Local work of the incremental RKS EXC/VXC.
+ *
+ *  Tasks are screened on the largest shell pair block of dP = P - P_prev
+ *  they span, the shell pair norms of dP are formed once per call. Every
+ *  task retains its (unweighted) potentials and EXC / N_EL contributions
+ *  of the last call in which it has been evaluated. The density of an
+ *  evaluated task is that of the full P, i.e. changes of P skipped in
+ *  previous calls are accounted for, and the difference of the weighted Z
+ *  matrices of the new and the retained potentials is accumulated into 
+ *  dVXC. The skipped blocks of dP are summed per task, a task is evaluated
+ *  once its sum exceeds the screening tolerance.
+ */
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  exc_vxc_incremental_local_work_( const value_type* P, int64_t ldp,
+                                   value_type* dVXC, int64_t lddvxc,
+                                   value_type* dEXC, value_type* dNEL,
+                                   const IntegratorSettingsKS& ks_settings ) {
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+  const auto& mol   = this->load_balancer_->molecule();
+
+  const bool needs_laplacian = func.needs_laplacian();
+  const int32_t nbf = basis.nbf();
+
+  // Reuse the EXC/VXC execution plan (task order, submatrix maps)
+  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
+    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
+  };
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  auto task_begin = tasks.begin();
+  auto task_end   = tasks.end();
+  const size_t ntasks = std::distance(task_begin, task_end);
+  exec_plan_.prepare( this->load_balancer_.get(), basis, mol, task_begin,
+    task_end, task_comparator );
+
+  // (Re)start from P_prev = 0 if the retained state does not match the tasks
+  auto& state = incremental_state_;
+  const bool restart = not state.valid or state.nbf != nbf or
+    state.plan_generation != exec_plan_.generation() or
+    state.offset.size() != ntasks + 1;
+  if( restart ) {
+    state.reset( nbf, exec_plan_.generation(), task_begin, task_end,
+      not func.is_lda(), func.is_mgga(), needs_laplacian );
+  }
+
+  // Shell pair norms of dP, tasks are screened on the shell pairs they span
+  const int32_t nshells = basis.nshells();
+  std::vector<double> dP_shell_norms( size_t(nshells) * nshells, 0. );
+  {
+    std::vector<value_type> dP( size_t(nbf) * nbf );
+    for( int32_t j = 0; j < nbf; ++j )
+    for( int32_t i = 0; i < nbf; ++i )
+      dP[i + size_t(j)*nbf] = P[i + j*ldp] - state.P[i + size_t(j)*nbf];
+    shell_block_max_abs( exec_plan_.basis_map(), nshells, dP.data(), nbf,
+      dP_shell_norms.data() );
+  }
+
+  // Screening tolerance, which tightens as dP decreases
+  const double dP_max = *std::max_element( dP_shell_norms.begin(), 
+    dP_shell_norms.end() );
+  const double dP_tol = ks_settings.incremental_tol * dP_max;
+
+  const auto   family        = xc_family( func );
+  const size_t ncomp_colloc  = xc_colloc_ncomp( family, needs_laplacian );
+  const size_t mgga_dim_scal = func.is_mgga() ? 4 : 1; // basis + d1basis
+
+  // Setup collocation cache
+  const bool use_colloc_cache = ks_settings.cache_collocation;
+  if( use_colloc_cache ) {
+    // Derivative order of the collocation (cost heuristic)
+    const size_t colloc_deriv = needs_laplacian ? 2 : (func.is_lda() ? 0 : 1);
+    collocation_cache_.prepare( task_begin, task_end, ncomp_colloc, colloc_deriv,
+      ks_settings.collocation_cache_bytes, ks_settings.collocation_cache_fp32 );
+  }
+
+  // Check that Partition Weights have been calculated
+  auto& lb_state = this->load_balancer_->state();
+  if( not lb_state.modified_weights_are_stored ) {
+    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified");
+  }
+
+  HostSubmatAccumulator dVXC_acc( ks_settings.accumulation, nbf, nbf, dVXC,
+    lddvxc, ks_settings.accumulation_bytes, true );
+
+  double EXC_WORK = 0.0;
+  double NEL_WORK = 0.0;
+  size_t ntasks_skipped = 0;
+
+  #pragma omp parallel
+  {
+
+  XCHostData<value_type> host_data; // Thread local host data
+  std::vector<value_type> dden_scr; // Effective gradient / unit vgamma
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    // Alias current task
+    const auto& task = *(task_begin + iT);
+
+    // The buffers of the task are re-sliced from the start of the arena
+    host_data.release_scratch();
+    const auto& submat_map = exec_plan_.submat_map(iT);
+
+    // Screen the shell pairs of dP spanned by the task, including the
+    // blocks skipped since its last evaluation
+    const auto& shell_list = task.bfn_screening.shell_list;
+    double dP_blk = 0.;
+    for( auto jsh : shell_list )
+    for( auto ish : shell_list )
+      dP_blk = std::max( dP_blk, dP_shell_norms[ish + size_t(jsh)*nshells] );
+    if( not restart and state.dP_skip[iT] + dP_blk <= dP_tol ) {
+      state.dP_skip[iT] += dP_blk;
+      #pragma omp atomic
+      ntasks_skipped++;
+      continue;
+    }
+    state.dP_skip[iT] = 0.;
+
+    // Get tasks constants
+    const int32_t  npts    = task.points.size();
+    const int32_t  nbe     = task.bfn_screening.nbe;
+    const auto*    weights = task.weights.data();
+
+    // Allocate enough memory for batch
+    const size_t ncol = mgga_dim_scal * npts;
+    host_data.basis_eval.resize( ncomp_colloc * npts * nbe );
+    host_data.zmat      .resize( nbe * ncol );
+    host_data.nbe_scr   .resize( nbe * nbe );
+    auto* nbe_scr = host_data.nbe_scr.data();
+
+    // Evaluate Collocation (+ Grad and Laplacian)
+    auto* basis_eval = xc_task_collocation( lwd, basis, task, iT, family,
+      needs_laplacian, nullptr, use_colloc_cache ? &collocation_cache_ : 
+      nullptr, host_data.basis_eval.data() );
+
+    // Retained potentials of the task
+    const size_t off = state.offset[iT];
+    auto* vrho_t   = state.vrho.data() + off;
+    auto* dden_t   = func.is_lda()   ? nullptr : state.dden.data()   + 3*off;
+    auto* vgamma_t = func.is_lda()   ? nullptr : state.vgamma.data() + off;
+    auto* vtau_t   = func.is_mgga()  ? state.vtau.data()  + off : nullptr;
+    auto* vlapl_t  = needs_laplacian ? state.vlapl.data() + off : nullptr;
+
+    double EXC_local = 0.0;
+    double NEL_local = 0.0;
+    xc_family_spin_dispatch( family, XCSpin::RKS, [&]( auto fam, auto spin ) {
+      constexpr auto F = decltype(fam)::value;
+      constexpr auto S = decltype(spin)::value;
+      auto d = xc_task_data<F,S>( npts, nbe, weights, basis_eval, 
+        host_data.zmat.data(), nbe, needs_laplacian, host_data );
+
+      // Density (+ derivatives) of P and the XC functional
+      lwd->eval_xmat( ncol, nbf, nbe, submat_map, 2.0, P, ldp, basis_eval, 
+        nbe, d.zmat, nbe, nbe_scr );
+      xc_task_uvvar<F,S>( lwd, d );
+      xc_task_functional<F>( func, d );
+
+      // Potential differences, retain the updated potentials. The gradient
+      // term of Z is linear in vgamma * grad(rho), its difference enters
+      // with a unit vgamma.
+      auto update = [&]( value_type* v, value_type* v_t ) {
+        for( int32_t i = 0; i < npts; ++i ) {
+          const auto dv = v[i] - v_t[i];
+          v_t[i] = v[i];
+          v[i]   = dv;
+        }
+      };
+      update( d.vrho, vrho_t );
+      if( d.vtau  ) update( d.vtau,  vtau_t  );
+      if( d.vlapl ) update( d.vlapl, vlapl_t );
+
+      if( d.vgamma ) {
+        dden_scr.resize( 4 * npts );
+        auto* dden_eff_x = dden_scr.data();
+        auto* dden_eff_y = dden_eff_x + npts;
+        auto* dden_eff_z = dden_eff_y + npts;
+        auto* vgamma_one = dden_eff_z + npts;
+        for( int32_t i = 0; i < npts; ++i ) {
+          const auto vg = d.vgamma[i], vg_t = vgamma_t[i];
+          dden_eff_x[i] = vg * d.dden_x[i] - vg_t * dden_t[i];
+          dden_eff_y[i] = vg * d.dden_y[i] - vg_t * dden_t[i +   npts];
+          dden_eff_z[i] = vg * d.dden_z[i] - vg_t * dden_t[i + 2*npts];
+          vgamma_one[i] = 1.;
+
+          dden_t[i]          = d.dden_x[i];
+          dden_t[i +   npts] = d.dden_y[i];
+          dden_t[i + 2*npts] = d.dden_z[i];
+          vgamma_t[i]        = vg;
+        }
+        d.dden_x = dden_eff_x;
+        d.dden_y = dden_eff_y;
+        d.dden_z = dden_eff_z;
+        d.vgamma = vgamma_one;
+      }
+
+      // Weighted Z matrix of the potential differences
+      xc_task_zmat<F,S>( lwd, d, needs_laplacian, true, EXC_local, NEL_local );
+    });
+
+    #pragma omp atomic
+    EXC_WORK += EXC_local - state.exc_task[iT];
+    #pragma omp atomic
+    NEL_WORK += NEL_local - state.nel_task[iT];
+    state.exc_task[iT] = EXC_local;
+    state.nel_task[iT] = NEL_local;
+
+    // Increment LT of dVXC
+    lwd->inc_vxc( ncol, nbf, nbe, basis_eval, submat_map, host_data.zmat.data(),
+      nbe, dVXC_acc, nbe_scr );
+
+  } // Loop over tasks
+
+  } // End OpenMP region
+
+  dVXC_acc.finalize();
+
+  *dEXC = EXC_WORK;
+  *dNEL = NEL_WORK;
+  this->stats_.ntasks_skipped = ntasks_skipped;
+
+}
+
+} // namespace GauXC::detail
@@ -12,6 +12,7 @@
 #include "integrator_util/integral_bounds.hpp"
 #include "integrator_util/exx_screening.hpp"
 #include "host/local_host_work_driver.hpp"
+#include "host/host_accumulator.hpp"
 #include "host/blas.hpp"
 #include <stdexcept>
 #include <set>
@@ -433,11 +434,13 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
   const size_t ntasks = tasks.size();
   //std::cout << "NTASKS = " << ntasks << std::endl;
   //std::cout << "NTASKS NNZ = " << std::count_if(tasks.begin(),tasks.end(),[](const auto& t){ return t.cou_screening.shell_pair_list.size(); }) << std::endl;
+  HostSubmatAccumulator K_acc( sn_link_settings.accumulation, nbf, nbf, K, ldk,
+    sn_link_settings.accumulation_bytes );
+
   #pragma omp parallel
   {
 
   XCHostData<value_type> host_data; // Thread local host data
-  std::vector<double> K_local(nbf*nbf,0.0);
 
   #pragma omp for schedule(dynamic)
   for( size_t iT = 0; iT < ntasks; ++iT ) {
@@ -446,6 +449,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // Alias current task
     const auto& task = tasks[iT];
 
+    // The buffers of the task are re-sliced from the start of the arena
+    host_data.release_scratch();
+
     // Early exit
     auto ek_shell_list = task.cou_screening.shell_list;
     if( ek_shell_list.size() == 0 ) {
@@ -523,13 +529,15 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // nu runs over ek shells
     // i runs over all points
     lwd->inc_exx_k( npts, nbf, nbe_bfn, nbe_ek, basis_eval, submat_map_bfn,
-      ek_submat_map, gmat, nbe_ek, K, ldk, nbe_scr );
+      ek_submat_map, gmat, nbe_ek, K_acc, nbe_scr );
 
   } // Loop over tasks 
 
 
   } // End OpenMP region
 
+  K_acc.finalize();
+
   // Symmetrize K
   for( auto j = 0; j < nbf; ++j ) 
   for( auto i = 0; i < j;   ++i ) {
@@ -0,0 +1,303 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+
+#include "reference_replicated_xc_host_integrator.hpp"
+#include "integrator_util/integrator_common.hpp"
+#include "integrator_util/symmetric_reduction.hpp"
+#include "host/local_host_work_driver.hpp"
+#include "host/host_accumulator.hpp"
+#include "xc_host_tile_pipeline.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace GauXC::detail {
+
+/// RKS XC kernel contraction
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  eval_fxc_contraction_( int64_t m, int64_t n, const value_type* P, int64_t ldp,
+                         int64_t ntrial, const value_type* const* tP, int64_t ldtp,
+                         value_type* const* FXC, int64_t ldfxc,
+                         const IntegratorSettingsXC& ks_settings ) {
+
+  const auto& basis = this->load_balancer_->basis();
+
+  // Check that P / tP / FXC are sane
+  const int64_t nbf = basis.nbf();
+  if( m != n )
+    GAUXC_GENERIC_EXCEPTION("P/FXC Must Be Square");
+  if( m != nbf )
+    GAUXC_GENERIC_EXCEPTION("P/FXC Must Have Same Dimension as Basis");
+  if( ldp < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDP");
+  if( ldtp != ldp )
+    GAUXC_GENERIC_EXCEPTION("LDTP Must Match LDP");
+  if( ldfxc < nbf )
+    GAUXC_GENERIC_EXCEPTION("Invalid LDFXC");
+  if( ntrial < 1 ) return;
+
+  // Compute Local contributions to FXC
+  this->timer_.time_op("XCIntegrator.LocalWork", [&](){
+    fxc_contraction_local_work_( P, ldp, ntrial, tP, FXC, ldfxc, ks_settings );
+  });
+
+  // Reduce Results
+  this->timer_.time_op("XCIntegrator.Allreduce", [&](){
+
+    if( not this->reduction_driver_->takes_host_memory() )
+      GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
+
+    auto& rd = *this->reduction_driver_;
+    const int comm_size = this->load_balancer_->runtime().comm_size();
+    for( int64_t k = 0; k < ntrial; ++k )
+      allreduce_symmetric_inplace( rd, comm_size, nbf, FXC[k], ldfxc );
+
+  });
+
+}
+
+
+/**
+ *  Local work of the RKS XC kernel contraction.
+ *
+ *  For each trial density tP_k, the derivative of the weighted Z matrix
+ *  w.r.t. the density along tP_k is formed by a central difference of
+ *  the U/V variables, the functional and the Z matrix at every point
+ *  (the functionals only provide first derivatives). The step is chosen
+ *  per point, such that the density is perturbed by at most fxc_fd_step
+ *  relative to the density of the point. The collocation is evaluated once
+ *  per task, the X matrices of P and all trial densities are formed by a
+ *  single GEMM and the stacked dZ_k are contracted with the collocation by
+ *  a single GEMM. The per-point stages are those of EXC/VXC (xc_task_uvvar,
+ *  xc_task_functional, xc_task_zmat).
+ */
+template <typename ValueType>
+void ReferenceReplicatedXCHostIntegrator<ValueType>::
+  fxc_contraction_local_work_( const value_type* P, int64_t ldp,
+                               int64_t ntrial, const value_type* const* tP,
+                               value_type* const* FXC, int64_t ldfxc,
+                               const IntegratorSettingsXC& settings ) {
+
+  // Misc KS settings
+  IntegratorSettingsKS ks_settings;
+  if( auto* tmp = dynamic_cast<const IntegratorSettingsKS*>(&settings) ) {
+    ks_settings = *tmp;
+  }
+
+  // Cast LWD to LocalHostWorkDriver
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>(this->local_work_driver_.get());
+
+  // Setup Aliases
+  const auto& func  = *this->func_;
+  const auto& basis = this->load_balancer_->basis();
+  const auto& mol   = this->load_balancer_->molecule();
+
+  const bool needs_laplacian = func.needs_laplacian();
+  const int32_t nbf = basis.nbf();
+
+  // Reuse the EXC/VXC execution plan (task order, submatrix maps)
+  auto task_comparator = []( const XCTask& a, const XCTask& b ) {
+    return (a.points.size() * a.bfn_screening.nbe) > (b.points.size() * b.bfn_screening.nbe);
+  };
+
+  auto& tasks = this->load_balancer_->get_tasks();
+  auto task_begin = tasks.begin();
+  auto task_end   = tasks.end();
+  exec_plan_.prepare( this->load_balancer_.get(), basis, mol, task_begin,
+    task_end, task_comparator );
+
+  const auto   family        = xc_family( func );
+  const size_t ncomp_colloc  = xc_colloc_ncomp( family, needs_laplacian );
+  const size_t mgga_dim_scal = func.is_mgga() ? 4 : 1; // basis + d1basis
+  const size_t nden_blk      = func.is_lda()  ? 1 : 4; // den + grad
+
+  // Setup collocation cache
+  const bool use_colloc_cache = ks_settings.cache_collocation;
+  if( use_colloc_cache ) {
+    // Derivative order of the collocation (cost heuristic)
+    const size_t colloc_deriv = needs_laplacian ? 2 : (func.is_lda() ? 0 : 1);
+    collocation_cache_.prepare( task_begin, task_end, ncomp_colloc, colloc_deriv,
+      ks_settings.collocation_cache_bytes, ks_settings.collocation_cache_fp32 );
+  }
+
+  // Check that Partition Weights have been calculated
+  auto& lb_state = this->load_balancer_->state();
+  if( not lb_state.modified_weights_are_stored ) {
+    GAUXC_GENERIC_EXCEPTION("Weights Have Not Been Modified");
+  }
+
+  // Stacked densities (P first) and finite difference steps
+  const int64_t ndm = ntrial + 1;
+  std::vector<const value_type*> P_stack( ndm );
+  std::vector<double> fd_step( ntrial );
+  P_stack[0] = P;
+  for( int64_t k = 0; k < ntrial; ++k ) {
+    P_stack[k+1] = tP[k];
+    double tP_max = 0.;
+    for( auto j = 0; j < nbf; ++j )
+    for( auto i = 0; i < nbf; ++i )
+      tP_max = std::max( tP_max, std::abs(tP[k][i + j*ldp]) );
+    fd_step[k] = tP_max > 0. ? ks_settings.fxc_fd_step / tP_max : 1.;
+  }
+  const double density_tol = ks_settings.fxc_density_tol;
+
+  // Zero out integrands and setup FXC accumulators
+  std::vector<std::unique_ptr<HostSubmatAccumulator>> fxc_acc;
+  std::vector<HostSubmatAccumulator*> fxc_acc_ptr;
+  for( int64_t k = 0; k < ntrial; ++k ) {
+    for( auto j = 0; j < nbf; ++j )
+    for( auto i = 0; i < nbf; ++i ) FXC[k][i + j*ldfxc] = 0.;
+    fxc_acc.emplace_back( std::make_unique<HostSubmatAccumulator>(
+      ks_settings.accumulation, nbf, nbf, FXC[k], ldfxc,
+      ks_settings.accumulation_bytes / size_t(ntrial), true ) );
+    fxc_acc_ptr.emplace_back( fxc_acc.back().get() );
+  }
+
+  const size_t ntasks = std::distance(task_begin, task_end);
+
+  #pragma omp parallel
+  {
+
+  XCHostData<value_type> host_data; // Thread local host data
+  std::vector<double> rho, drho, fd_h;  // Per point density / steps
+
+  #pragma omp for schedule(dynamic)
+  for( size_t iT = 0; iT < ntasks; ++iT ) {
+
+    // Alias current task
+    const auto& task = *(task_begin + iT);
+
+    // The buffers of the task are re-sliced from the start of the arena
+    host_data.release_scratch();
+
+    // Get tasks constants
+    const int32_t  npts    = task.points.size();
+    const int32_t  nbe     = task.bfn_screening.nbe;
+    const auto& submat_map = exec_plan_.submat_map(iT);
+
+    // Allocate enough memory for batch
+    const size_t ncol = mgga_dim_scal * npts;
+    const size_t ldx  = ndm * nbe;
+    const size_t lddz = ntrial * nbe;
+    host_data.basis_eval .resize( ncomp_colloc * npts * nbe );
+    host_data.xmat       .resize( ldx * ncol );
+    host_data.zmat       .resize( (2 * nbe + lddz) * ncol );
+    host_data.nbe_scr    .resize( ndm * nbe * nbe );
+    host_data.weights_scr.resize( npts );
+
+    // Alias/Partition out scratch memory
+    auto* xmat    = host_data.xmat.data();
+    auto* z_plus  = host_data.zmat.data();
+    auto* z_minus = z_plus + nbe * ncol;
+    auto* dz      = z_minus + nbe * ncol;
+    auto* nbe_scr = host_data.nbe_scr.data();
+    auto* weights = host_data.weights_scr.data();
+
+    // Evaluate Collocation (+ Grad and Laplacian), shared by all densities
+    auto* basis_eval = xc_task_collocation( lwd, basis, task, iT, family,
+      needs_laplacian, nullptr, use_colloc_cache ? &collocation_cache_ : 
+      nullptr, host_data.basis_eval.data() );
+
+    // X = 2 * P * B and X_k = 2 * tP_k * B in a single GEMM
+    lwd->eval_xmat_batch( ncol, nbf, nbe, submat_map, ndm, 2.0, P_stack.data(),
+      ldp, basis_eval, nbe, xmat, ldx, nbe_scr );
+
+    xc_family_spin_dispatch( family, XCSpin::RKS, [&]( auto fam, auto spin ) {
+      constexpr auto F = decltype(fam)::value;
+      constexpr auto S = decltype(spin)::value;
+
+      // Points with negligible ground state density do not contribute
+      const auto d0 = xc_task_data<F,S>( npts, nbe, weights, basis_eval, xmat,
+        ldx, needs_laplacian, host_data );
+      xc_task_uvvar<F,S>( lwd, d0 );
+      int32_t nsig = 0;
+      for( int32_t i = 0; i < npts; ++i ) {
+        const bool sig = d0.den[i] > density_tol;
+        weights[i] = sig ? task.weights[i] : 0.;
+        nsig += sig;
+      }
+      if( not nsig ) return;
+
+      // Ground state density (the U variables are overwritten by the Z
+      // matrix evaluations)
+      rho.assign( d0.den, d0.den + npts );
+      drho.resize( npts ); fd_h.resize( npts );
+
+      // Weighted Z (and M) matrix, overwrites the X matrix Z (ld = nbe)
+      auto eval_zmat = [&]( value_type* Z ) {
+
+        const auto d = xc_task_data<F,S>( npts, nbe, weights, basis_eval, Z, 
+          nbe, needs_laplacian, host_data );
+        xc_task_uvvar<F,S>( lwd, d );
+        for( int32_t i = 0; i < npts; ++i )
+        if( weights[i] == 0. ) {
+          for( size_t b = 0; b < nden_blk; ++b ) d.den[i + b*npts] = 0.;
+          if( d.gamma ) d.gamma[i] = 0.;
+          if( d.tau   ) d.tau[i]   = 0.;
+          if( d.lapl  ) d.lapl[i]  = 0.;
+        }
+
+        double EXC_fd = 0.0, NEL_fd = 0.0; // Not used
+        xc_task_functional<F>( func, d );
+        xc_task_zmat<F,S>( lwd, d, needs_laplacian, true, EXC_fd, NEL_fd );
+
+      };
+
+      for( int64_t k = 0; k < ntrial; ++k ) {
+
+        const auto* X_k = xmat + (k+1) * nbe;
+        auto*       dZ  = dz   + k * nbe;
+
+        // Step of each point: fd_step[k], unless the density is perturbed
+        // by more than fxc_fd_step relative to the density of the point
+        // (screened points do not contribute)
+        lwd->eval_uvvar_lda_rks( npts, nbe, basis_eval, X_k, ldx, drho.data() );
+        for( int32_t i = 0; i < npts; ++i ) {
+          const double drho_max = ks_settings.fxc_fd_step * rho[i];
+          fd_h[i] = ( weights[i] != 0. and 
+                      fd_step[k] * std::abs(drho[i]) > drho_max ) ?
+            drho_max / std::abs(drho[i]) : fd_step[k];
+        }
+
+        // Z(X + h * X_k), Z(X - h * X_k), the columns of the X matrix
+        // (value and derivatives for MGGA) cycle over the points
+        for( auto [sgn, Z] : { std::make_pair( 1.0, z_plus ),
+                               std::make_pair(-1.0, z_minus ) } ) {
+          for( size_t j = 0; j < ncol; ++j ) {
+            const double h = sgn * fd_h[j % npts];
+            for( int32_t i = 0; i < nbe; ++i )
+              Z[i + j*nbe] = xmat[i + j*ldx] + h * X_k[i + j*ldx];
+          }
+          eval_zmat( Z );
+        }
+
+        // dZ_k = (Z(+) - Z(-)) / 2h
+        for( size_t j = 0; j < ncol; ++j ) {
+          const double fac = 0.5 / fd_h[j % npts];
+          for( int32_t i = 0; i < nbe; ++i )
+            dZ[i + j*lddz] = fac * (z_plus[i + j*nbe] - z_minus[i + j*nbe]);
+        }
+
+      } // Loop over trial densities
+
+      // Increment LT of all FXC_k
+      lwd->inc_vxc_batch( ncol, nbf, nbe, basis_eval, submat_map, ntrial, dz,
+        lddz, fxc_acc_ptr.data(), nbe_scr );
+
+    });
+
+  } // Loop over tasks
+
+  } // End OpenMP region
+
+  for( auto& acc : fxc_acc ) acc->finalize();
+
+}
+
+} // namespace GauXC::detail
@@ -103,6 +103,9 @@ void ReferenceReplicatedXCHostIntegrator<ValueType>::
     // Alias current task
     const auto& task = tasks[iT];
 
+    // The buffers of the task are re-sliced from the start of the arena
+    host_data.release_scratch();
+
     // Get tasks constants
     const int32_t  npts    = task.points.size();
     const int32_t  nbe     = task.bfn_screening.nbe;
@@ -0,0 +1,151 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/xc_task.hpp>
+#include <gauxc/basisset_map.hpp>
+#include "integrator_util/integrator_common.hpp"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace GauXC::detail {
+
+/**
+ *  Cached setup of the host EXC/VXC task loop.
+ *
+ *  The task order, the BasisSetMap, the per-task submatrix maps and the
+ *  scratch high-water marks only depend on the local tasks of the load
+ *  balancer (and not on the density or the functional), they are hence
+ *  built once and reused across calls.
+ *
+ *  Tasks are identified by content (parent, size, nbe and first point). If
+ *  the task list has been reordered by another integrand, the planned order
+ *  is restored by an O(ntasks) permutation, any other change (e.g. grid
+ *  compaction, regenerated tasks) triggers a rebuild.
+ */
+class XCExecutionPlan {
+
+  using key_type     = std::tuple<int32_t, int32_t, int32_t, std::array<double,3>>;
+  using submat_map_t = std::vector<std::array<int32_t,3>>;
+
+  const void*                  owner_ = nullptr; ///< Load balancer identity
+  std::vector<key_type>        keys_;
+  std::vector<submat_map_t>    submat_maps_;
+  std::unique_ptr<BasisSetMap> basis_map_;
+
+  size_t max_npts_       = 0;
+  size_t max_nbe_        = 0;
+  size_t max_npts_x_nbe_ = 0;
+
+  size_t generation_ = 0; ///< Number of (re)builds
+
+  static key_type task_key( const XCTask& t ) {
+    std::array<double,3> pt0 = {0., 0., 0.};
+    if( t.points.size() ) pt0 = t.points.front();
+    return key_type( t.iParent, t.points.size(), t.bfn_screening.nbe, pt0 );
+  }
+
+  /// Attempt to permute [task_begin, task_end) into the planned order
+  template <typename TaskIterator>
+  bool restore_order( TaskIterator task_begin, TaskIterator task_end ) {
+
+    const size_t ntasks = std::distance( task_begin, task_end );
+    std::map<key_type,size_t> index;
+    for( size_t i = 0; i < ntasks; ++i ) index[keys_[i]] = i;
+    if( index.size() != ntasks ) return false;
+
+    std::vector<size_t> dest( ntasks );
+    for( size_t i = 0; i < ntasks; ++i ) {
+      auto it = index.find( task_key(*(task_begin + i)) );
+      if( it == index.end() ) return false;
+      dest[i] = it->second;
+    }
+
+    std::vector<XCTask> reordered( ntasks );
+    for( size_t i = 0; i < ntasks; ++i )
+      reordered[dest[i]] = std::move( *(task_begin + i) );
+    std::move( reordered.begin(), reordered.end(), task_begin );
+    return true;
+
+  }
+
+public:
+
+  /**
+   *  Validate / (re)build the plan for the tasks owned by `owner` and bring
+   *  [task_begin, task_end) into the planned order.
+   *
+   *  @returns whether the plan has been (re)built
+   */
+  template <typename BasisType, typename TaskIterator, typename Comparator>
+  bool prepare( const void* owner, const BasisType& basis, const Molecule& mol,
+    TaskIterator task_begin, TaskIterator task_end, Comparator comp ) {
+
+    const size_t ntasks = std::distance( task_begin, task_end );
+    if( owner == owner_ and keys_.size() == ntasks ) {
+      bool same_order = true;
+      for( size_t i = 0; i < ntasks; ++i )
+      if( task_key(*(task_begin + i)) != keys_[i] ) { same_order = false; break; }
+
+      if( same_order or restore_order( task_begin, task_end ) ) return false;
+    }
+
+    // Rebuild
+    std::sort( task_begin, task_end, comp );
+    ++generation_;
+
+    owner_     = owner;
+    basis_map_ = std::make_unique<BasisSetMap>( basis, mol );
+    keys_.resize( ntasks );
+    submat_maps_.resize( ntasks );
+
+    const int32_t nbf = basis.nbf();
+    #pragma omp parallel for schedule(dynamic)
+    for( size_t i = 0; i < ntasks; ++i ) {
+      const auto& task = *(task_begin + i);
+      keys_[i] = task_key( task );
+      std::tie( submat_maps_[i], std::ignore ) = gen_compressed_submat_map(
+        *basis_map_, task.bfn_screening.shell_list, nbf, nbf );
+    }
+
+    max_npts_ = 0; max_nbe_ = 0; max_npts_x_nbe_ = 0;
+    for( auto it = task_begin; it != task_end; ++it ) {
+      const size_t npts = it->points.size();
+      const size_t nbe  = it->bfn_screening.nbe;
+      max_npts_       = std::max( max_npts_, npts );
+      max_nbe_        = std::max( max_nbe_, nbe );
+      max_npts_x_nbe_ = std::max( max_npts_x_nbe_, npts * nbe );
+    }
+
+    return true;
+
+  }
+
+  inline const BasisSetMap&  basis_map()           const { return *basis_map_;     }
+  inline const submat_map_t& submat_map( size_t i ) const { return submat_maps_[i]; }
+
+  inline size_t max_npts()       const { return max_npts_;       }
+  inline size_t max_nbe()        const { return max_nbe_;        }
+  inline size_t max_npts_x_nbe() const { return max_npts_x_nbe_; }
+
+  /// Identifies the current build, data keyed on the task order of the
+  /// plan is stale once this changes
+  inline size_t generation() const { return generation_; }
+
+  /// Invalidate the plan
+  inline void clear() {
+    owner_ = nullptr; keys_.clear(); submat_maps_.clear(); basis_map_.reset();
+  }
+
+};
+
+}
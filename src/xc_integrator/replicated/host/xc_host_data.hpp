@@ -7,32 +7,73 @@
  */
 #pragma once
 #include <vector>
+#include <array>
 #include <cstdint>
+#include <memory>
 
 #include <gauxc/gauxc_config.hpp>
+#include "host/host_scratch_arena.hpp"
 
 namespace GauXC {
 
+/**
+ *  Thread local scratch of the host integrators
+ *
+ *  All numeric buffers are slices of a single (per instance) scratch
+ *  arena and are not initialized on resize. The integrators release the
+ *  arena at the start of every task (release_scratch) and re-slice the
+ *  buffers of the task in stack order, i.e. the arena settles at the high
+ *  water mark of a single task (which may be reserved up front) rather
+ *  than retaining regions of grown buffers.
+ */
 template <typename F>
 struct XCHostData {
 
-  std::vector<F> eps;
-  std::vector<F> gamma;
-  std::vector<F> tau;
-  std::vector<F> lapl;
-  std::vector<F> vrho;
-  std::vector<F> vgamma;
-  std::vector<F> vtau;
-  std::vector<F> vlapl;
+  std::unique_ptr<HostScratchArena> arena = std::make_unique<HostScratchArena>();
+
+  template <typename T = F>
+  using buffer_type = HostScratchBuffer<T>;
+
+  buffer_type<> eps        { arena.get() };
+  buffer_type<> gamma      { arena.get() };
+  buffer_type<> tau        { arena.get() };
+  buffer_type<> lapl       { arena.get() };
+  buffer_type<> vrho       { arena.get() };
+  buffer_type<> vgamma     { arena.get() };
+  buffer_type<> vtau       { arena.get() };
+  buffer_type<> vlapl      { arena.get() };
  
-  std::vector<F> zmat;
-  std::vector<F> gmat;
-  std::vector<F> nbe_scr;
-  std::vector<F> den_scr;
-  std::vector<F> basis_eval;
+  buffer_type<> zmat       { arena.get() };
+  buffer_type<> gmat       { arena.get() };
+  buffer_type<> nbe_scr    { arena.get() };
+  buffer_type<> den_scr    { arena.get() };
+  buffer_type<> basis_eval { arena.get() };
+  buffer_type<> xmat       { arena.get() }; ///< Stacked X matrices of batched densities
+
+  // Mixed precision (FP32) GEMM operands
+  buffer_type<float> basis_eval_sp { arena.get() };
+  buffer_type<float> sp_scr        { arena.get() };
+
+  // Density screening: significant points and their weights
+  std::vector<int32_t> point_idx;
+  buffer_type<>        weights_scr { arena.get() };
+
+  // Submatrix map of the task (if not provided by the execution plan)
+  std::vector<std::array<int32_t,3>> submat_map;
    
   inline XCHostData() {}
 
+  /// Release the arena, all buffers are to be resized prior to use
+  void release_scratch() noexcept {
+    arena->clear();
+    for( auto* buf : { &eps, &gamma, &tau, &lapl, &vrho, &vgamma, &vtau,
+                       &vlapl, &zmat, &gmat, &nbe_scr, &den_scr, &basis_eval,
+                       &xmat, &weights_scr } )
+      buf->reset();
+    basis_eval_sp.reset();
+    sp_scr       .reset();
+  }
+
 };
 
 }
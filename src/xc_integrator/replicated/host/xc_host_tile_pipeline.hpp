@@ -0,0 +1,547 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <gauxc/types.hpp>
+#include <gauxc/exceptions.hpp>
+#include "host/local_host_work_driver.hpp"
+#include "host_collocation_cache.hpp"
+#include "host/host_scratch_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+namespace GauXC::detail {
+
+enum class XCFamily { LDA, GGA, MGGA };
+enum class XCSpin   { RKS, UKS };
+
+/// Largest number of tasks whose functional is evaluated in a single call
+inline constexpr size_t xc_func_batch_max_tasks = 64;
+
+/**
+ *  Per-task operands of the point tiled EXC/VXC pipeline
+ *
+ *  Point dependent quantities are stored point-major, i.e. the data of
+ *  point i starts at i * (number of components), the collocation and X/Z
+ *  (M) matrices at i * nbe and i * ldz, respectively. Unused operands
+ *  (e.g. gradients for LDA) may be null.
+ */
+struct XCTaskTileData {
+  int32_t npts = 0;
+  int32_t nbe  = 0;
+  int32_t ldz  = 0;
+
+  const double* weights  = nullptr;
+  const double* basis    = nullptr;
+  const double* dbasis_x = nullptr;
+  const double* dbasis_y = nullptr;
+  const double* dbasis_z = nullptr;
+  const double* lbasis   = nullptr;
+
+  double* zmat     = nullptr;
+  double* zmat_z   = nullptr;
+  double* mmat_x   = nullptr;
+  double* mmat_y   = nullptr;
+  double* mmat_z   = nullptr;
+  double* mmat_x_z = nullptr;
+  double* mmat_y_z = nullptr;
+  double* mmat_z_z = nullptr;
+
+  double* den    = nullptr;
+  double* dden_x = nullptr;
+  double* dden_y = nullptr;
+  double* dden_z = nullptr;
+  double* gamma  = nullptr;
+  double* tau    = nullptr;
+  double* lapl   = nullptr;
+
+  double* eps    = nullptr;
+  double* vrho   = nullptr;
+  double* vgamma = nullptr;
+  double* vtau   = nullptr;
+  double* vlapl  = nullptr;
+};
+
+/// Number of per-point components of den/tau/lapl (sds) and gamma (gds)
+template <XCSpin Spin> inline constexpr int32_t xc_sds = Spin == XCSpin::RKS ? 1 : 2;
+template <XCSpin Spin> inline constexpr int32_t xc_gds = Spin == XCSpin::RKS ? 1 : 3;
+
+/// Family of an XC functional
+inline XCFamily xc_family( const functional_type& func ) {
+  return func.is_mgga() ? XCFamily::MGGA :
+         func.is_gga()  ? XCFamily::GGA  : XCFamily::LDA;
+}
+
+/// Number of (nbe,npts) collocation blocks of a task
+inline size_t xc_colloc_ncomp( XCFamily family, bool needs_laplacian ) {
+  if( family == XCFamily::MGGA ) return needs_laplacian ? 5 : 4;
+  return family == XCFamily::GGA ? 4 : 1;
+}
+
+/**
+ *  Collocation (+ gradient and laplacian) of the task at position iT, 
+ *  stored as consecutive (nbe,npts) blocks. Tasks admitted to the 
+ *  collocation cache (if any) are read from it, in place for FP64 storage
+ *  or expanded into scratch for FP32 storage.
+ *
+ *  @returns The collocation of the task, i.e. either cached data or scratch
+ */
+template <typename F>
+F* xc_task_collocation( LocalHostWorkDriver* lwd, 
+  const BasisSet<double>& basis, const XCTask& task, size_t iT, 
+  XCFamily family, bool needs_laplacian, const uint64_t* tile_mask,
+  HostCollocationCache<F>* cache, F* scratch ) {
+
+  const bool admitted = cache and cache->admitted(iT);
+  if( admitted and cache->filled(iT) ) {
+    if( auto* cached = cache->data(iT) ) return cached;
+    cache->load( iT, scratch );
+    return scratch;
+  }
+
+  const size_t npts    = task.points.size();
+  const size_t nbe     = task.bfn_screening.nbe;
+  const size_t nshells = task.bfn_screening.shell_list.size();
+  const auto*  points  = task.points.data()->data();
+  const auto*  shell_list = task.bfn_screening.shell_list.data();
+
+  F* dbasis_x = scratch  + npts * nbe;
+  F* dbasis_y = dbasis_x + npts * nbe;
+  F* dbasis_z = dbasis_y + npts * nbe;
+  if( family == XCFamily::MGGA and needs_laplacian )
+    lwd->eval_collocation_laplacian( npts, nshells, nbe, points, basis, 
+      shell_list, scratch, dbasis_x, dbasis_y, dbasis_z, dbasis_z + npts * nbe,
+      tile_mask );
+  else if( family != XCFamily::LDA )
+    lwd->eval_collocation_gradient( npts, nshells, nbe, points, basis, 
+      shell_list, scratch, dbasis_x, dbasis_y, dbasis_z, tile_mask );
+  else
+    lwd->eval_collocation( npts, nshells, nbe, points, basis, shell_list, 
+      scratch, tile_mask );
+
+  if( admitted ) cache->store( iT, scratch );
+  return scratch;
+
+}
+
+/**
+ *  Arena bytes of the U/V variable buffers of the host data (den_scr, eps,
+ *  vrho, gamma, vgamma, tau, vtau, lapl, vlapl) for npts points, given sds
+ *  components of den/tau/lapl and gds components of gamma. Mirrors
+ *  xc_resize_point_buffers.
+ */
+template <typename F>
+size_t xc_point_buffer_bytes( XCFamily family, size_t sds, size_t gds, 
+  bool needs_laplacian, size_t npts ) {
+
+  const bool gga  = family != XCFamily::LDA;
+  const bool mgga = family == XCFamily::MGGA;
+  auto slice = [&]( size_t ncomp ) {
+    return HostScratchArena::slice_bytes( sizeof(F) * ncomp * npts );
+  };
+
+  size_t bytes = slice( (gga ? 4 : 1) * sds ) + slice( 1 ) + slice( sds );
+  if( gga )  bytes += 2 * slice( gds );
+  if( mgga ) bytes += 2 * slice( sds );
+  if( mgga and needs_laplacian ) bytes += 2 * slice( sds );
+  return bytes;
+
+}
+
+/// Size the U/V variable buffers of host_data for npts points
+template <typename HostData>
+void xc_resize_point_buffers( HostData& host_data, XCFamily family, 
+  size_t sds, size_t gds, bool needs_laplacian, size_t npts ) {
+
+  const bool gga  = family != XCFamily::LDA;
+  const bool mgga = family == XCFamily::MGGA;
+  host_data.den_scr.resize( (gga ? 4 : 1) * sds * npts );
+  host_data.eps    .resize( npts );
+  host_data.vrho   .resize( sds * npts );
+  if( gga ) {
+    host_data.gamma .resize( gds * npts );
+    host_data.vgamma.resize( gds * npts );
+  }
+  if( mgga ) {
+    host_data.tau .resize( sds * npts );
+    host_data.vtau.resize( sds * npts );
+  }
+  if( mgga and needs_laplacian ) {
+    host_data.lapl .resize( sds * npts );
+    host_data.vlapl.resize( sds * npts );
+  }
+
+}
+
+/**
+ *  Operands of a task for the given collocation B and X/Z (M) matrices Z
+ *  (leading dimension ldz, the Z spin component of UKS in rows
+ *  [nbe, 2*nbe)). The U/V variables are sized and aliased in the per-point
+ *  buffers of host_data.
+ */
+template <XCFamily Family, XCSpin Spin, typename HostData>
+XCTaskTileData xc_task_data( int32_t npts, int32_t nbe, const double* weights,
+  const double* B, double* Z, int32_t ldz, bool needs_laplacian,
+  HostData& host_data ) {
+
+  constexpr bool    gga  = Family != XCFamily::LDA;
+  constexpr bool    mgga = Family == XCFamily::MGGA;
+  constexpr int32_t sds  = xc_sds<Spin>;
+  constexpr int32_t gds  = xc_gds<Spin>;
+  const bool lapl = mgga and needs_laplacian;
+
+  xc_resize_point_buffers( host_data, Family, sds, gds, needs_laplacian,
+    npts );
+
+  const size_t bsz = size_t(npts) * nbe;
+  const size_t zsz = size_t(npts) * ldz;
+  const size_t dsz = size_t(npts) * sds;
+
+  XCTaskTileData d;
+  d.npts    = npts;
+  d.nbe     = nbe;
+  d.ldz     = ldz;
+  d.weights = weights;
+  d.basis   = B;
+  d.zmat    = Z;
+  d.zmat_z  = Spin == XCSpin::RKS ? nullptr : Z + nbe;
+  d.den     = host_data.den_scr.data();
+  d.eps     = host_data.eps.data();
+  d.vrho    = host_data.vrho.data();
+  if( gga ) {
+    d.dbasis_x = B + bsz;
+    d.dbasis_y = B + 2 * bsz;
+    d.dbasis_z = B + 3 * bsz;
+    d.dden_x   = d.den + dsz;
+    d.dden_y   = d.den + 2 * dsz;
+    d.dden_z   = d.den + 3 * dsz;
+    d.gamma    = host_data.gamma.data();
+    d.vgamma   = host_data.vgamma.data();
+  }
+  if( mgga ) {
+    d.mmat_x = Z + zsz;
+    d.mmat_y = Z + 2 * zsz;
+    d.mmat_z = Z + 3 * zsz;
+    if( d.zmat_z ) {
+      d.mmat_x_z = d.zmat_z + zsz;
+      d.mmat_y_z = d.zmat_z + 2 * zsz;
+      d.mmat_z_z = d.zmat_z + 3 * zsz;
+    }
+    d.tau  = host_data.tau.data();
+    d.vtau = host_data.vtau.data();
+  }
+  if( lapl ) {
+    d.lbasis = B + 4 * bsz;
+    d.lapl   = host_data.lapl.data();
+    d.vlapl  = host_data.vlapl.data();
+  }
+
+  return d;
+
+}
+
+/// Number of points of a tile whose per-point data spans pt_bytes
+inline int32_t xc_tile_npts( size_t tile_bytes, size_t pt_bytes, 
+  int32_t npts ) {
+  if( not tile_bytes ) return std::max( npts, 1 );
+  return std::max<size_t>( 8, tile_bytes / pt_bytes );
+}
+
+/// View of the points [ip, ip + npts) of a task
+template <XCSpin Spin>
+XCTaskTileData xc_task_tile( const XCTaskTileData& d, int32_t ip, 
+  int32_t npts ) {
+
+  constexpr int32_t sds = xc_sds<Spin>;
+  constexpr int32_t gds = xc_gds<Spin>;
+  auto at = [&]( auto* ptr, int64_t stride ) {
+    return ptr ? ptr + size_t(ip) * stride : ptr;
+  };
+
+  XCTaskTileData t;
+  t.npts = npts;
+  t.nbe  = d.nbe;
+  t.ldz  = d.ldz;
+
+  t.weights  = at( d.weights,  1     );
+  t.basis    = at( d.basis,    d.nbe );
+  t.dbasis_x = at( d.dbasis_x, d.nbe );
+  t.dbasis_y = at( d.dbasis_y, d.nbe );
+  t.dbasis_z = at( d.dbasis_z, d.nbe );
+  t.lbasis   = at( d.lbasis,   d.nbe );
+
+  t.zmat     = at( d.zmat,     d.ldz );
+  t.zmat_z   = at( d.zmat_z,   d.ldz );
+  t.mmat_x   = at( d.mmat_x,   d.ldz );
+  t.mmat_y   = at( d.mmat_y,   d.ldz );
+  t.mmat_z   = at( d.mmat_z,   d.ldz );
+  t.mmat_x_z = at( d.mmat_x_z, d.ldz );
+  t.mmat_y_z = at( d.mmat_y_z, d.ldz );
+  t.mmat_z_z = at( d.mmat_z_z, d.ldz );
+
+  t.den    = at( d.den,    sds );
+  t.dden_x = at( d.dden_x, sds );
+  t.dden_y = at( d.dden_y, sds );
+  t.dden_z = at( d.dden_z, sds );
+  t.gamma  = at( d.gamma,  gds );
+  t.tau    = at( d.tau,    sds );
+  t.lapl   = at( d.lapl,   sds );
+  t.eps    = at( d.eps,    1   );
+  t.vrho   = at( d.vrho,   sds );
+  t.vgamma = at( d.vgamma, gds );
+  t.vtau   = at( d.vtau,   sds );
+  t.vlapl  = at( d.vlapl,  sds );
+
+  return t;
+
+}
+
+/// U and V variables (density and derivatives) from X (and M for MGGA)
+template <XCFamily Family, XCSpin Spin>
+void xc_task_uvvar( LocalHostWorkDriver* lwd, const XCTaskTileData& d ) {
+
+  constexpr bool rks = Spin == XCSpin::RKS;
+  const int32_t npts = d.npts;
+  const int32_t nbe  = d.nbe;
+  const int32_t ldz  = d.ldz;
+
+  if constexpr ( Family == XCFamily::MGGA ) {
+    if constexpr ( rks )
+      lwd->eval_uvvar_mgga_rks( npts, nbe, d.basis, d.dbasis_x, d.dbasis_y,
+        d.dbasis_z, d.lbasis, d.zmat, ldz, d.mmat_x, d.mmat_y, d.mmat_z, ldz,
+        d.den, d.dden_x, d.dden_y, d.dden_z, d.gamma, d.tau, d.lapl );
+    else
+      lwd->eval_uvvar_mgga_uks( npts, nbe, d.basis, d.dbasis_x, d.dbasis_y,
+        d.dbasis_z, d.lbasis, d.zmat, ldz, d.zmat_z, ldz, d.mmat_x, d.mmat_y,
+        d.mmat_z, ldz, d.mmat_x_z, d.mmat_y_z, d.mmat_z_z, ldz, d.den,
+        d.dden_x, d.dden_y, d.dden_z, d.gamma, d.tau, d.lapl );
+  } else if constexpr ( Family == XCFamily::GGA ) {
+    if constexpr ( rks )
+      lwd->eval_uvvar_gga_rks( npts, nbe, d.basis, d.dbasis_x, d.dbasis_y,
+        d.dbasis_z, d.zmat, ldz, d.den, d.dden_x, d.dden_y, d.dden_z, 
+        d.gamma );
+    else
+      lwd->eval_uvvar_gga_uks( npts, nbe, d.basis, d.dbasis_x, d.dbasis_y,
+        d.dbasis_z, d.zmat, ldz, d.zmat_z, ldz, d.den, d.dden_x, d.dden_y,
+        d.dden_z, d.gamma );
+  } else {
+    if constexpr ( rks )
+      lwd->eval_uvvar_lda_rks( npts, nbe, d.basis, d.zmat, ldz, d.den );
+    else
+      lwd->eval_uvvar_lda_uks( npts, nbe, d.basis, d.zmat, ldz, d.zmat_z, 
+        ldz, d.den );
+  }
+
+}
+
+/// XC functional on the U variables, i.e. EPS and the V variables
+template <XCFamily Family>
+void xc_task_functional( const functional_type& func, 
+  const XCTaskTileData& d ) {
+
+  if constexpr ( Family == XCFamily::MGGA )
+    func.eval_exc_vxc( d.npts, d.den, d.gamma, d.lapl, d.tau, d.eps, d.vrho,
+      d.vgamma, d.vlapl, d.vtau );
+  else if constexpr ( Family == XCFamily::GGA )
+    func.eval_exc_vxc( d.npts, d.den, d.gamma, d.eps, d.vrho, d.vgamma );
+  else
+    func.eval_exc_vxc( d.npts, d.den, d.eps, d.vrho );
+
+}
+
+/**
+ *  Weight scaling of the V variables, scalar integrations and Z (M) 
+ *  matrices. Increments the (weighted) EXC and N_EL contributions.
+ */
+template <XCFamily Family, XCSpin Spin>
+void xc_task_zmat( LocalHostWorkDriver* lwd, const XCTaskTileData& d,
+  bool needs_laplacian, bool eval_vxc, double& EXC, double& N_EL ) {
+
+  constexpr bool    rks  = Spin   == XCSpin::RKS;
+  constexpr bool    gga  = Family == XCFamily::GGA;
+  constexpr bool    mgga = Family == XCFamily::MGGA;
+  constexpr int32_t sds  = xc_sds<Spin>;
+  constexpr int32_t gds  = xc_gds<Spin>;
+
+  const int32_t npts = d.npts;
+  const int32_t nbe  = d.nbe;
+  const int32_t ldz  = d.ldz;
+
+  for( int32_t i = 0; i < npts; ++i ) {
+    const auto w = d.weights[i];
+    const auto n = rks ? d.den[i] : (d.den[2*i] + d.den[2*i+1]);
+    N_EL += w * n;
+    EXC  += w * d.eps[i] * n;
+
+    for( int32_t k = 0; k < sds; ++k ) d.vrho[sds*i + k] *= w;
+    if constexpr ( gga or mgga )
+      for( int32_t k = 0; k < gds; ++k ) d.vgamma[gds*i + k] *= w;
+    if constexpr ( mgga ) {
+      for( int32_t k = 0; k < sds; ++k ) d.vtau[sds*i + k] *= w;
+      if( needs_laplacian )
+        for( int32_t k = 0; k < sds; ++k ) d.vlapl[sds*i + k] *= w;
+    }
+  }
+
+  if( not eval_vxc ) return;
+
+  if constexpr ( mgga ) {
+    if constexpr ( rks ) {
+      lwd->eval_zmat_mgga_vxc_rks( npts, nbe, d.vrho, d.vgamma, d.vlapl, 
+        d.basis, d.dbasis_x, d.dbasis_y, d.dbasis_z, d.lbasis, d.dden_x, 
+        d.dden_y, d.dden_z, d.zmat, ldz );
+      lwd->eval_mmat_mgga_vxc_rks( npts, nbe, d.vtau, d.vlapl, d.dbasis_x,
+        d.dbasis_y, d.dbasis_z, d.mmat_x, d.mmat_y, d.mmat_z, ldz );
+    } else {
+      lwd->eval_zmat_mgga_vxc_uks( npts, nbe, d.vrho, d.vgamma, d.vlapl, 
+        d.basis, d.dbasis_x, d.dbasis_y, d.dbasis_z, d.lbasis, d.dden_x, 
+        d.dden_y, d.dden_z, d.zmat, ldz, d.zmat_z, ldz );
+      lwd->eval_mmat_mgga_vxc_uks( npts, nbe, d.vtau, d.vlapl, d.dbasis_x,
+        d.dbasis_y, d.dbasis_z, d.mmat_x, d.mmat_y, d.mmat_z, ldz, d.mmat_x_z,
+        d.mmat_y_z, d.mmat_z_z, ldz );
+    }
+  } else if constexpr ( gga ) {
+    if constexpr ( rks )
+      lwd->eval_zmat_gga_vxc_rks( npts, nbe, d.vrho, d.vgamma, d.basis, 
+        d.dbasis_x, d.dbasis_y, d.dbasis_z, d.dden_x, d.dden_y, d.dden_z, 
+        d.zmat, ldz );
+    else
+      lwd->eval_zmat_gga_vxc_uks( npts, nbe, d.vrho, d.vgamma, d.basis, 
+        d.dbasis_x, d.dbasis_y, d.dbasis_z, d.dden_x, d.dden_y, d.dden_z, 
+        d.zmat, ldz, d.zmat_z, ldz );
+  } else {
+    if constexpr ( rks )
+      lwd->eval_zmat_lda_vxc_rks( npts, nbe, d.vrho, d.basis, d.zmat, ldz );
+    else
+      lwd->eval_zmat_lda_vxc_uks( npts, nbe, d.vrho, d.basis, d.zmat, ldz, 
+        d.zmat_z, ldz );
+  }
+
+}
+
+/**
+ *  Point tiled EXC/VXC pipeline of a single task
+ *
+ *  Given X = fac * P * B (and the M matrices for MGGA), the U/V variables,
+ *  the functional, the weight scaling and the Z (M) matrices are evaluated
+ *  tile by tile of tile_npts points, such that the collocation and X/Z
+ *  data of a tile remain in cache between the passes. Increments the
+ *  (weighted) EXC and N_EL contributions of the task.
+ */
+template <XCFamily Family, XCSpin Spin>
+void xc_task_tile_pipeline( LocalHostWorkDriver* lwd,
+  const functional_type& func, const XCTaskTileData& d, int32_t tile_npts,
+  bool needs_laplacian, bool eval_vxc, double& EXC, double& N_EL ) {
+
+  tile_npts = std::max( tile_npts, 1 );
+  for( int32_t ip = 0; ip < d.npts; ip += tile_npts ) {
+    const auto t = xc_task_tile<Spin>( d, ip, std::min(tile_npts, d.npts - ip) );
+    xc_task_uvvar<Family,Spin>( lwd, t );
+    xc_task_functional<Family>( func, t );
+    xc_task_zmat<Family,Spin>( lwd, t, needs_laplacian, eval_vxc, EXC, N_EL );
+  }
+
+}
+
+/**
+ *  XC functional of several (small) tasks in a single call
+ *
+ *  The U variables of the tasks are gathered into the contiguous buffers
+ *  of buf, the functional is evaluated once and EPS / V variables are
+ *  scattered back to the tasks.
+ */
+template <XCFamily Family, XCSpin Spin, typename HostData>
+void xc_task_functional_batch( const functional_type& func, 
+  const XCTaskTileData* tasks, size_t ntasks, bool needs_laplacian,
+  HostData& buf ) {
+
+  constexpr bool    gga  = Family == XCFamily::GGA;
+  constexpr bool    mgga = Family == XCFamily::MGGA;
+  constexpr int32_t sds  = xc_sds<Spin>;
+  constexpr int32_t gds  = xc_gds<Spin>;
+  const bool lapl = mgga and needs_laplacian;
+
+  size_t npts = 0;
+  for( size_t k = 0; k < ntasks; ++k ) npts += tasks[k].npts;
+
+  buf.den_scr.resize( sds * npts );
+  buf.eps    .resize( npts );
+  buf.vrho   .resize( sds * npts );
+  if( gga or mgga ) {
+    buf.gamma .resize( gds * npts );
+    buf.vgamma.resize( gds * npts );
+  }
+  if( mgga ) {
+    buf.tau .resize( sds * npts );
+    buf.vtau.resize( sds * npts );
+  }
+  if( lapl ) {
+    buf.lapl .resize( sds * npts );
+    buf.vlapl.resize( sds * npts );
+  }
+
+  XCTaskTileData b;
+  b.npts   = npts;
+  b.den    = buf.den_scr.data();
+  b.eps    = buf.eps.data();
+  b.vrho   = buf.vrho.data();
+  b.gamma  = (gga or mgga) ? buf.gamma.data()  : nullptr;
+  b.vgamma = (gga or mgga) ? buf.vgamma.data() : nullptr;
+  b.tau    = mgga ? buf.tau.data()   : nullptr;
+  b.vtau   = mgga ? buf.vtau.data()  : nullptr;
+  b.lapl   = lapl ? buf.lapl.data()  : nullptr;
+  b.vlapl  = lapl ? buf.vlapl.data() : nullptr;
+
+  // Gather U variables
+  for( size_t k = 0, ip = 0; k < ntasks; ip += tasks[k++].npts ) {
+    const auto& d = tasks[k];
+    std::copy_n( d.den, sds * d.npts, b.den + sds * ip );
+    if( b.gamma ) std::copy_n( d.gamma, gds * d.npts, b.gamma + gds * ip );
+    if( b.tau   ) std::copy_n( d.tau,   sds * d.npts, b.tau   + sds * ip );
+    if( b.lapl  ) std::copy_n( d.lapl,  sds * d.npts, b.lapl  + sds * ip );
+  }
+
+  xc_task_functional<Family>( func, b );
+
+  // Scatter EPS and V variables
+  for( size_t k = 0, ip = 0; k < ntasks; ip += tasks[k++].npts ) {
+    const auto& d = tasks[k];
+    std::copy_n( b.eps  + ip,       d.npts,       d.eps  );
+    std::copy_n( b.vrho + sds * ip, sds * d.npts, d.vrho );
+    if( b.vgamma ) std::copy_n( b.vgamma + gds * ip, gds * d.npts, d.vgamma );
+    if( b.vtau   ) std::copy_n( b.vtau   + sds * ip, sds * d.npts, d.vtau   );
+    if( b.vlapl  ) std::copy_n( b.vlapl  + sds * ip, sds * d.npts, d.vlapl  );
+  }
+
+}
+
+/**
+ *  Runtime dispatch on the functional family and spin, f is invoked with
+ *  std::integral_constant<XCFamily,...> and std::integral_constant<XCSpin,...>
+ */
+template <typename Functor>
+void xc_family_spin_dispatch( XCFamily family, XCSpin spin, Functor&& f ) {
+
+  auto with_spin = [&]( auto fam ) {
+    if( spin == XCSpin::RKS ) f( fam, std::integral_constant<XCSpin,XCSpin::RKS>{} );
+    else                      f( fam, std::integral_constant<XCSpin,XCSpin::UKS>{} );
+  };
+
+  switch( family ) {
+    case XCFamily::LDA:  
+      with_spin( std::integral_constant<XCFamily,XCFamily::LDA>{}  ); break;
+    case XCFamily::GGA:  
+      with_spin( std::integral_constant<XCFamily,XCFamily::GGA>{}  ); break;
+    case XCFamily::MGGA: 
+      with_spin( std::integral_constant<XCFamily,XCFamily::MGGA>{} ); break;
+    default: GAUXC_GENERIC_EXCEPTION("Unknown XC Family");
+  }
+
+}
+
+}
@@ -0,0 +1,88 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace GauXC::detail {
+
+/**
+ *  State of incremental (delta density) RKS EXC/VXC builds.
+ *
+ *  Retains the density matrix, EXC and VXC of the previous build together
+ *  with the density gradient and the (unweighted) XC potentials on every
+ *  grid point as of the last evaluation of the task containing the point.
+ *  The per-point data of task i is stored in [offset[i], offset[i+1]) of
+ *  each array (x/y/z blocks for the gradient).
+ */
+template <typename F>
+struct XCIncrementalState {
+
+  bool    valid = false;
+  int64_t nbf   = 0;
+  size_t  plan_generation = 0; ///< XCExecutionPlan build of the task order
+
+  std::vector<F> P;    ///< Density of the previous build (nbf,nbf)
+  std::vector<F> VXC;  ///< VXC of the previous build (nbf,nbf), reduced
+  F              EXC  = 0.;
+  F              N_EL = 0.;
+
+  std::vector<size_t> offset;   ///< Point offsets of the tasks
+  std::vector<F>      exc_task; ///< Local EXC contribution of each task
+  std::vector<F>      nel_task; ///< Local N_EL contribution of each task
+  std::vector<double> dP_skip;  ///< Sum of the skipped dP blocks of each task
+
+  std::vector<F> dden;
+  std::vector<F> vrho, vgamma, vtau, vlapl;
+
+  /// Reset to the state of P = 0 for the given tasks
+  template <typename TaskIterator>
+  void reset( int64_t _nbf, size_t _plan_generation, TaskIterator task_begin,
+    TaskIterator task_end, bool gga, bool mgga, bool lapl_needed ) {
+
+    nbf  = _nbf;
+    plan_generation = _plan_generation;
+    EXC  = 0.;
+    N_EL = 0.;
+    P  .assign( nbf * nbf, 0. );
+    VXC.assign( nbf * nbf, 0. );
+
+    const size_t ntasks = std::distance( task_begin, task_end );
+    offset.resize( ntasks + 1 );
+    offset[0] = 0;
+    for( size_t i = 0; i < ntasks; ++i )
+      offset[i+1] = offset[i] + (task_begin + i)->points.size();
+    const size_t npts = offset.back();
+
+    exc_task.assign( ntasks, 0. );
+    nel_task.assign( ntasks, 0. );
+    dP_skip .assign( ntasks, 0. );
+
+    auto alloc = []( std::vector<F>& v, size_t sz ) {
+      v.assign( sz, 0. ); v.shrink_to_fit();
+    };
+    alloc( vrho,   npts );
+    alloc( dden,   gga  ? 3 * npts : 0 );
+    alloc( vgamma, gga  ? npts : 0 );
+    alloc( vtau,   mgga ? npts : 0 );
+    alloc( vlapl,  lapl_needed ? npts : 0 );
+
+    valid = true;
+
+  }
+
+  inline void clear() {
+    valid = false;
+    P.clear(); VXC.clear(); offset.clear(); exc_task.clear(); nel_task.clear();
+    dP_skip.clear(); dden.clear();
+    vrho.clear(); vgamma.clear(); vtau.clear(); vlapl.clear();
+  }
+
+};
+
+}
@@ -6,6 +6,7 @@
  * See LICENSE.txt for details
  */
 #include <gauxc/xc_integrator/replicated/replicated_xc_integrator_impl.hpp>
+#include <gauxc/exceptions.hpp>
 
 namespace GauXC  {
 namespace detail {
@@ -37,6 +38,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
   eval_exc( int64_t m, int64_t n, const value_type* P, int64_t ldp, 
             value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
 
+    stats_ = XCIntegratorStats{};
     eval_exc_(m,n,P,ldp,EXC,ks_settings);
 
 }
@@ -47,6 +49,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
             const value_type* Pz, int64_t ldpz,
             value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
 
+    stats_ = XCIntegratorStats{};
     eval_exc_(m,n,Ps,ldps,Pz,ldpz,EXC,ks_settings);
 
 }
@@ -59,6 +62,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
             const value_type* Px, int64_t ldpx,
             value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
 
+    stats_ = XCIntegratorStats{};
     eval_exc_(m,n,Ps,ldps,Pz,ldpz,Py,ldpy,Px,ldpx,EXC,ks_settings);
 
 }
@@ -69,6 +73,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
                 int64_t ldp, value_type* VXC, int64_t ldvxc,
                 value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
 
+    stats_ = XCIntegratorStats{};
     eval_exc_vxc_(m,n,P,ldp,VXC,ldvxc,EXC,ks_settings);
 
 }
@@ -83,6 +88,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
                       value_type* VXCz, int64_t ldvxcz,
                       value_type* EXC, const IntegratorSettingsXC& ks_settings) {
 
+    stats_ = XCIntegratorStats{};
     eval_exc_vxc_(m,n,Ps,ldps,
                       Pz,ldpz,
                       VXCs,ldvxcs,
@@ -106,6 +112,7 @@ void ReplicatedXCIntegratorImpl<ValueType>::
                       value_type* VXCx, int64_t ldvxcx,
                       value_type* EXC,  const IntegratorSettingsXC& ks_settings ) {
 
+    stats_ = XCIntegratorStats{};
     eval_exc_vxc_(m,n,Ps,ldps,
                       Pz,ldpz,
                       Py,ldpy,
@@ -117,6 +124,53 @@ void ReplicatedXCIntegratorImpl<ValueType>::
 
 }
 
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc_batch( int64_t m, int64_t n, int64_t ndm,
+                      const value_type* const* P, int64_t ldp,
+                      value_type* const* VXC, int64_t ldvxc,
+                      value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
+
+    stats_ = XCIntegratorStats{};
+    eval_exc_vxc_batch_(m,n,ndm,P,ldp,VXC,ldvxc,EXC,ks_settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_exc_vxc_batch_( int64_t m, int64_t n, int64_t ndm,
+                       const value_type* const* P, int64_t ldp,
+                       value_type* const* VXC, int64_t ldvxc,
+                       value_type* EXC, const IntegratorSettingsXC& ks_settings ) {
+
+    for( int64_t k = 0; k < ndm; ++k )
+      eval_exc_vxc_(m,n,P[k],ldp,VXC[k],ldvxc,EXC+k,ks_settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_fxc_contraction( int64_t m, int64_t n, const value_type* P, int64_t ldp,
+                        int64_t ntrial, const value_type* const* tP, int64_t ldtp,
+                        value_type* const* FXC, int64_t ldfxc,
+                        const IntegratorSettingsXC& ks_settings ) {
+
+    stats_ = XCIntegratorStats{};
+    eval_fxc_contraction_(m,n,P,ldp,ntrial,tP,ldtp,FXC,ldfxc,ks_settings);
+
+}
+
+template <typename ValueType>
+void ReplicatedXCIntegratorImpl<ValueType>::
+  eval_fxc_contraction_( int64_t, int64_t, const value_type*, int64_t,
+                         int64_t, const value_type* const*, int64_t,
+                         value_type* const*, int64_t,
+                         const IntegratorSettingsXC& ) {
+
+    GAUXC_GENERIC_EXCEPTION("FXC Contraction NYI for This Integrator");
+
+}
+
 template <typename ValueType>
 void ReplicatedXCIntegratorImpl<ValueType>::
   eval_exc_grad( int64_t m, int64_t n, const value_type* P,
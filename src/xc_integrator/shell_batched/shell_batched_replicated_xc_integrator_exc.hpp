@@ -96,6 +96,8 @@ void ShellBatchedReplicatedXCIntegrator<BaseIntegratorType, IncoreIntegratorType
     this->reduction_driver_->allreduce_inplace( &N_EL, 1    , ReductionOp::Sum );
   });
 
+  this->n_el_ = N_EL;
+
   #ifdef GAUXC_HAS_DEVICE
   device_data_ptr_.reset();
   #endif
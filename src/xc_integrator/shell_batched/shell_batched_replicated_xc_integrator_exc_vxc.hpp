@@ -12,6 +12,7 @@
 #include "device/xc_device_aos_data.hpp"
 #endif
 #include "integrator_util/integrator_common.hpp"
+#include "integrator_util/symmetric_reduction.hpp"
 #include "host/util.hpp"
 #include <gauxc/util/misc.hpp>
 #include <gauxc/util/unused.hpp>
@@ -106,14 +107,19 @@ void ShellBatchedReplicatedXCIntegrator<BaseIntegratorType, IncoreIntegratorType
     if( not this->reduction_driver_->takes_host_memory() )
       GAUXC_GENERIC_EXCEPTION("This Module Only Works With Host Reductions");
 
-    this->reduction_driver_->allreduce_inplace( VXCs, nbf*nbf, ReductionOp::Sum );
-    if(VXCz) this->reduction_driver_->allreduce_inplace( VXCz, nbf*nbf, ReductionOp::Sum );
-    if(VXCy) this->reduction_driver_->allreduce_inplace( VXCy, nbf*nbf, ReductionOp::Sum ); 
-    if(VXCx) this->reduction_driver_->allreduce_inplace( VXCx, nbf*nbf, ReductionOp::Sum );
+    // VXC is symmetric, reduce in packed storage
+    auto& rd = *this->reduction_driver_;
+    const int comm_size = this->load_balancer_->runtime().comm_size();
+    allreduce_symmetric_inplace( rd, comm_size, nbf, VXCs, ldvxcs );
+    if(VXCz) allreduce_symmetric_inplace( rd, comm_size, nbf, VXCz, ldvxcz );
+    if(VXCy) allreduce_symmetric_inplace( rd, comm_size, nbf, VXCy, ldvxcy );
+    if(VXCx) allreduce_symmetric_inplace( rd, comm_size, nbf, VXCx, ldvxcx );
     this->reduction_driver_->allreduce_inplace( EXC,   1    , ReductionOp::Sum );
     this->reduction_driver_->allreduce_inplace( &N_EL, 1    , ReductionOp::Sum );
   });
 
+  this->n_el_ = N_EL;
+
   #ifdef GAUXC_HAS_DEVICE
   device_data_ptr_.reset();
   #endif
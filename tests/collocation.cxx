@@ -9,6 +9,7 @@
 #include "collocation_host.hpp"
 #include "collocation_cuda.hpp"
 #include "collocation_hip.hpp"
+#include <gauxc/external/hdf5.hpp>
 
 //#define GENERATE_TESTS
 
@@ -53,6 +54,10 @@ TEST_CASE( "Water / cc-pVDZ", "[collocation]" ) {
   SECTION( "Host Eval Hessian" ) {
     test_host_collocation_deriv2( basis, ref_data );
   }
+
+  SECTION( "Host Native Kernel Eval" ) {
+    test_host_collocation_kernel( basis, ref_data );
+  }
 #endif
 
 #ifdef GAUXC_HAS_CUDA
@@ -92,3 +97,23 @@ TEST_CASE( "Water / cc-pVDZ", "[collocation]" ) {
 #endif
 
 }
+
+#if defined(GAUXC_HAS_HOST) && !defined(GENERATE_TESTS)
+TEST_CASE( "H2O2 / def2-QZVP", "[collocation]" ) {
+
+  // f and g shells
+  Molecule mol;
+  BasisSet<double> basis;
+  read_hdf5_record( mol,   GAUXC_REF_DATA_PATH "/h2o2_def2-qzvp.hdf5", "/MOLECULE" );
+  read_hdf5_record( basis, GAUXC_REF_DATA_PATH "/h2o2_def2-qzvp.hdf5", "/BASIS"    );
+
+  int max_l = 0;
+  for( const auto& sh : basis ) max_l = std::max( max_l, sh.l() );
+  REQUIRE( max_l >= 4 );
+
+  SECTION( "Host Native Kernel vs gau2grid" ) {
+    test_host_collocation_kernel_gau2grid( mol, basis );
+  }
+
+}
+#endif
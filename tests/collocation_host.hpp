@@ -8,6 +8,7 @@
 #ifdef GAUXC_HAS_HOST
 #include "collocation_common.hpp"
 #include "host/reference/collocation.hpp"
+#include <numeric>
 
 void generate_collocation_data( const Molecule& mol, const BasisSet<double>& basis,
                                 std::ofstream& out_file, size_t ntask_save = 10 ) {
@@ -213,5 +214,174 @@ void test_host_collocation_deriv2( const BasisSet<double>& basis, std::ifstream&
       CHECK( d2eval_zz[i] == Approx( d.d2eval_zz[i] ) );
   }
 
+}
+
+void test_host_collocation_kernel( const BasisSet<double>& basis, std::ifstream& in_file) {
+
+  std::vector<ref_collocation_data> ref_data;
+
+  {
+    cereal::BinaryInputArchive ar( in_file );
+    ar( ref_data );
+  }
+
+  for( auto& d : ref_data ) {
+
+    const auto npts = d.pts.size();
+    const auto nbf  = d.eval.size() / npts;
+
+    const auto& mask = d.mask;
+    const auto& pts  = d.pts;
+
+    std::vector<double> eval   ( nbf * npts ),
+                        deval_x( nbf * npts ),
+                        deval_y( nbf * npts ),
+                        deval_z( nbf * npts ),
+                        d2eval_xx( nbf * npts ),
+                        d2eval_xy( nbf * npts ),
+                        d2eval_xz( nbf * npts ),
+                        d2eval_yy( nbf * npts ),
+                        d2eval_yz( nbf * npts ),
+                        d2eval_zz( nbf * npts );
+
+    host_collocation( npts, mask.size(), nbf, pts.data()->data(), basis,
+      mask.data(), eval.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ) );
+
+    host_collocation_gradient( npts, mask.size(), nbf, pts.data()->data(), 
+      basis, mask.data(), eval.data(), deval_x.data(), deval_y.data(), 
+      deval_z.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_x[i] == Approx( d.deval_x[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_y[i] == Approx( d.deval_y[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( deval_z[i] == Approx( d.deval_z[i] ) );
+
+    host_collocation_hessian( npts, mask.size(), nbf,
+      pts.data()->data(), basis, mask.data(), eval.data(), 
+      deval_x.data(), deval_y.data(), deval_z.data(),
+      d2eval_xx.data(), d2eval_xy.data(), d2eval_xz.data(),
+      d2eval_yy.data(), d2eval_yz.data(), d2eval_zz.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_xx[i] == Approx( d.d2eval_xx[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_xy[i] == Approx( d.d2eval_xy[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_xz[i] == Approx( d.d2eval_xz[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_yy[i] == Approx( d.d2eval_yy[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_yz[i] == Approx( d.d2eval_yz[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( d2eval_zz[i] == Approx( d.d2eval_zz[i] ) );
+
+    std::vector<double> leval( nbf * npts );
+    host_collocation_laplacian( npts, mask.size(), nbf, pts.data()->data(),
+      basis, mask.data(), eval.data(), deval_x.data(), deval_y.data(),
+      deval_z.data(), leval.data() );
+
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( eval[i] == Approx( d.eval[i] ) );
+    for( auto i = 0; i < npts * nbf; ++i )
+      CHECK( leval[i] == 
+        Approx( d.d2eval_xx[i] + d.d2eval_yy[i] + d.d2eval_zz[i] ).margin(1e-12) );
+
+    // Sub-tile shell screening
+    XCTask task;
+    task.points = pts;
+    task.bfn_screening.shell_list = mask;
+    task.generate_shell_tile_mask( basis );
+    REQUIRE( task.has_shell_tile_mask() );
+
+    host_collocation_gradient( npts, mask.size(), nbf, pts.data()->data(), 
+      basis, mask.data(), eval.data(), deval_x.data(), deval_y.data(), 
+      deval_z.data(), task.shell_tile_mask.data() );
+
+    const auto stride = task.shell_tile_mask_stride();
+    for( auto ipt = 0ul; ipt < npts; ++ipt ) {
+      const auto* tmask = task.shell_tile_mask.data() + 
+        (ipt / XCTask::shell_tile_size) * stride;
+      size_t ibf = 0;
+      for( auto ish = 0ul; ish < mask.size(); ++ish ) {
+        const bool sig = (tmask[ish/64] >> (ish%64)) & 1;
+        for( auto j = 0ul; j < basis[mask[ish]].size(); ++j, ++ibf ) {
+          const auto i = ibf + ipt * nbf;
+          if( sig ) {
+            CHECK( eval[i]    == Approx( d.eval[i] ) );
+            CHECK( deval_x[i] == Approx( d.deval_x[i] ) );
+          } else {
+            CHECK( eval[i]    == 0. );
+            CHECK( deval_x[i] == 0. );
+            CHECK( d.eval[i]  == Approx( 0. ).margin(1e-8) );
+          }
+        }
+      }
+    }
+  }
+
+}
+
+// Native kernels vs gau2grid for arbitrary angular momenta (no reference data)
+void test_host_collocation_kernel_gau2grid( const Molecule& mol, 
+  const BasisSet<double>& basis ) {
+
+  // Points in the vicinity of each atom
+  std::default_random_engine gen;
+  std::uniform_real_distribution<double> dist( -2., 2. );
+  std::vector<std::array<double,3>> pts;
+  for( const auto& atom : mol )
+  for( int i = 0; i < 16; ++i )
+    pts.push_back( {atom.x + dist(gen), atom.y + dist(gen), atom.z + dist(gen)} );
+
+  std::vector<int32_t> mask( basis.nshells() );
+  std::iota( mask.begin(), mask.end(), 0 );
+
+  const size_t npts = pts.size();
+  const size_t nbf  = basis.nbf();
+
+  using vec = std::vector<double>;
+  vec eval( nbf*npts ), dx( nbf*npts ), dy( nbf*npts ), dz( nbf*npts ),
+      dxx( nbf*npts ), dxy( nbf*npts ), dxz( nbf*npts ), dyy( nbf*npts ),
+      dyz( nbf*npts ), dzz( nbf*npts );
+  vec ref_eval( eval ), ref_dx( dx ), ref_dy( dy ), ref_dz( dz ), 
+      ref_dxx( dxx ), ref_dxy( dxy ), ref_dxz( dxz ), ref_dyy( dyy ), 
+      ref_dyz( dyz ), ref_dzz( dzz ), leval( nbf*npts );
+
+  gau2grid_collocation_hessian( npts, mask.size(), nbf, pts.data()->data(), 
+    basis, mask.data(), ref_eval.data(), ref_dx.data(), ref_dy.data(), 
+    ref_dz.data(), ref_dxx.data(), ref_dxy.data(), ref_dxz.data(), 
+    ref_dyy.data(), ref_dyz.data(), ref_dzz.data() );
+
+  auto check = []( const vec& a, const vec& ref ) {
+    for( size_t i = 0; i < a.size(); ++i )
+      CHECK( a[i] == Approx( ref[i] ).margin(1e-10) );
+  };
+
+  host_collocation( npts, mask.size(), nbf, pts.data()->data(), basis,
+    mask.data(), eval.data() );
+  check( eval, ref_eval );
+
+  host_collocation_hessian( npts, mask.size(), nbf, pts.data()->data(), 
+    basis, mask.data(), eval.data(), dx.data(), dy.data(), dz.data(), 
+    dxx.data(), dxy.data(), dxz.data(), dyy.data(), dyz.data(), dzz.data() );
+  check( eval, ref_eval );
+  check( dx,  ref_dx  ); check( dy,  ref_dy  ); check( dz,  ref_dz  );
+  check( dxx, ref_dxx ); check( dxy, ref_dxy ); check( dxz, ref_dxz );
+  check( dyy, ref_dyy ); check( dyz, ref_dyz ); check( dzz, ref_dzz );
+
+  host_collocation_laplacian( npts, mask.size(), nbf, pts.data()->data(),
+    basis, mask.data(), eval.data(), dx.data(), dy.data(), dz.data(), 
+    leval.data() );
+  for( size_t i = 0; i < leval.size(); ++i )
+    CHECK( leval[i] == 
+      Approx( ref_dxx[i] + ref_dyy[i] + ref_dzz[i] ).margin(1e-10) );
+
 }
 #endif
@@ -0,0 +1,542 @@
+/**
+ * GauXC Copyright (c) 2020-2024, The Regents of the University of California,
+ * through Lawrence Berkeley National Laboratory (subject to receipt of
+ * any required approvals from the U.S. Dept. of Energy). All rights reserved.
+ *
+ * See LICENSE.txt for details
+ */
+#include "ut_common.hpp"
+#include <gauxc/gauxc_config.hpp>
+
+#ifdef GAUXC_HAS_HOST
+#include <gauxc/xc_integrator/local_work_driver.hpp>
+#include "host/local_host_work_driver.hpp"
+#include "host/host_accumulator.hpp"
+#include "host/blas.hpp"
+#include "host/util.hpp"
+#include "host/small_gemm.hpp"
+#include "host/host_scratch_arena.hpp"
+#include <gauxc/basisset_map.hpp>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+using namespace GauXC;
+
+using submat_map_t = std::vector<std::array<int32_t,3>>;
+
+namespace {
+
+template <typename T>
+std::vector<T> random_matrix( size_t m, size_t n, std::default_random_engine& gen ) {
+  std::uniform_real_distribution<T> dist(-1., 1.);
+  std::vector<T> A( m*n );
+  for( auto& x : A ) x = dist(gen);
+  return A;
+}
+
+/// Cuts {start, length, offset} of [0,n) which skip every other cut
+submat_map_t strided_map( int32_t n, int32_t cut, int32_t gap ) {
+  submat_map_t map;
+  int32_t off = 0;
+  for( int32_t i = 0; i + cut <= n; i += cut + gap ) {
+    map.push_back( {i, cut, off} );
+    off += cut;
+  }
+  return map;
+}
+
+int32_t map_size( const submat_map_t& map ) {
+  int32_t n = 0;
+  for( auto& cut : map ) n += cut[1];
+  return n;
+}
+
+/// ABig(cut rows, cut cols) += ASmall
+void scatter_add( int32_t LDAB, double* ABig, const double* ASmall,
+  int32_t LDAS, const submat_map_t& rows, const submat_map_t& cols ) {
+  int32_t i = 0;
+  for( auto& iCut : rows ) {
+    int32_t j = 0;
+  for( auto& jCut : cols ) {
+    for( int32_t jj = 0; jj < jCut[1]; ++jj )
+    for( int32_t ii = 0; ii < iCut[1]; ++ii )
+      ABig[iCut[0] + ii + (jCut[0] + jj)*LDAB] += ASmall[i + ii + (j + jj)*LDAS];
+    j += jCut[1];
+  }
+    i += iCut[1];
+  }
+}
+
+template <typename T>
+T max_abs_diff( size_t n, const T* A, const T* B ) {
+  T d = 0.;
+  for( size_t i = 0; i < n; ++i ) d = std::max( d, std::abs(A[i] - B[i]) );
+  return d;
+}
+
+/// Chain of natoms atoms (spacing 3 bohr) with s, s, p and d shells each
+std::pair<Molecule, BasisSet<double>> shell_chain( int32_t natoms ) {
+  Molecule mol;
+  BasisSet<double> basis;
+  Shell<double>::prim_array alpha = {0.8}, coeff = {1.};
+  for( int32_t iA = 0; iA < natoms; ++iA ) {
+    const double z = 3. * iA;
+    mol.emplace_back( AtomicNumber(1), 0., 0., z );
+    for( int l : {0, 0, 1, 2} )
+      basis.emplace_back( PrimSize(1), AngularMomentum(l), 
+        SphericalType(l > 1), alpha, coeff, Shell<double>::cart_array{0., 0., z} );
+  }
+  return { mol, basis };
+}
+
+/// Density with the atom pair blocks of atoms further than band apart zeroed,
+/// and the largest |P| of each shell pair block
+std::pair<std::vector<double>, std::vector<double>> banded_density( 
+  const BasisSetMap& basis_map, int32_t nbf, int32_t band, 
+  std::default_random_engine& gen ) {
+
+  const int32_t nshells = basis_map.shell_sizes().size();
+  auto P = random_matrix<double>( nbf, nbf, gen );
+  std::vector<double> norms( nshells * nshells, 0. );
+  for( int32_t jsh = 0; jsh < nshells; ++jsh )
+  for( int32_t ish = 0; ish < nshells; ++ish ) {
+    const auto [i_st, i_en] = basis_map.shell_to_ao_range(ish);
+    const auto [j_st, j_en] = basis_map.shell_to_ao_range(jsh);
+    const bool zero = std::abs( basis_map.shell_to_center(ish) - 
+                                basis_map.shell_to_center(jsh) ) > band;
+    for( int32_t j = j_st; j < j_en; ++j )
+    for( int32_t i = i_st; i < i_en; ++i ) {
+      if( zero ) P[i + j*nbf] = 0.;
+      norms[ish + jsh*nshells] = std::max( norms[ish + jsh*nshells],
+        std::abs(P[i + j*nbf]) );
+    }
+  }
+  return { P, norms };
+}
+
+/// Compressed submatrix map of the given shells
+submat_map_t shell_submat_map( const BasisSetMap& basis_map, 
+  const std::vector<int32_t>& shell_list ) {
+  submat_map_t map;
+  int32_t off = 0;
+  for( auto ish : shell_list ) {
+    const auto [st, en] = basis_map.shell_to_ao_range(ish);
+    if( map.size() and map.back()[0] + map.back()[1] == int32_t(st) )
+      map.back()[1] += en - st;
+    else
+      map.push_back( {int32_t(st), int32_t(en - st), off} );
+    off += en - st;
+  }
+  return map;
+}
+
+template <typename T>
+void check_small_syr2k( T tol ) {
+
+  std::default_random_engine gen(5678);
+  const T nan = std::numeric_limits<T>::quiet_NaN();
+
+  // Lower triangle SYR2K, N tails w.r.t. the 4,1 column panels exercise all
+  // diagonal offsets of the tiles. The strict upper triangle is untouched.
+  for( int N : {1, 2, 3, 5, 8, 13, 30, 45} )
+  for( int K : {1, 11, 40} )
+  for( T beta : {T(0), T(0.5)} ) {
+    const int lda = N + 1, ldb = N + 2, ldc = N + 3;
+    const auto A = random_matrix<T>( lda, K, gen );
+    const auto B = random_matrix<T>( ldb, K, gen );
+    auto C = random_matrix<T>( ldc, N, gen );
+    if( beta == T(0) )
+      for( int j = 0; j < N; ++j )
+      for( int i = j; i < N; ++i ) C[i + j*ldc] = nan;
+    auto C_ref = C;
+
+    blas::syr2k( 'L', 'N', N, K, T(0.7), A.data(), lda, B.data(), ldb, beta,
+      C_ref.data(), ldc );
+    detail::small_gemm_impl::syr2k( N, K, T(0.7), A.data(), lda, B.data(), ldb,
+      beta, C.data(), ldc );
+    for( int j = 0; j < N; ++j )
+    for( int i = 0; i < N; ++i ) {
+      INFO( "N = " << N << " K = " << K << " i = " << i << " j = " << j );
+      if( i < j ) CHECK( C[i + j*ldc] == C_ref[i + j*ldc] );
+      else        CHECK( std::abs(C[i + j*ldc] - C_ref[i + j*ldc]) < tol );
+    }
+
+    C = C_ref;
+    detail::small_syr2k( 'L', 'N', N, K, T(1.), A.data(), lda, B.data(), ldb,
+      T(1.), C.data(), ldc );
+    blas::syr2k( 'L', 'N', N, K, T(1.), A.data(), lda, B.data(), ldb, T(1.),
+      C_ref.data(), ldc );
+    CHECK( max_abs_diff( C.size(), C.data(), C_ref.data() ) < tol );
+  }
+
+}
+
+}
+
+TEST_CASE("Small SYR2K", "[host-kernels]") {
+  SECTION("Double") { check_small_syr2k<double>( 1e-12 ); }
+  SECTION("Float")  { check_small_syr2k<float>( 1e-4 ); }
+}
+
+// Timings which back small_syr2k_max_dim, run with
+//   gauxc_test "[small-syr2k-bench]"
+TEST_CASE("Small SYR2K Timings", "[.][small-syr2k-bench]") {
+
+  auto time_us = []( auto&& f ) {
+    f();
+    size_t nrep = 0;
+    double dur  = 0.;
+    auto st = std::chrono::high_resolution_clock::now();
+    do {
+      f(); ++nrep;
+      dur = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - st ).count();
+    } while( dur < 0.1 );
+    return 1e6 * dur / nrep;
+  };
+
+  std::default_random_engine gen(1);
+  std::printf( "%6s %6s | %10s %10s\n", "NBE", "NPTS", "SYR2K", "BLAS" );
+  for( int npts : {16, 128, 512} )
+  for( int nbe  : {8, 16, 24, 32, 48, 64} ) {
+    const auto B = random_matrix<double>( nbe, npts, gen );
+    const auto Z = random_matrix<double>( nbe, npts, gen );
+    std::vector<double> V( nbe*nbe );
+
+    const double t_s = time_us( [&]() { detail::small_gemm_impl::syr2k( nbe,
+      npts, 1., B.data(), nbe, Z.data(), nbe, 0., V.data(), nbe ); } );
+    const double b_s = time_us( [&]() { blas::syr2k( 'L', 'N', nbe, npts, 1.,
+      B.data(), nbe, Z.data(), nbe, 0., V.data(), nbe ); } );
+
+    std::printf( "%6d %6d | %10.2f %10.2f\n", nbe, npts, t_s, b_s );
+  }
+
+}
+
+TEST_CASE("Host Submatrix Kernels", "[host-kernels]") {
+
+  std::default_random_engine gen(1234);
+
+  const int32_t nbf  = 211;
+  const int32_t npts = 37;
+
+  // Few long cuts (in place) / many short cuts (packed)
+  const auto contig_map = strided_map( nbf, 48, 5 );
+  const auto frag_map   = strided_map( nbf, 4,  3 );
+  REQUIRE(     detail::use_inplace_submat( contig_map, contig_map ) );
+  REQUIRE( not detail::use_inplace_submat( frag_map,   frag_map   ) );
+
+  auto lwd_ptr = LocalWorkDriverFactory::make_local_work_driver(
+    ExecutionSpace::Host, "Reference" );
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>( lwd_ptr.get() );
+  REQUIRE( lwd );
+
+  const auto P = random_matrix<double>( nbf, nbf, gen );
+
+  for( const auto* map_ptr : { &contig_map, &frag_map } ) {
+
+    const auto& map = *map_ptr;
+    const int32_t nbe = map_size( map );
+    const bool inplace = map_ptr == &contig_map;
+
+    SECTION( std::string("gemm_submat_a ") + (inplace ? "Contiguous" : "Fragmented") ) {
+      const auto B = random_matrix<double>( nbe, npts, gen );
+      auto C = random_matrix<double>( nbe, npts, gen );
+      auto C_ref = C;
+
+      // Packed reference
+      std::vector<double> P_sub( nbe*nbe );
+      detail::submat_set( nbf, nbf, nbe, nbe, P.data(), nbf, P_sub.data(), nbe,
+        map );
+      blas::gemm( 'N', 'N', nbe, npts, nbe, 0.5, P_sub.data(), nbe, B.data(),
+        nbe, 2., C_ref.data(), nbe );
+
+      detail::gemm_submat_a( npts, 0.5, P.data(), nbf, map, map, B.data(), nbe,
+        2., C.data(), nbe );
+      CHECK( max_abs_diff( C.size(), C.data(), C_ref.data() ) < 1e-12 );
+    }
+
+    SECTION( std::string("inc_vxc ") + (inplace ? "Contiguous" : "Fragmented") ) {
+      const auto B = random_matrix<double>( nbe, npts, gen );
+      const auto Z = random_matrix<double>( nbe, npts, gen );
+      std::vector<double> scr( nbe*nbe );
+
+      // Reference: LT(B*Z**T + Z*B**T) scattered into VXC
+      std::vector<double> W( nbe*nbe ), VXC_ref( nbf*nbf, 0. );
+      blas::gemm( 'N', 'T', nbe, nbe, npts, 1., B.data(), nbe, Z.data(), nbe,
+        0., W.data(), nbe );
+      blas::gemm( 'N', 'T', nbe, nbe, npts, 1., Z.data(), nbe, B.data(), nbe,
+        1., W.data(), nbe );
+      scatter_add( nbf, VXC_ref.data(), W.data(), nbe, map, map );
+      for( int32_t j = 0; j < nbf; ++j )
+      for( int32_t i = 0; i < j;   ++i ) VXC_ref[i + j*nbf] = 0.;
+
+      // ThreadPrivate exposes the target, i.e. takes the in place path when
+      // the map allows it. Atomic always packs.
+      for( auto strat : { HostAccumulation::ThreadPrivate,
+                          HostAccumulation::Atomic } ) {
+        std::vector<double> VXC( nbf*nbf, 0. );
+        HostSubmatAccumulator acc( strat, nbf, nbf, VXC.data(), nbf, 0, true );
+        lwd->inc_vxc( npts, nbf, nbe, B.data(), map, Z.data(), nbe, acc,
+          scr.data() );
+        acc.finalize();
+        CHECK( max_abs_diff( VXC.size(), VXC.data(), VXC_ref.data() ) < 1e-12 );
+      }
+    }
+
+    SECTION( std::string("inc_exx_k ") + (inplace ? "Contiguous" : "Fragmented") ) {
+      const auto B = random_matrix<double>( nbe, npts, gen );
+      const auto G = random_matrix<double>( nbe, npts, gen );
+      std::vector<double> scr( nbe*nbe );
+
+      // Reference: B*G**T scattered into K
+      std::vector<double> W( nbe*nbe ), K_ref( nbf*nbf, 0. );
+      blas::gemm( 'N', 'T', nbe, nbe, npts, 1., B.data(), nbe, G.data(), nbe,
+        0., W.data(), nbe );
+      scatter_add( nbf, K_ref.data(), W.data(), nbe, map, map );
+
+      for( auto strat : { HostAccumulation::ThreadPrivate,
+                          HostAccumulation::Atomic } ) {
+        std::vector<double> K( nbf*nbf, 0. );
+        HostSubmatAccumulator acc( strat, nbf, nbf, K.data(), nbf, 0 );
+        lwd->inc_exx_k( npts, nbf, nbe, nbe, B.data(), map, map, G.data(), nbe,
+          acc, scr.data() );
+        acc.finalize();
+        CHECK( max_abs_diff( K.size(), K.data(), K_ref.data() ) < 1e-12 );
+      }
+    }
+
+  }
+
+}
+TEST_CASE("Block Sparse X Matrix", "[host-kernels]") {
+
+  std::default_random_engine gen(4321);
+
+  auto [ mol, basis ] = shell_chain( 8 );
+  BasisSetMap basis_map( basis, mol );
+  const int32_t nbf     = basis.nbf();
+  const int32_t nshells = basis.nshells();
+  const int32_t npts    = 23;
+
+  auto lwd_ptr = LocalWorkDriverFactory::make_local_work_driver(
+    ExecutionSpace::Host, "Reference" );
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>( lwd_ptr.get() );
+  REQUIRE( lwd );
+
+  // All shells (single cut) and the shells of atoms 0-2 and 5-7 (two cuts)
+  std::vector<int32_t> all_shells( nshells ), split_shells;
+  std::iota( all_shells.begin(), all_shells.end(), 0 );
+  for( auto ish : all_shells ) {
+    const auto iA = basis_map.shell_to_center(ish);
+    if( iA < 3 or iA > 4 ) split_shells.emplace_back( ish );
+  }
+
+  // Banded (block sparse) and full (dense fallback) densities
+  for( int32_t band : { 0, 1, 8 } )
+  for( const auto* shell_list : { &all_shells, &split_shells } ) {
+    const auto [ P, norms ] = banded_density( basis_map, nbf, band, gen );
+    const auto map = shell_submat_map( basis_map, *shell_list );
+    const int32_t nbe = map_size( map );
+
+    SECTION( "Band " + std::to_string(band) + 
+      (shell_list == &all_shells ? " Contiguous" : " Fragmented") ) {
+      const auto B = random_matrix<double>( nbe, npts, gen );
+      std::vector<double> X( nbe*npts ), X_ref( nbe*npts ), scr( nbe*nbe );
+
+      lwd->eval_xmat( npts, nbf, nbe, map, 2., P.data(), nbf, B.data(), nbe,
+        X_ref.data(), nbe, scr.data() );
+      lwd->eval_xmat_block_sparse( npts, nbf, nbe, map, shell_list->size(),
+        shell_list->data(), basis_map, norms.data(), nshells, 1e-14, 2., 
+        P.data(), nbf, B.data(), nbe, X.data(), nbe, scr.data() );
+      CHECK( max_abs_diff( X.size(), X.data(), X_ref.data() ) < 1e-12 );
+    }
+  }
+
+}
+
+// Timings which back xmat_block_sparse_max_fill, i.e. the fraction of P
+// above which the block sparse X matrix falls back to a dense GEMM, run with
+//   gauxc_test "[xmat-block-sparse-bench]"
+TEST_CASE("Block Sparse X Matrix Timings", "[.][xmat-block-sparse-bench]") {
+
+  auto time_us = []( auto&& f ) {
+    f();
+    size_t nrep = 0;
+    double dur  = 0.;
+    auto st = std::chrono::high_resolution_clock::now();
+    do {
+      f(); ++nrep;
+      dur = std::chrono::duration<double>(
+        std::chrono::high_resolution_clock::now() - st ).count();
+    } while( dur < 0.1 );
+    return 1e6 * dur / nrep;
+  };
+
+  std::default_random_engine gen(1);
+  auto lwd_ptr = LocalWorkDriverFactory::make_local_work_driver(
+    ExecutionSpace::Host, "Reference" );
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>( lwd_ptr.get() );
+
+  const int32_t natoms = 16;
+  auto [ mol, basis ] = shell_chain( natoms );
+  BasisSetMap basis_map( basis, mol );
+  const int32_t nbf     = basis.nbf();
+  const int32_t nshells = basis.nshells();
+  std::vector<int32_t> shell_list( nshells );
+  std::iota( shell_list.begin(), shell_list.end(), 0 );
+  const submat_map_t map = { {0, nbf, 0} };
+
+  std::printf( "%6s %6s | %10s %10s %8s\n", "NPTS", "FILL", "DENSE", "SPARSE",
+    "SPEEDUP" );
+  for( int32_t npts : {64, 256} )
+  for( int32_t band = 0; band < natoms; band += 2 ) {
+    const auto [ P, norms ] = banded_density( basis_map, nbf, band, gen );
+    const auto B = random_matrix<double>( nbf, npts, gen );
+    std::vector<double> X( nbf*npts ), scr( nbf*nbf );
+
+    double fill = 0.;
+    for( auto x : P ) fill += x != 0.;
+    fill /= double(nbf) * nbf;
+
+    const double t_d = time_us( [&]() { lwd->eval_xmat( npts, nbf, nbf, map,
+      1., P.data(), nbf, B.data(), nbf, X.data(), nbf, scr.data() ); } );
+    const double t_s = time_us( [&]() { lwd->eval_xmat_block_sparse( npts, 
+      nbf, nbf, map, nshells, shell_list.data(), basis_map, norms.data(), 
+      nshells, 0., 1., P.data(), nbf, B.data(), nbf, X.data(), nbf, 
+      scr.data() ); } );
+
+    std::printf( "%6d %6.2f | %10.2f %10.2f %8.2f\n", npts, fill, t_d, t_s,
+      t_d / t_s );
+  }
+
+}
+
+TEST_CASE("Host Scratch Arena", "[host-kernels]") {
+
+  auto is_aligned = []( const void* ptr ) {
+    return reinterpret_cast<uintptr_t>(ptr) % HostScratchArena::alignment == 0;
+  };
+
+  HostScratchArena arena;
+  arena.reserve( 1024 );
+  REQUIRE( arena.capacity() == 1024 );
+  REQUIRE( not arena.in_use() );
+
+  SECTION("Mark / Release") {
+    auto* a = arena.allocate<double>( 3 );
+    const auto m1 = arena.mark();
+    auto* b = arena.allocate<double>( 5 );
+    CHECK( is_aligned(a) );
+    CHECK( is_aligned(b) );
+    CHECK( (char*)b - (char*)a == HostScratchArena::alignment );
+
+    {
+      HostScratchScope scope( arena );
+      auto* c = scope.allocate<int32_t>( 7 );
+      CHECK( is_aligned(c) );
+      {
+        HostScratchScope inner( arena );
+        auto* d = inner.allocate<char>( 1 );
+        CHECK( (char*)d - (char*)c == HostScratchArena::alignment );
+      }
+      // Released by the inner scope
+      CHECK( scope.allocate<char>( 1 ) == (char*)c + HostScratchArena::alignment );
+    }
+
+    // Released by the outer scope
+    CHECK( (char*)arena.allocate<float>( 2 ) == (char*)b + HostScratchArena::alignment );
+
+    arena.release( m1 );
+    CHECK( arena.allocate<double>( 1 ) == b );
+    arena.clear();
+    CHECK( not arena.in_use() );
+    CHECK( arena.allocate<double>( 1 ) == a );
+  }
+
+  SECTION("Block Growth and Coalescing") {
+    auto* a = arena.allocate<double>( 64 ); // 512 bytes
+    std::fill_n( a, 64, 1. );
+    auto* b = arena.allocate<double>( 256 ); // Exceeds the first block
+    std::fill_n( b, 256, 2. );
+    CHECK( is_aligned(b) );
+    CHECK( arena.capacity() > 1024 );
+    CHECK( arena.high_water_mark() >= 1024 + 256 * sizeof(double) );
+
+    // Blocks are never moved, earlier slices remain valid
+    auto* c = arena.allocate<double>( 512 );
+    std::fill_n( c, 512, 3. );
+    CHECK( std::all_of( a, a + 64,  []( double x ){ return x == 1.; } ) );
+    CHECK( std::all_of( b, b + 256, []( double x ){ return x == 2.; } ) );
+
+    // Fully released: a single block of the high water mark on the next
+    // allocation, which fits the same sequence without growth
+    const auto hwm = arena.high_water_mark();
+    arena.clear();
+    arena.allocate<double>( 64 );
+    CHECK( arena.capacity() == hwm );
+    arena.allocate<double>( 256 );
+    arena.allocate<double>( 512 );
+    CHECK( arena.capacity() == hwm );
+    CHECK( arena.high_water_mark() == hwm );
+
+    // Reserve does not discard blocks in use
+    arena.reserve( 10 * hwm );
+    CHECK( arena.capacity() == hwm );
+    arena.clear();
+    arena.reserve( 10 * hwm );
+    CHECK( arena.capacity() == 10 * hwm );
+  }
+
+  SECTION("Scratch Buffer") {
+    HostScratchBuffer<double> buf( &arena );
+    buf.resize( 10 );
+    CHECK( buf.size() == 10 );
+    CHECK( buf.capacity() == 10 );
+    auto* p = buf.data();
+    CHECK( is_aligned(p) );
+    std::fill( buf.begin(), buf.end(), 4. );
+
+    // Shrinking / growing within the capacity keeps the slice
+    buf.resize( 4 );
+    buf.resize( 10 );
+    CHECK( buf.data() == p );
+    CHECK( buf[9] == 4. );
+
+    // Growth slices a region of at least twice the capacity, the contents
+    // are not carried over. The top slice of the arena is re-sliced in place
+    buf.resize( 11 );
+    CHECK( buf.size() == 11 );
+    CHECK( buf.capacity() == 20 );
+    CHECK( buf.data() == p );
+    CHECK( arena.high_water_mark() == 
+           HostScratchArena::slice_bytes( 20 * sizeof(double) ) );
+
+    // Below the top of the arena the old region is retained
+    HostScratchBuffer<double> top( &arena );
+    top.resize( 4 );
+    buf.resize( 100 );
+    CHECK( buf.capacity() == 100 );
+    CHECK( buf.data() != p );
+    CHECK( arena.high_water_mark() >= 
+           HostScratchArena::slice_bytes( 20  * sizeof(double) ) +
+           HostScratchArena::slice_bytes( 4   * sizeof(double) ) +
+           HostScratchArena::slice_bytes( 100 * sizeof(double) ) );
+
+    // Released together with the arena, buffers are re-sliced in stack order
+    // from a single block of the high water mark
+    const auto hwm = arena.high_water_mark();
+    arena.clear();
+    buf.reset();
+    top.reset();
+    CHECK( buf.capacity() == 0 );
+    buf.resize( 100 );
+    top.resize( 4 );
+    CHECK( (char*)top.data() == (char*)buf.data() + 
+           HostScratchArena::slice_bytes( 100 * sizeof(double) ) );
+    CHECK( arena.capacity() == hwm );
+  }
+
+}
+#endif
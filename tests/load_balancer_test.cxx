@@ -8,6 +8,13 @@
 #include "ut_common.hpp"
 #include <gauxc/load_balancer.hpp>
 #include <gauxc/molgrid/defaults.hpp>
+#include <gauxc/util/geometry.hpp>
+#include "shell_spatial_index.hpp"
+#include "batch_template.hpp"
+#include "host/petite_replicated_load_balancer.hpp"
+#include <unordered_map>
+#include <random>
+#include <atomic>
 
 using namespace GauXC;
 
@@ -117,6 +124,30 @@ TEST_CASE( "DefaultLoadBalancer", "[load_balancer]" ) {
 
   }
 
+  SECTION("Distributed Host") {
+
+    LoadBalancerFactory lb_factory( ExecutionSpace::Host, "Distributed" );
+    auto lb = lb_factory.get_instance( world, mol, mg, basis);
+    auto& tasks = lb.get_tasks();
+
+    // Same quadrature and assignment as the replicated load balancer
+    LoadBalancerFactory ref_lb_factory( ExecutionSpace::Host, "Default" );
+    auto ref_lb = ref_lb_factory.get_instance( world, mol, mg, basis);
+    auto& ref_tasks = ref_lb.get_tasks();
+
+    size_t npts = 0, ref_npts = 0;
+    for( const auto& t : tasks )     npts     += t.npts;
+    for( const auto& t : ref_tasks ) ref_npts += t.npts;
+#ifdef GAUXC_HAS_MPI
+    MPI_Allreduce( MPI_IN_PLACE, &npts,     1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD );
+    MPI_Allreduce( MPI_IN_PLACE, &ref_npts, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD );
+#endif
+    CHECK( npts == ref_npts );
+
+    check_lb_data( tasks );
+
+  }
+
 #ifdef GAUXC_HAS_DEVICE
   SECTION("Default Device") {
 
@@ -156,3 +187,242 @@ TEST_CASE( "DefaultLoadBalancer", "[load_balancer]" ) {
 
 
 }
+
+TEST_CASE( "ShellSpatialIndex", "[load_balancer]" ) {
+
+  Molecule mol           = make_benzene();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+
+  detail::ShellSpatialIndex index( basis );
+  REQUIRE( index.nshells() == (size_t)basis.nshells() );
+  CHECK( index.indexes( basis ) );
+
+  {
+    // Bases which differ in the shell cutoff radii / centers / count
+    auto basis_tol = basis;
+    for( auto& sh : basis_tol ) sh.set_shell_tolerance( 1e-6 );
+    CHECK( not index.indexes( basis_tol ) );
+
+    auto mol_shift = mol;
+    mol_shift[0].x += 0.1;
+    CHECK( not index.indexes( make_ccpvdz( mol_shift, SphericalType(true) ) ) );
+
+    auto basis_trunc = basis;
+    basis_trunc.pop_back();
+    CHECK( not index.indexes( basis_trunc ) );
+  }
+
+  std::default_random_engine gen;
+  std::uniform_real_distribution<double> pos_dist( -12., 12. );
+  std::uniform_real_distribution<double> len_dist( 0., 3. );
+
+  std::vector<int32_t> shell_list;
+  for( int itest = 0; itest < 1000; ++itest ) {
+
+    std::array<double,3> lo, up;
+    for( int k = 0; k < 3; ++k ) {
+      lo[k] = pos_dist( gen );
+      up[k] = lo[k] + len_dist( gen );
+    }
+
+    std::vector<int32_t> ref_list;
+    for( int32_t iSh = 0; iSh < basis.nshells(); ++iSh )
+    if( geometry::cube_sphere_intersect( lo, up, basis[iSh].O(), 
+        basis[iSh].cutoff_radius() ) )
+      ref_list.emplace_back( iSh );
+
+    index.query( lo, up, shell_list );
+    CHECK( shell_list == ref_list );
+
+  }
+
+}
+
+// Exposes the batch assignment of the distributed host load balancer
+// Replicated host load balancer counting the batch screenings
+struct CountingHostLoadBalancer : public detail::HostReplicatedLoadBalancer {
+
+  using detail::HostReplicatedLoadBalancer::batch_screening;
+  using detail::HostReplicatedLoadBalancer::batch_costs;
+  using detail::HostReplicatedLoadBalancer::batch_owners;
+
+  detail::PetiteHostReplicatedLoadBalancer petite;
+  mutable std::atomic<size_t> nscreen{0};
+
+  CountingHostLoadBalancer( const RuntimeEnvironment& rt, const Molecule& mol,
+    const MolGrid& mg, const BasisSet<double>& basis ) :
+    detail::HostReplicatedLoadBalancer( rt, mol, mg, basis ),
+    petite( rt, mol, mg, basis ) { }
+
+  std::unique_ptr<detail::LoadBalancerImpl> clone() const override {
+    GAUXC_GENERIC_EXCEPTION("CountingHostLoadBalancer Is Not Clonable");
+  }
+
+  std::pair< std::vector<int32_t>, size_t > micro_batch_screen(
+    const BasisSet<double>& bs, const std::array<double,3>& lo,
+    const std::array<double,3>& up ) const override {
+    nscreen++;
+    return petite.micro_batch_screen( bs, lo, up );
+  }
+
+};
+
+TEST_CASE( "Distributed Batch Assignment", "[load_balancer]" ) {
+
+  auto world = RuntimeEnvironment(GAUXC_MPI_CODE(MPI_COMM_WORLD));
+
+  Molecule mol           = make_benzene();
+  BasisSet<double> basis = make_ccpvdz( mol, SphericalType(true) );
+  for( auto& sh : basis ) sh.set_shell_tolerance( 1e-10 );
+
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Unpruned,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+  const size_t natoms = mol.natoms();
+
+  std::unordered_map< AtomicNumber, detail::BatchTemplate > batch_templates;
+  for( const auto& atom : mol ) 
+  if( not batch_templates.count( atom.Z ) )
+    batch_templates.emplace( atom.Z, detail::BatchTemplate( mg.get_grid(atom.Z) ) );
+
+  // Cost of the generated task of each batch (0 if there is none)
+  std::vector< std::pair<int32_t, size_t> > batches;
+  std::vector< size_t > task_cost;
+  std::vector< bool >   has_points;
+  CountingHostLoadBalancer lb( world, mol, mg, basis );
+  for( size_t iA = 0; iA < natoms; ++iA ) {
+    const auto& atom = mol[iA];
+    const auto& bt   = batch_templates.at( atom.Z );
+    for( size_t ib = 0; ib < bt.nbatches(); ++ib ) {
+      auto batch = bt.at( ib, { atom.x, atom.y, atom.z } );
+      auto [shell_list, nbe] = lb.micro_batch_screen( basis, batch.lo, batch.up );
+      XCTask task;
+      task.npts = batch.points.size();
+      task.bfn_screening.nbe = nbe;
+      batches.emplace_back( iA, ib );
+      has_points.emplace_back( task.npts > 0 );
+      task_cost.emplace_back( 
+        (task.npts and shell_list.size()) ? task.cost( 1, natoms ) : 0 );
+    }
+  }
+  const size_t nbatches = batches.size();
+  const size_t nbatches_points = 
+    std::count( has_points.begin(), has_points.end(), true );
+
+  for( int nranks : { 1, 2, 3, 7 } ) {
+
+    // Each (simulated) rank costs its share of the batches, the costs of all
+    // batches follow from the sum over ranks
+    std::vector<size_t> cost( nbatches, 0 );
+    for( int irank = 0; irank < nranks; ++irank ) {
+      CountingHostLoadBalancer rank_lb( world, mol, mg, basis );
+      std::vector< CountingHostLoadBalancer::batch_screening > screening;
+      auto rank_cost = rank_lb.batch_costs( batches, batch_templates, irank,
+        nranks, screening );
+      REQUIRE( rank_cost.size() == nbatches );
+      REQUIRE( screening.size() == nbatches );
+
+      // Only the batches (with points) costed on this rank are screened
+      size_t nscreen_ref = 0;
+      for( size_t i = 0; i < nbatches; ++i ) {
+        if( i % nranks == size_t(irank) ) {
+          nscreen_ref += has_points[i];
+          CHECK( rank_cost[i] == task_cost[i] );
+          CHECK( (screening[i].first.size() > 0) == (task_cost[i] > 0) );
+        } else {
+          CHECK( rank_cost[i] == 0 );
+          CHECK( screening[i].first.empty() );
+        }
+        cost[i] += rank_cost[i];
+      }
+      CHECK( rank_lb.nscreen.load() == nscreen_ref );
+      CHECK( rank_lb.nscreen.load() <= (nbatches + nranks - 1) / nranks );
+    }
+    CHECK( cost == task_cost );
+
+    // Every batch yielding a task is owned by exactly one rank, with the
+    // greedy assignment of the generated tasks
+    std::vector<size_t> workload( nranks, 0 ), workload_ref( nranks, 0 );
+    auto owners = CountingHostLoadBalancer::batch_owners( cost, workload );
+    REQUIRE( owners.size() == nbatches );
+    for( size_t i = 0; i < nbatches; ++i ) {
+      if( not task_cost[i] ) { CHECK( owners[i] == -1 ); continue; }
+
+      auto min_rank_it = 
+        std::min_element( workload_ref.begin(), workload_ref.end() );
+      *min_rank_it += task_cost[i];
+      CHECK( owners[i] == std::distance( workload_ref.begin(), min_rank_it ) );
+    }
+    CHECK( workload == workload_ref );
+
+  }
+
+  // Task generation: distributed generation yields the tasks of the
+  // replicated generation without screening the owned batches again
+  CountingHostLoadBalancer lb_rep( world, mol, mg, basis );
+  CountingHostLoadBalancer lb_dist( world, mol, mg, basis );
+  lb_dist.set_distributed_generation( true );
+
+  const auto& tasks_rep  = lb_rep.get_tasks();
+  const auto& tasks_dist = lb_dist.get_tasks();
+  CHECK( lb_rep.nscreen.load() == nbatches_points );
+  if( world.comm_size() == 1 ) CHECK( lb_dist.nscreen.load() == nbatches_points );
+  else                         CHECK( lb_dist.nscreen.load() <  nbatches_points );
+
+  REQUIRE( tasks_dist.size() == tasks_rep.size() );
+  for( size_t i = 0; i < tasks_rep.size(); ++i ) {
+    CHECK( tasks_dist[i].iParent == tasks_rep[i].iParent );
+    CHECK( tasks_dist[i].npts    == tasks_rep[i].npts    );
+    CHECK( tasks_dist[i].bfn_screening.shell_list == 
+           tasks_rep[i].bfn_screening.shell_list );
+    CHECK( tasks_dist[i].bfn_screening.nbe == tasks_rep[i].bfn_screening.nbe );
+  }
+
+}
+
+TEST_CASE( "BatchTemplate", "[load_balancer]" ) {
+
+  Molecule mol = make_benzene();
+  auto mg = MolGridFactory::create_default_molgrid(mol, PruningScheme::Robust,
+    BatchSize(512), RadialQuad::MuraKnowles, AtomicGridSizeDefault::FineGrid);
+
+  std::unordered_map< AtomicNumber, detail::BatchTemplate > batch_templates;
+  for( const auto& atom : mol ) 
+  if( not batch_templates.count( atom.Z ) )
+    batch_templates.emplace( atom.Z, detail::BatchTemplate( mg.get_grid(atom.Z) ) );
+
+  // Translated batches vs batches of the recentered batcher
+  const double tol = 1e-12;
+  for( const auto& atom : mol ) {
+
+    const std::array<double,3> center = { atom.x, atom.y, atom.z };
+    const auto& bt = batch_templates.at( atom.Z );
+
+    auto& batcher = mg.get_grid(atom.Z).batcher();
+    batcher.quadrature().recenter( center );
+    REQUIRE( bt.nbatches() == batcher.nbatches() );
+
+    for( size_t ib = 0; ib < bt.nbatches(); ++ib ) {
+
+      auto [lo_ref, up_ref, points_ref, weights_ref] = batcher.at(ib);
+      auto batch = bt.at( ib, center );
+
+      CHECK( bt.npts(ib) == points_ref.size() );
+      CHECK( batch.weights == weights_ref );
+      REQUIRE( batch.points.size() == points_ref.size() );
+      for( size_t k = 0; k < 3; ++k ) {
+        CHECK( batch.lo[k] == Approx( lo_ref[k] ).margin(tol) );
+        CHECK( batch.up[k] == Approx( up_ref[k] ).margin(tol) );
+      }
+      for( size_t ip = 0; ip < points_ref.size(); ++ip )
+      for( size_t k  = 0; k  < 3; ++k  )
+        CHECK( batch.points[ip][k] == Approx( points_ref[ip][k] ).margin(tol) );
+
+      auto [lo, up] = bt.extent( ib, center );
+      CHECK( lo == batch.lo );
+      CHECK( up == batch.up );
+
+    }
+
+  }
+
+}
@@ -57,6 +57,7 @@ int main(int argc, char** argv) {
     std::string integrator_kernel  = "Default";
     std::string lwd_kernel         = "Default";
     std::string reduction_kernel   = "Default";
+    std::string host_accumulation  = "Atomic";
 
     size_t      batch_size = 512;
     double      basis_tol  = 1e-10;
@@ -66,6 +67,9 @@ int main(int argc, char** argv) {
     bool integrate_vxc      = true;
     bool integrate_exx      = false;
     bool integrate_exc_grad = false;
+    bool compact_grid       = false;
+    bool vectorized_weights = true;
+    bool bench_accumulation = false;
 
     auto string_to_upper = []( auto& str ) {
       std::transform( str.begin(), str.end(), str.begin(), ::toupper );
@@ -84,6 +88,7 @@ int main(int argc, char** argv) {
     OPTIONAL_KEYWORD( "GAUXC.INTEGRATOR_KERNEL", integrator_kernel,  std::string );
     OPTIONAL_KEYWORD( "GAUXC.LWD_KERNEL",        lwd_kernel,         std::string );
     OPTIONAL_KEYWORD( "GAUXC.REDUCTION_KERNEL",  reduction_kernel,   std::string );
+    OPTIONAL_KEYWORD( "GAUXC.HOST_ACCUMULATION", host_accumulation,  std::string );
     string_to_upper( grid_spec          );
     string_to_upper( func_spec          );
     string_to_upper( prune_spec         );
@@ -92,6 +97,7 @@ int main(int argc, char** argv) {
     string_to_upper( integrator_kernel  );
     string_to_upper( lwd_kernel         );
     string_to_upper( reduction_kernel   );
+    string_to_upper( host_accumulation  );
 
     OPTIONAL_KEYWORD( "GAUXC.BATCH_SIZE",     batch_size, size_t );
     OPTIONAL_KEYWORD( "GAUXC.BASIS_TOL",      basis_tol,  double );
@@ -100,11 +106,25 @@ int main(int argc, char** argv) {
     OPTIONAL_KEYWORD( "GAUXC.INTEGRATE_VXC",      integrate_vxc,      bool );
     OPTIONAL_KEYWORD( "GAUXC.INTEGRATE_EXX",      integrate_exx,      bool );
     OPTIONAL_KEYWORD( "GAUXC.INTEGRATE_EXC_GRAD", integrate_exc_grad, bool );
+    OPTIONAL_KEYWORD( "GAUXC.COMPACT_GRID",       compact_grid,       bool );
+    OPTIONAL_KEYWORD( "GAUXC.VECTORIZED_WEIGHTS", vectorized_weights, bool );
+    OPTIONAL_KEYWORD( "GAUXC.BENCH_ACCUMULATION", bench_accumulation, bool );
 
     IntegratorSettingsSNLinK sn_link_settings;
     OPTIONAL_KEYWORD( "EXX.TOL_E", sn_link_settings.energy_tol, double );
     OPTIONAL_KEYWORD( "EXX.TOL_K", sn_link_settings.k_tol,      double );
 
+    // Accumulation of VXC / K on the host (benchmark against ATOMIC)
+    std::map< std::string, HostAccumulation > host_accumulation_map = {
+      { "DEFAULT",        HostAccumulation::Default       },
+      { "ATOMIC",         HostAccumulation::Atomic        },
+      { "THREAD_PRIVATE", HostAccumulation::ThreadPrivate },
+      { "TILE_LOCKS",     HostAccumulation::TileLocks     }
+    };
+    IntegratorSettingsKS ks_settings;
+    ks_settings.accumulation = host_accumulation_map.at(host_accumulation);
+    sn_link_settings.accumulation = ks_settings.accumulation;
+
 
     #ifdef GAUXC_HAS_DEVICE
     std::map< std::string, ExecutionSpace > exec_space_map = {
@@ -133,10 +153,14 @@ int main(int argc, char** argv) {
                 << "  INTEGRATOR_KERNEL = " << integrator_kernel << std::endl
                 << "  LWD_KERNEL        = " << lwd_kernel << std::endl
                 << "  REDUCTION_KERNEL  = " << reduction_kernel << std::endl
+                << "  HOST_ACCUMULATION = " << host_accumulation << std::endl
                 << "  DEN (?)           = " << integrate_den << std::endl
                 << "  VXC (?)           = " << integrate_vxc << std::endl
                 << "  EXX (?)           = " << integrate_exx << std::endl
-                << "  EXC_GRAD (?)      = " << integrate_exc_grad << std::endl;
+                << "  EXC_GRAD (?)      = " << integrate_exc_grad << std::endl
+                << "  COMPACT_GRID      = " << compact_grid << std::endl
+                << "  VEC_WEIGHTS       = " << vectorized_weights << std::endl
+                << "  BENCH_ACCUM (?)   = " << bench_accumulation << std::endl;
                 if(integrate_exx) {
                   std::cout << "  EXX.TOL_E         = " 
                             << sn_link_settings.energy_tol << std::endl
@@ -187,8 +211,11 @@ int main(int argc, char** argv) {
     auto lb = lb_factory.get_shared_instance( rt, mol, mg, basis);
 
     // Apply molecular partition weights
+    MolecularWeightsSettings mw_settings;
+    mw_settings.compact_grid = compact_grid;
+    mw_settings.vectorized_weights = vectorized_weights;
     MolecularWeightsFactory mw_factory( int_exec_space, "Default", 
-      MolecularWeightsSettings{} );
+      mw_settings );
     auto mw = mw_factory.get_instance();
     mw.modify_weights(*lb);
 
@@ -369,13 +396,13 @@ int main(int argc, char** argv) {
 
     if( integrate_vxc ) {
       if( rks ) {
-        std::tie(EXC, VXC) = integrator.eval_exc_vxc( P );
+        std::tie(EXC, VXC) = integrator.eval_exc_vxc( P, ks_settings );
       }
       else if ( uks ) {
-        std::tie(EXC, VXC, VXCz) = integrator.eval_exc_vxc( P, Pz );
+        std::tie(EXC, VXC, VXCz) = integrator.eval_exc_vxc( P, Pz, ks_settings );
       }
       else if ( gks ) {
-        std::tie(EXC, VXC, VXCz, VXCy, VXCx) = integrator.eval_exc_vxc( P, Pz, Py, Px );
+        std::tie(EXC, VXC, VXCz, VXCy, VXCx) = integrator.eval_exc_vxc( P, Pz, Py, Px, ks_settings );
       }
       std::cout << std::scientific << std::setprecision(12);
       if(!world_rank) std::cout << "EXC = " << EXC << std::endl;
@@ -430,6 +457,35 @@ int main(int argc, char** argv) {
     auto xc_int_end   = std::chrono::high_resolution_clock::now();
     double xc_int_dur = std::chrono::duration<double>( xc_int_end - xc_int_start ).count();
 
+    // Benchmark the host accumulation strategies of VXC against ATOMIC on
+    // the same input (excluded from the integration time above)
+    std::vector< std::pair<std::string,double> > accumulation_timings;
+    if( bench_accumulation and integrate_vxc and 
+        int_exec_space == ExecutionSpace::Host ) {
+      for( auto name : {"ATOMIC", "THREAD_PRIVATE", "TILE_LOCKS"} ) {
+        auto bench_settings = ks_settings;
+        bench_settings.accumulation = host_accumulation_map.at(name);
+
+        #ifdef GAUXC_HAS_MPI
+        MPI_Barrier( MPI_COMM_WORLD );
+        #endif
+        auto bench_st = std::chrono::high_resolution_clock::now();
+        if( rks ) 
+          integrator.eval_exc_vxc( P, bench_settings );
+        else if( uks ) 
+          integrator.eval_exc_vxc( P, Pz, bench_settings );
+        else if( gks ) 
+          integrator.eval_exc_vxc( P, Pz, Py, Px, bench_settings );
+        #ifdef GAUXC_HAS_MPI
+        MPI_Barrier( MPI_COMM_WORLD );
+        #endif
+        auto bench_en = std::chrono::high_resolution_clock::now();
+
+        accumulation_timings.emplace_back( name, 
+          std::chrono::duration<double,std::milli>( bench_en - bench_st ).count() );
+      }
+    }
+
 #ifdef GAUXC_HAS_MPI
     util::MPITimer mpi_lb_timings( MPI_COMM_WORLD, lb->get_timings() );
     util::MPITimer mpi_xc_timings( MPI_COMM_WORLD, integrator.get_timings() );
@@ -496,6 +552,17 @@ int main(int argc, char** argv) {
         #endif
       }
 
+      if( accumulation_timings.size() ) {
+        std::cout << "Host Accumulation Timings (EXC_VXC)" << std::endl;
+        const auto atomic_dur = accumulation_timings.front().second;
+        for( const auto& [name, dur] : accumulation_timings ) {
+          std::cout << "  " << std::setw(40) << name << ": " 
+                    << std::setw(12) << dur << " ms, "
+                    << "SPEEDUP = " << std::setw(12) << atomic_dur / dur
+                    << std::endl;
+        }
+      }
+
       std::cout << std::scientific << std::setprecision(14);
 
       std::cout << "XC Int Duration  = " << xc_int_dur << " s" << std::endl;
@@ -59,6 +59,16 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
                           std::ios::binary );
   test_host_weights( ref_data, XCWeightAlg::LKO );
   }
+  SECTION("Becke SoA") {
+  std::ifstream ref_data( GAUXC_REF_DATA_PATH "/benzene_weights_becke.bin", 
+                          std::ios::binary );
+  test_host_weights( ref_data, XCWeightAlg::Becke, true );
+  }
+  SECTION("LKO SoA") {
+  std::ifstream ref_data( GAUXC_REF_DATA_PATH "/benzene_weights_lko.bin", 
+                          std::ios::binary );
+  test_host_weights( ref_data, XCWeightAlg::LKO, true );
+  }
 #endif
 
 
@@ -71,6 +81,9 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
   SECTION( "Host Weights" ) {
     test_host_weights( ref_data, XCWeightAlg::SSF );
   }
+  SECTION( "Host SoA Weights" ) {
+    test_host_weights( ref_data, XCWeightAlg::SSF, true );
+  }
 #endif
 
 #ifdef GAUXC_HAS_DEVICE
@@ -87,4 +100,106 @@ TEST_CASE( "Partition Weights", "[weights]" ) {
   }
 }
 
+#ifdef GAUXC_HAS_HOST
+#include "host/reference/weights.hpp"
+#include "common/integrator_constants.hpp"
+#include <random>
+
+namespace {
+
+// Pairwise SSF partition weight of a point over all atoms (unscreened
+// w.r.t. the atoms, i.e. the original host kernel)
+double ssf_weight_pairwise( const Molecule& mol, const MolMeta& meta,
+  size_t parent, const std::array<double,3>& point ) {
+
+  const size_t natoms = mol.natoms();
+  const auto&  RAB    = meta.rab();
+  const double a      = integrator::magic_ssf_factor<>;
+
+  std::vector<double> dist( natoms ), P( natoms, 1. );
+  for( size_t iA = 0; iA < natoms; ++iA ) {
+    const double dx = point[0] - mol[iA].x;
+    const double dy = point[1] - mol[iA].y;
+    const double dz = point[2] - mol[iA].z;
+    dist[iA] = std::sqrt( dx*dx + dy*dy + dz*dz );
+  }
+
+  if( dist[parent] < 0.5 * (1. - a) * meta.dist_nearest()[parent] ) return 1.;
+
+  auto g = [&]( double mu ) {
+    const double s = mu / a, s2 = s*s, s3 = s*s2, s5 = s3*s2, s7 = s5*s2;
+    return (35.*(s - s3) + 21.*s5 - 5.*s7) / 16.;
+  };
+
+  for( size_t iA = 0; iA < natoms; ++iA )
+  for( size_t jA = 0; jA < iA;     ++jA )
+  if( P[iA] > integrator::ssf_weight_tol or P[jA] > integrator::ssf_weight_tol ) {
+    const double mu = (dist[iA] - dist[jA]) / RAB[jA + iA*natoms];
+    if( mu <= -a )     P[jA] = 0.;
+    else if( mu >= a ) P[iA] = 0.;
+    else {
+      const double s = 0.5 * (1. - g(mu));
+      P[iA] *= s;
+      P[jA] *= 1. - s;
+    }
+  }
+
+  double sum = 0.;
+  for( auto p : P ) sum += p;
+  return P[parent] / sum;
+
+}
+
+}
 
+TEST_CASE( "SSF Weights Atom Culling", "[weights]" ) {
+
+  // Jittered 5x5x5 lattice (125 atoms)
+  std::default_random_engine gen(42);
+  std::uniform_real_distribution<double> jitter(-0.4, 0.4);
+  Molecule mol;
+  for( int i = 0; i < 5; ++i )
+  for( int j = 0; j < 5; ++j )
+  for( int k = 0; k < 5; ++k )
+    mol.emplace_back( AtomicNumber( (i+j+k) % 2 ? 1 : 6 ), 2.6*i + jitter(gen),
+      2.6*j + jitter(gen), 2.6*k + jitter(gen) );
+  MolMeta meta( mol );
+
+  // Single point tasks (degenerate bounding boxes) and small clusters of
+  // points around random atoms, from the atom out to the lattice surface
+  std::uniform_int_distribution<size_t> atom_dist( 0, mol.natoms()-1 );
+  std::uniform_real_distribution<double> r_dist( 0., 6. ), u_dist( -1., 1. );
+  std::vector<XCTask> tasks;
+  for( size_t iT = 0; iT < 2000; ++iT ) {
+    XCTask task;
+    task.iParent      = atom_dist(gen);
+    task.dist_nearest = meta.dist_nearest()[task.iParent];
+    const auto& A = mol[task.iParent];
+    const size_t npts = iT % 4 ? 1 : 8;
+    std::array<double,3> dir = { u_dist(gen), u_dist(gen), u_dist(gen) };
+    const double r = r_dist(gen) / std::sqrt( dir[0]*dir[0] + dir[1]*dir[1] +
+      dir[2]*dir[2] );
+    for( size_t ip = 0; ip < npts; ++ip ) {
+      task.points.push_back( { A.x + r * dir[0] + 0.1 * u_dist(gen),
+        A.y + r * dir[1] + 0.1 * u_dist(gen), A.z + r * dir[2] + 0.1 * u_dist(gen) } );
+      task.weights.push_back( 1. );
+    }
+    task.npts = npts;
+    tasks.emplace_back( std::move(task) );
+  }
+
+  for( bool soa : { false, true } ) {
+    auto tasks_w = tasks;
+    (soa ? soa_ssf_weights_host : reference_ssf_weights_host)( mol, meta,
+      tasks_w.begin(), tasks_w.end() );
+    for( size_t iT = 0; iT < tasks.size(); ++iT )
+    for( size_t ip = 0; ip < tasks[iT].points.size(); ++ip ) {
+      const double ref = ssf_weight_pairwise( mol, meta, tasks[iT].iParent,
+        tasks[iT].points[ip] );
+      INFO( "SoA = " << soa << " Task = " << iT << " Point = " << ip );
+      CHECK( tasks_w[iT].weights[ip] == Approx(ref).margin(1e-12) );
+    }
+  }
+
+}
+#endif
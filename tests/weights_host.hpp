@@ -11,10 +11,12 @@
 #include <string>
 
 #ifdef GAUXC_HAS_HOST
-#include "host/reference/weights.hpp"
+#include "local_work_driver.hpp"
+#include "host/local_host_work_driver.hpp"
 using namespace GauXC;
 
-void test_host_weights( std::ifstream& in_file, XCWeightAlg weight_alg ) {
+void test_host_weights( std::ifstream& in_file, XCWeightAlg weight_alg,
+  bool soa = false ) {
 
   ref_weights_data ref_data;
   {
@@ -22,23 +24,14 @@ void test_host_weights( std::ifstream& in_file, XCWeightAlg weight_alg ) {
     ar( ref_data );
   }
 
-  switch(weight_alg) {
-    case XCWeightAlg::Becke:
-      reference_becke_weights_host( 
-        ref_data.mol, *ref_data.meta, ref_data.tasks_unm.begin(), 
-        ref_data.tasks_unm.end() );
-      break;
-    case XCWeightAlg::SSF:
-      reference_ssf_weights_host( 
-        ref_data.mol, *ref_data.meta, ref_data.tasks_unm.begin(), 
-        ref_data.tasks_unm.end() );
-      break;
-    case XCWeightAlg::LKO:
-      reference_lko_weights_host( 
-        ref_data.mol, *ref_data.meta, ref_data.tasks_unm.begin(), 
-        ref_data.tasks_unm.end() );
-      break;
-  }
+  // Dispatch through the host work driver (runtime kernel selection)
+  auto lwd_ptr = LocalWorkDriverFactory::make_local_work_driver(
+    ExecutionSpace::Host, "Reference" );
+  auto* lwd = dynamic_cast<LocalHostWorkDriver*>( lwd_ptr.get() );
+  REQUIRE( lwd );
+
+  lwd->partition_weights( weight_alg, ref_data.mol, *ref_data.meta,
+    ref_data.tasks_unm.begin(), ref_data.tasks_unm.end(), soa );
 
 
   size_t ntasks = ref_data.tasks_unm.size();
@@ -10,15 +10,105 @@
 #include <gauxc/xc_integrator/impl.hpp>
 #include <gauxc/xc_integrator/integrator_factory.hpp>
 #include <gauxc/molecular_weights.hpp>
+#include <gauxc/basisset_map.hpp>
 
 #include <gauxc/molgrid/defaults.hpp>
 
 #include <gauxc/external/hdf5.hpp>
 #include <highfive/H5File.hpp>
 #include <Eigen/Core>
+#include <functional>
 
 using namespace GauXC;
 
+/// Host EXC/VXC settings which reproduce the reference (VXC to tol). check
+/// verifies the work counters of call icall, i.e. that the feature engages.
+struct HostKSTestCase {
+  std::string          name;
+  IntegratorSettingsKS settings;
+  double               tol    = 1e-10;
+  int                  ncalls = 1;
+  bool                 uks    = false; ///< Also checked for UKS
+  std::function<void(const XCIntegratorStats&, int)> check = 
+    []( const XCIntegratorStats&, int ) {};
+};
+
+std::vector<HostKSTestCase> host_ks_test_cases() {
+
+  std::vector<HostKSTestCase> cases;
+  auto add = [&]( std::string name, auto&& setup ) -> HostKSTestCase& {
+    auto& c = cases.emplace_back();
+    c.name = name;
+    setup( c.settings );
+    return c;
+  };
+
+  // Collocation caching, the first call populates the cache and the
+  // second reuses it (FP32 storage of all / a part of the tasks)
+  for( auto [ cache_bytes, fp32 ] : { std::pair( size_t(1ul << 30), false ),
+                                      std::pair( size_t(1ul << 30), true  ),
+                                      std::pair( size_t(1ul << 20), true  ) } ) {
+    auto& c = add( "Collocation Cache", [=]( auto& s ) {
+      s.cache_collocation       = true;
+      s.collocation_cache_bytes = cache_bytes;
+      s.collocation_cache_fp32  = fp32;
+    });
+    c.ncalls = 2;
+    c.tol    = fp32 ? 1e-5 : 1e-10;
+    c.check  = [full = cache_bytes == (1ul << 30)]( const auto& st, int icall ) {
+      if( icall == 0 ) {
+        CHECK( st.ntasks_colloc_reused == 0 );
+        if( full ) CHECK( st.ntasks_colloc_stored > 0 );
+      } else {
+        CHECK( st.ntasks_colloc_stored == 0 );
+        if( full ) CHECK( st.ntasks_colloc_reused > 0 );
+      }
+    };
+  }
+
+  // Mixed precision (FP32 GEMMs)
+  add( "Mixed Precision", []( auto& s ) { s.mixed_precision = true; } )
+    .tol = 1e-5;
+
+  // VXC accumulation strategies
+  for( auto acc : { HostAccumulation::Atomic, HostAccumulation::ThreadPrivate,
+                    HostAccumulation::TileLocks } )
+    add( "Accumulation", [=]( auto& s ) { s.accumulation = acc; } )
+      .uks = true;
+
+  // Density screening, points are dropped at a raised tolerance
+  add( "Density Screening", []( auto& s ) { s.screen_density = true; } )
+    .uks = true;
+  {
+    auto& c = add( "Density Screening (Raised Tolerance)", []( auto& s ) {
+      s.screen_density = true;
+      s.density_tol    = 1e-12;
+    });
+    c.tol   = 1e-8;
+    c.uks   = true;
+    c.check = []( const auto& st, int ) { CHECK( st.npts_screened > 0 ); };
+  }
+
+  // Untiled passes, point tiled pipeline with small tiles and cross-task
+  // functional batching (all tasks grouped)
+  for( auto [ tile_bytes, batch_npts ] : { std::pair( size_t(0), size_t(0) ),
+                                           std::pair( size_t(1), size_t(0) ),
+                                           std::pair( size_t(1), size_t(1ul << 20) ),
+                                           std::pair( size_t(1ul << 18), size_t(1ul << 20) ) } ) {
+    auto& c = add( "Point Tiles / Functional Batching", [=]( auto& s ) {
+      s.xc_tile_bytes      = tile_bytes;
+      s.xc_func_batch_npts = batch_npts;
+    });
+    c.uks   = true;
+    c.check = [=]( const auto& st, int ) {
+      if( batch_npts ) CHECK( st.ntasks_grouped > 0 );
+      else             CHECK( st.ntasks_grouped == 0 );
+    };
+  }
+
+  return cases;
+}
+
 
 void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
   std::string reference_file, 
@@ -182,6 +272,168 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto EXC2 = integrator.eval_exc( P );
     CHECK(EXC2 == Approx(EXC));
 
+    // Check the host EXC/VXC features against the reference (see
+    // host_ks_test_cases), each case is evaluated ncalls times
+    if( ex == ExecutionSpace::Host ) {
+      const auto N_EL_ref = integrator.integrate_den( P );
+      for( const auto& c : host_ks_test_cases() ) 
+      for( int icall = 0; icall < c.ncalls; ++icall ) {
+        INFO( c.name << " (call " << icall << ")" );
+        auto [ EXC1, VXC1 ] = integrator.eval_exc_vxc( P, c.settings );
+        CHECK( EXC1 == Approx( EXC_ref ) );
+        auto VXC1_diff_nrm = ( VXC1 - VXC_ref ).norm();
+        CHECK( VXC1_diff_nrm / basis.nbf() < c.tol ); 
+        CHECK( integrator.last_n_el() == Approx( N_EL_ref ).epsilon(1e-5) );
+        c.check( integrator.last_stats(), icall );
+      }
+
+      // Functional batching in the EXC-only path
+      IntegratorSettingsKS ks_settings;
+      ks_settings.xc_tile_bytes      = 1ul << 18;
+      ks_settings.xc_func_batch_npts = 1ul << 20;
+      CHECK( integrator.eval_exc( P, ks_settings ) == Approx( EXC_ref ) );
+    }
+
+    // Check grid compaction (negligible-weight points dropped)
+    if( ex == ExecutionSpace::Host ) {
+      auto lb_c = lb_factory.get_instance(rt, mol, mg, basis);
+      MolecularWeightsSettings mw_settings;
+      mw_settings.compact_grid = true;
+      MolecularWeightsFactory( ex, "Default", mw_settings ).get_instance()
+        .modify_weights(lb_c);
+
+      auto count_npts = []( const auto& tasks ) {
+        return std::accumulate( tasks.begin(), tasks.end(), 0ul,
+          []( const auto& a, const auto& t ) { return a + t.points.size(); });
+      };
+      CHECK( count_npts(lb_c.get_tasks()) <= count_npts(lb.get_tasks()) );
+      double min_weight = std::numeric_limits<double>::infinity();
+      for( const auto& task : lb_c.get_tasks() ) {
+        CHECK( task.points.size() > 0 );
+        CHECK( task.npts == int32_t(task.points.size()) );
+        for( auto w : task.weights ) min_weight = std::min( min_weight, std::abs(w) );
+      }
+      CHECK( min_weight >= mw_settings.compact_weight_tol );
+
+      auto integrator_c = integrator_factory.get_instance( func, lb_c );
+      auto [ EXC1, VXC1 ] = integrator_c.eval_exc_vxc( P );
+      CHECK( EXC1 == Approx( EXC_ref ) );
+      auto VXC1_diff_nrm = ( VXC1 - VXC_ref ).norm();
+      CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 ); 
+    }
+
+    // Check block sparse X matrices on an atom block diagonal density
+    if( ex == ExecutionSpace::Host ) {
+      BasisSetMap basis_map( basis, mol );
+      matrix_type P_blk = P;
+      for( int32_t jsh = 0; jsh < int32_t(basis.nshells()); ++jsh )
+      for( int32_t ish = 0; ish < int32_t(basis.nshells()); ++ish ) 
+      if( basis_map.shell_to_center(ish) != basis_map.shell_to_center(jsh) ) {
+        auto [i_st, i_en] = basis_map.shell_to_ao_range(ish);
+        auto [j_st, j_en] = basis_map.shell_to_ao_range(jsh);
+        P_blk.block( i_st, j_st, i_en - i_st, j_en - j_st ).setZero();
+      }
+
+      auto [ EXC_blk, VXC_blk ] = integrator.eval_exc_vxc( P_blk );
+      IntegratorSettingsKS ks_settings;
+      ks_settings.xmat_block_tol = 1e-14;
+      auto [ EXC1, VXC1 ] = integrator.eval_exc_vxc( P_blk, ks_settings );
+      CHECK( EXC1 == Approx( EXC_blk ) );
+      auto VXC1_diff_nrm = ( VXC1 - VXC_blk ).norm();
+      CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 ); 
+    }
+
+    // Check batched EXC/VXC against individual evaluations
+    {
+      matrix_type P_half = 0.5 * P;
+      auto [ EXC_half, VXC_half ] = integrator.eval_exc_vxc( P_half );
+      auto EXC_VXC = integrator.eval_exc_vxc_batch( { P, P_half } );
+      REQUIRE( EXC_VXC.size() == 2 );
+
+      auto& [ EXC0, VXC0 ] = EXC_VXC[0];
+      CHECK( EXC0 == Approx( EXC_ref ) );
+      CHECK( ( VXC0 - VXC_ref ).norm() / basis.nbf() < 1e-10 );
+
+      auto& [ EXC1, VXC1 ] = EXC_VXC[1];
+      CHECK( EXC1 == Approx( EXC_half ) );
+      CHECK( ( VXC1 - VXC_half ).norm() / basis.nbf() < 1e-10 );
+    }
+
+    // Check the FXC contraction against a fourth order finite difference of
+    // VXC (independent of the per-point differences of the contraction) for
+    // several steps of the contraction and two trial densities
+    if( ex == ExecutionSpace::Host ) {
+      auto fxc_ref = [&]( const matrix_type& tP ) {
+        const double h = 1e-3 / tP.cwiseAbs().maxCoeff();
+        matrix_type FXC_fd = matrix_type::Zero( P.rows(), P.cols() );
+        for( auto [c, s] : { std::pair( 8., 1. ), std::pair( -8., -1. ),
+                             std::pair(-1., 2. ), std::pair(  1., -2. ) } ) {
+          matrix_type P_s = P + s * h * tP;
+          auto [ EXC_s, VXC_s ] = integrator.eval_exc_vxc( P_s );
+          FXC_fd += c / (12 * h) * VXC_s;
+        }
+        return FXC_fd;
+      };
+
+      matrix_type tP0 = P * P, tP1 = P - P * P;
+      matrix_type FXC0_ref = fxc_ref( tP0 ), FXC1_ref = fxc_ref( tP1 );
+      for( double fd_step : { 1e-3, 1e-4, 1e-5 } ) {
+        IntegratorSettingsKS ks_settings;
+        ks_settings.fxc_fd_step = fd_step;
+        auto FXC = integrator.eval_fxc_contraction( P, { tP0, tP1 }, 
+          ks_settings );
+        REQUIRE( FXC.size() == 2 );
+        CHECK( ( FXC[0] - FXC0_ref ).norm() / FXC0_ref.norm() < 1e-5 );
+        CHECK( ( FXC[1] - FXC1_ref ).norm() / FXC1_ref.norm() < 1e-5 );
+      }
+    }
+
+    // Check incremental builds (P -> P' -> P) against full builds
+    if( ex == ExecutionSpace::Host ) {
+      matrix_type P_p = 1.01 * P;
+      auto [ EXC_p, VXC_p ] = integrator.eval_exc_vxc( P_p );
+
+      IntegratorSettingsKS ks_settings;
+      ks_settings.incremental_vxc = true;
+      ks_settings.incremental_tol = 0.;
+      for( const auto& [ Pi, EXCi, VXCi ] : { std::tie( P,   EXC_ref, VXC_ref ),
+                                              std::tie( P_p, EXC_p,   VXC_p   ),
+                                              std::tie( P,   EXC_ref, VXC_ref ) } ) {
+        auto [ EXC1, VXC1 ] = integrator.eval_exc_vxc( Pi, ks_settings );
+        CHECK( EXC1 == Approx( EXCi ) );
+        auto VXC1_diff_nrm = ( VXC1 - VXCi ).norm();
+        CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 );
+        CHECK( integrator.last_stats().ntasks_skipped == 0 );
+      }
+    }
+
+    // Check screened incremental builds over several small perturbations,
+    // a repeated call with the final density evaluates all tasks which have
+    // been skipped since their last evaluation (i.e. yields the full build)
+    if( ex == ExecutionSpace::Host ) {
+      matrix_type tP = P * P;
+      const double h = 1e-3 / tP.cwiseAbs().maxCoeff();
+
+      IntegratorSettingsKS ks_settings;
+      ks_settings.incremental_vxc = true;
+      ks_settings.incremental_tol = 0.1;
+      matrix_type P_k = P;
+      size_t ntasks_skipped = 0;
+      for( int k = 0; k < 4; ++k ) {
+        P_k += (k % 2 ? -0.5 : 1.0) * h * tP;
+        integrator.eval_exc_vxc( P_k, ks_settings );
+        ntasks_skipped += integrator.last_stats().ntasks_skipped;
+      }
+      CHECK( ntasks_skipped > 0 );
+
+      auto [ EXC_k, VXC_k ] = integrator.eval_exc_vxc( P_k );
+      CHECK( integrator.last_stats().ntasks_skipped == 0 );
+      auto [ EXC1, VXC1 ] = integrator.eval_exc_vxc( P_k, ks_settings );
+      CHECK( EXC1 == Approx( EXC_k ) );
+      auto VXC1_diff_nrm = ( VXC1 - VXC_k ).norm();
+      CHECK( VXC1_diff_nrm / basis.nbf() < 1e-10 );
+    }
+
   } else if (uks) {
     auto [ EXC, VXC, VXCz ] = integrator.eval_exc_vxc( P, Pz );
 
@@ -201,6 +453,29 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
       CHECK( VXCz1_diff_nrm / basis.nbf() < 1e-10 );
     }
 
+    // Incremental builds are RKS only
+    if( ex == ExecutionSpace::Host ) {
+      IntegratorSettingsKS ks_settings;
+      ks_settings.incremental_vxc = true;
+      CHECK_THROWS( integrator.eval_exc_vxc( P, Pz, ks_settings ) );
+    }
+
+    // Check the host EXC/VXC features (see host_ks_test_cases)
+    if( ex == ExecutionSpace::Host ) {
+      for( const auto& c : host_ks_test_cases() ) 
+      if( c.uks )
+      for( int icall = 0; icall < c.ncalls; ++icall ) {
+        INFO( c.name << " (call " << icall << ")" );
+        auto [ EXC1, VXC1, VXCz1 ] = integrator.eval_exc_vxc( P, Pz, c.settings );
+        CHECK( EXC1 == Approx( EXC_ref ) );
+        auto VXC1_diff_nrm = ( VXC1 - VXC_ref ).norm();
+        auto VXCz1_diff_nrm = ( VXCz1 - VXCz_ref ).norm();
+        CHECK( VXC1_diff_nrm / basis.nbf() < c.tol );
+        CHECK( VXCz1_diff_nrm / basis.nbf() < c.tol );
+        c.check( integrator.last_stats(), icall );
+      }
+    }
+
     // Check EXC-only path
     auto EXC2 = integrator.eval_exc( P, Pz );
     CHECK(EXC2 == Approx(EXC));
@@ -259,6 +534,24 @@ void test_xc_integrator( ExecutionSpace ex, const RuntimeEnvironment& rt,
     auto K = integrator.eval_exx( P );
     CHECK((K - K.transpose()).norm() < std::numeric_limits<double>::epsilon()); // Symmetric
     CHECK( (K - K_ref).norm() / basis.nbf() < 1e-7 );
+
+    // Check K accumulation strategies
+    if( ex == ExecutionSpace::Host ) {
+      for( auto acc : { HostAccumulation::Atomic, HostAccumulation::ThreadPrivate,
+                        HostAccumulation::TileLocks } ) {
+        IntegratorSettingsSNLinK sn_link_settings;
+        sn_link_settings.accumulation = acc;
+        auto K1 = integrator.eval_exx( P, sn_link_settings );
+        CHECK( (K1 - K_ref).norm() / basis.nbf() < 1e-7 );
+      }
+    }
+
+    // EXX reorders the tasks, check that EXC/VXC restores its task order
+    if( ex == ExecutionSpace::Host ) {
+      auto [ EXC1, VXC1 ] = integrator.eval_exc_vxc( P );
+      CHECK( EXC1 == Approx( EXC_ref ) );
+      CHECK( ( VXC1 - VXC_ref ).norm() / basis.nbf() < 1e-10 ); 
+    }
   }
 
 }
@@ -448,3 +741,59 @@ TEST_CASE( "XC Integrator", "[xc-integrator]" ) {
         func, PruningScheme::Unpruned );
   }
 }
+
+#ifdef GAUXC_HAS_HOST
+#include "host/host_collocation_cache.hpp"
+TEST_CASE( "Host Collocation Cache", "[xc-integrator]" ) {
+
+  auto make_task = []( int32_t iParent, std::array<double,3> pt0 ) {
+    XCTask task;
+    task.iParent = iParent;
+    task.points  = { pt0, {1., 2., 3.} };
+    task.weights = { 1., 1. };
+    task.npts    = 2;
+    task.bfn_screening.nbe = 3;
+    return task;
+  };
+
+  detail::HostCollocationCache<double> cache;
+  const size_t sz = 2 * 3;
+  std::vector<double> eval( sz ), load( sz );
+
+  SECTION( "Reordered Tasks" ) {
+    std::vector<XCTask> tasks = { make_task(0, {0.,0.,0.}), 
+                                  make_task(1, {0.,0.,0.}) };
+    cache.prepare( tasks.begin(), tasks.end(), 1, 0, 1ul << 20, false );
+    REQUIRE( cache.admitted(0) );
+    REQUIRE( cache.admitted(1) );
+    std::fill( eval.begin(), eval.end(), 1. ); cache.store( 0, eval.data() );
+    std::fill( eval.begin(), eval.end(), 2. ); cache.store( 1, eval.data() );
+
+    std::swap( tasks[0], tasks[1] );
+    cache.prepare( tasks.begin(), tasks.end(), 1, 0, 1ul << 20, false );
+    REQUIRE( cache.filled(0) );
+    cache.load( 0, load.data() );
+    CHECK( load[0] == 2. );
+  }
+
+  SECTION( "Duplicate Keys" ) {
+    std::vector<XCTask> tasks = { make_task(0, {0.,0.,0.}), 
+                                  make_task(0, {0.,0.,0.}) };
+    tasks[1].bfn_screening.shell_list = { 1 };
+    cache.prepare( tasks.begin(), tasks.end(), 1, 0, 1ul << 20, false );
+    CHECK( not cache.admitted(0) );
+    CHECK( not cache.admitted(1) );
+  }
+
+  SECTION( "FP32 Storage" ) {
+    std::vector<XCTask> tasks = { make_task(0, {0.,0.,0.}) };
+    cache.prepare( tasks.begin(), tasks.end(), 1, 0, 1ul << 20, true );
+    REQUIRE( cache.admitted(0) );
+    CHECK( cache.data(0) == nullptr );
+    std::iota( eval.begin(), eval.end(), 0.1 ); cache.store( 0, eval.data() );
+    cache.load( 0, load.data() );
+    for( size_t i = 0; i < sz; ++i ) CHECK( load[i] == Approx( eval[i] ) );
+  }
+
+}
+#endif